@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/edit_distance.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// \a count random names of 4 to 16 lower case letters
+auto MakeNames(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> size_dist{4, 16};
+  std::uniform_int_distribution<int> char_dist{'a', 'z'};
+
+  std::vector<std::string> names(count);
+  for (auto& name : names) {
+    name.resize(size_dist(gen));
+    for (auto& c : name) c = static_cast<char>(char_dist(gen));
+  }
+  return names;
+}
+
+/// The usual O(n * m) dynamic programming
+auto DpDistance(std::string_view lhs, std::string_view rhs) -> std::size_t {
+  std::vector<std::size_t> column(lhs.size() + 1);
+  for (std::size_t i = 0; i <= lhs.size(); ++i) column[i] = i;
+
+  for (std::size_t j = 1; j <= rhs.size(); ++j) {
+    std::size_t diagonal = column[0];
+    column[0] = j;
+    for (std::size_t i = 1; i <= lhs.size(); ++i) {
+      const std::size_t above = column[i];
+      column[i] = std::min({column[i] + 1, column[i - 1] + 1,
+                            diagonal + (lhs[i - 1] == rhs[j - 1] ? 0 : 1)});
+      diagonal = above;
+    }
+  }
+  return column.back();
+}
+
+constexpr std::string_view kTerm = "atmosphere";
+
+void BM_NearDynamicProgramming(benchmark::State& state) {
+  const auto names = MakeNames(10000);
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (const auto& name : names) matches += (DpDistance(kTerm, name) <= 2);
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(names.size()));
+}
+BENCHMARK(BM_NearDynamicProgramming);
+
+void BM_NearStrNearDistance(benchmark::State& state) {
+  const auto names = MakeNames(10000);
+  const auto near = atb::StrNear(kTerm, 2);
+  for (auto _ : state) {
+    std::size_t matches = 0;
+    for (const auto& name : names) matches += (near.Distance(name) <= 2);
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(names.size()));
+}
+BENCHMARK(BM_NearStrNearDistance);
+
+void BM_NearStrNearScoreAll(benchmark::State& state) {
+  const auto names = MakeNames(10000);
+  const auto near = atb::StrNear(kTerm, 2);
+  std::vector<std::optional<std::size_t>> scores(names.size());
+  for (auto _ : state) {
+    near.ScoreAll(names, scores.begin());
+    benchmark::DoNotOptimize(scores.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(names.size()));
+}
+BENCHMARK(BM_NearStrNearScoreAll);
+
+void BM_NearLongPattern(benchmark::State& state) {
+  // Multi blocks patterns (> 64 chars)
+  const auto names = MakeNames(1000);
+  std::string pattern;
+  for (const auto& name : names) {
+    if (pattern.size() >= static_cast<std::size_t>(state.range(0))) break;
+    pattern += name;
+  }
+  pattern.resize(static_cast<std::size_t>(state.range(0)));
+  std::reverse(pattern.begin(), pattern.end());  // No exact match
+  const auto near = atb::StrContainsNear(pattern, 8);
+
+  std::string text;
+  for (const auto& name : names) text += name;
+
+  for (auto _ : state) benchmark::DoNotOptimize(near.Distance(text));
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_NearLongPattern)->Arg(32)->Arg(128)->Arg(512);
+
+}  // namespace
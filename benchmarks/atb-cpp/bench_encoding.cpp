@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "atb-cpp/encoding.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+auto MakeBytes(std::size_t size) -> std::string {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> byte(0x00, 0xFF);
+  std::string bytes(size, '\0');
+  for (auto& c : bytes) c = static_cast<char>(byte(gen));
+  return bytes;
+}
+
+template <class Encode>
+void EncodeBench(benchmark::State& state, Encode encode,
+                 std::size_t (*encoded_size)(std::size_t)) {
+  const auto data = MakeBytes(static_cast<std::size_t>(state.range(0)));
+  std::string output(encoded_size(data.size()), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(encode(data, output.data(), output.size()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(data.size()));
+}
+
+template <class Encode, class Decode>
+void DecodeBench(benchmark::State& state, Encode encode, Decode decode,
+                 std::size_t (*encoded_size)(std::size_t)) {
+  const auto data = MakeBytes(static_cast<std::size_t>(state.range(0)));
+  std::string encoded(encoded_size(data.size()), '\0');
+  encode(data, encoded.data(), encoded.size());
+
+  std::string output(data.size(), '\0');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        decode(encoded, output.data(), output.size(), nullptr));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(encoded.size()));
+}
+
+auto HexSize(std::size_t size) -> std::size_t {
+  return atb::HexEncodedSize(size);
+}
+
+auto Base64Size(std::size_t size) -> std::size_t {
+  return atb::Base64EncodedSize(size);
+}
+
+void BM_HexEncodeScalar(benchmark::State& state) {
+  EncodeBench(state, atb::StrHexEncodeScalar, HexSize);
+}
+BENCHMARK(BM_HexEncodeScalar)->Range(64, 1 << 20);
+
+void BM_HexEncode(benchmark::State& state) {
+  EncodeBench(state, atb::StrHexEncode, HexSize);
+}
+BENCHMARK(BM_HexEncode)->Range(64, 1 << 20);
+
+void BM_HexDecodeScalar(benchmark::State& state) {
+  DecodeBench(state, atb::StrHexEncode, atb::StrHexDecodeScalar, HexSize);
+}
+BENCHMARK(BM_HexDecodeScalar)->Range(64, 1 << 20);
+
+void BM_HexDecode(benchmark::State& state) {
+  DecodeBench(state, atb::StrHexEncode, atb::StrHexDecode, HexSize);
+}
+BENCHMARK(BM_HexDecode)->Range(64, 1 << 20);
+
+void BM_Base64EncodeScalar(benchmark::State& state) {
+  EncodeBench(state, atb::StrBase64EncodeScalar, Base64Size);
+}
+BENCHMARK(BM_Base64EncodeScalar)->Range(64, 1 << 20);
+
+void BM_Base64Encode(benchmark::State& state) {
+  EncodeBench(state, atb::StrBase64Encode, Base64Size);
+}
+BENCHMARK(BM_Base64Encode)->Range(64, 1 << 20);
+
+void BM_Base64DecodeScalar(benchmark::State& state) {
+  DecodeBench(state, atb::StrBase64Encode, atb::StrBase64DecodeScalar,
+              Base64Size);
+}
+BENCHMARK(BM_Base64DecodeScalar)->Range(64, 1 << 20);
+
+void BM_Base64Decode(benchmark::State& state) {
+  DecodeBench(state, atb::StrBase64Encode, atb::StrBase64Decode, Base64Size);
+}
+BENCHMARK(BM_Base64Decode)->Range(64, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/encoding.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Log message like text, with a few chars to escape
+auto MakeMessage(std::size_t size) -> std::string {
+  constexpr std::string_view kWords[] = {
+      "request ", "handled ", "in ", "42us ", "path=\"/api/v1\" ",
+      "user ",    "agent ",   "\t",  "ok\n",
+  };
+
+  std::string text;
+  for (std::size_t i = 0; text.size() < size; ++i) text += kWords[i % 9];
+  return text;
+}
+
+/// The per char loop StrAppendEscapedJson replaces
+void AppendEscapedJsonLoop(std::string_view str, std::string& d_str) {
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        d_str += "\\\"";
+        break;
+      case '\\':
+        d_str += "\\\\";
+        break;
+      case '\n':
+        d_str += "\\n";
+        break;
+      case '\t':
+        d_str += "\\t";
+        break;
+      default:
+        d_str += c;
+        break;
+    }
+  }
+}
+
+void BM_EscapeJsonLoop(benchmark::State& state) {
+  const auto text = MakeMessage(static_cast<std::size_t>(state.range(0)));
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    AppendEscapedJsonLoop(text, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_EscapeJsonLoop)->Range(64, 1 << 16);
+
+void BM_StrAppendEscapedJson(benchmark::State& state) {
+  const auto text = MakeMessage(static_cast<std::size_t>(state.range(0)));
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    atb::StrAppendEscapedJson(text, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_StrAppendEscapedJson)->Range(64, 1 << 16);
+
+void BM_StrAppendEscapedCsv(benchmark::State& state) {
+  const auto text = MakeMessage(static_cast<std::size_t>(state.range(0)));
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    atb::StrAppendEscapedCsv(text, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_StrAppendEscapedCsv)->Range(64, 1 << 16);
+
+}  // namespace
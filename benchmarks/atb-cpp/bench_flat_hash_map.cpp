@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "atb-cpp/flat_hash_map.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// \a count keys looking like "metric.<i>.count"
+auto MakeKeys(std::size_t count) -> std::vector<std::string> {
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("metric." + std::to_string(i) + ".count");
+  }
+  return keys;
+}
+
+/// Lookups views (outside of the maps), 1 in 4 missing
+auto MakeLookups(std::size_t count) -> std::vector<std::string> {
+  auto lookups = MakeKeys(count + (count / 3));
+  for (std::size_t i = 0; i < lookups.size(); i += 2) {
+    std::swap(lookups[i], lookups[lookups.size() - 1 - i]);
+  }
+  return lookups;
+}
+
+void BM_StdUnorderedMapFind(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  std::unordered_map<std::string, int> map;
+  for (const auto& key : MakeKeys(count)) map.emplace(key, 1);
+  const auto lookups = MakeLookups(count);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string_view key = lookups[i++ % lookups.size()];
+    // No heterogeneous lookups before C++20: a std::string is needed
+    const auto found = map.find(std::string{key});
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdUnorderedMapFind)->RangeMultiplier(16)->Range(16, 65536);
+
+void BM_FlatHashMapFind(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  atb::FlatHashMap<std::string, int> map;
+  for (const auto& key : MakeKeys(count)) map.TryEmplace(key, 1);
+  const auto lookups = MakeLookups(count);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string_view key = lookups[i++ % lookups.size()];
+    const auto found = map.Find(key);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FlatHashMapFind)->RangeMultiplier(16)->Range(16, 65536);
+
+void BM_StdUnorderedMapInsert(benchmark::State& state) {
+  const auto keys = MakeKeys(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::unordered_map<std::string, int> map;
+    for (const auto& key : keys) map.emplace(key, 1);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(keys.size()));
+}
+BENCHMARK(BM_StdUnorderedMapInsert)->RangeMultiplier(16)->Range(16, 65536);
+
+void BM_FlatHashMapInsert(benchmark::State& state) {
+  const auto keys = MakeKeys(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    atb::FlatHashMap<std::string, int> map;
+    for (const auto& key : keys) map.TryEmplace(key, 1);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(keys.size()));
+}
+BENCHMARK(BM_FlatHashMapInsert)->RangeMultiplier(16)->Range(16, 65536);
+
+}  // namespace
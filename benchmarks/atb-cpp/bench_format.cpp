@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/format.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr std::string_view kPath = "/api/v1/items";
+
+void BM_FormatSnprintf(benchmark::State& state) {
+  std::uint64_t id = 123456;
+  for (auto _ : state) {
+    char buffer[128];
+    const int size =
+        std::snprintf(buffer, sizeof(buffer), "req=%llu path=%.*s took=%dus",
+                      static_cast<unsigned long long>(id++),
+                      static_cast<int>(kPath.size()), kPath.data(), 1234);
+    std::string line(buffer, static_cast<std::size_t>(size));
+    benchmark::DoNotOptimize(line);
+  }
+}
+BENCHMARK(BM_FormatSnprintf);
+
+void BM_FormatOstringstream(benchmark::State& state) {
+  std::uint64_t id = 123456;
+  for (auto _ : state) {
+    std::ostringstream stream;
+    stream << "req=" << id++ << " path=" << kPath << " took=" << 1234 << "us";
+    std::string line = stream.str();
+    benchmark::DoNotOptimize(line);
+  }
+}
+BENCHMARK(BM_FormatOstringstream);
+
+void BM_FormatAtb(benchmark::State& state) {
+  std::uint64_t id = 123456;
+  for (auto _ : state) {
+    std::string line =
+        atb::Format(ATB_FMT("req={} path={} took={}us"), id++, kPath, 1234);
+    benchmark::DoNotOptimize(line);
+  }
+}
+BENCHMARK(BM_FormatAtb);
+
+void BM_FormatAtbAppend(benchmark::State& state) {
+  // Reused buffer: no allocations at all
+  std::uint64_t id = 123456;
+  std::string line;
+  for (auto _ : state) {
+    line.clear();
+    atb::FormatAppend(ATB_FMT("req={} path={} took={}us"), line, id++, kPath,
+                      1234);
+    benchmark::DoNotOptimize(line);
+  }
+}
+BENCHMARK(BM_FormatAtbAppend);
+
+}  // namespace
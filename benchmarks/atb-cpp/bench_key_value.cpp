@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/key_value.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr std::string_view kHeaders =
+    "GET /api/v1/items?id=42 HTTP/1.1\r\n"
+    "Host: api.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/115\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Cookie: session=8f2b1c9e4d; theme=dark; tracking=off\r\n"
+    "Connection: keep-alive\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 1024\r\n"
+    "\r\n";
+
+/// The usual approach: build a map of std::string, then lookup
+auto ParseToMap(std::string_view text) -> std::map<std::string, std::string> {
+  std::map<std::string, std::string> headers;
+  std::size_t pos = 0;
+  while (pos < text.size()) {
+    auto end = text.find('\n', pos);
+    if (end == std::string_view::npos) end = text.size();
+    auto line = text.substr(pos, end - pos);
+    pos = end + 1;
+
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    const auto colon = line.find(':');
+    if (colon == std::string_view::npos) continue;
+
+    auto value = line.substr(colon + 1);
+    while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+
+    std::string key{line.substr(0, colon)};
+    for (auto& c : key) {
+      if ((c >= 'A') && (c <= 'Z')) c = static_cast<char>(c - 'A' + 'a');
+    }
+    headers.emplace(std::move(key), std::string{value});
+  }
+  return headers;
+}
+
+void BM_HeadersStdMap(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto headers = ParseToMap(kHeaders);
+    auto host = headers.find("host");
+    auto length = headers.find("content-length");
+    benchmark::DoNotOptimize(host);
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kHeaders.size()));
+}
+BENCHMARK(BM_HeadersStdMap);
+
+void BM_HeadersStrKeyValuesIterate(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto& kv : atb::StrKeyValues{kHeaders, atb::kStrHeadersFormat}) {
+      benchmark::DoNotOptimize(kv);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kHeaders.size()));
+}
+BENCHMARK(BM_HeadersStrKeyValuesIterate);
+
+void BM_HeadersStrKeyValuesExtract(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto found = atb::StrKeyValues{kHeaders, atb::kStrHeadersFormat}
+                           .Extract({"host", "content-length"});
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kHeaders.size()));
+}
+BENCHMARK(BM_HeadersStrKeyValuesExtract);
+
+}  // namespace
@@ -0,0 +1,114 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/line_scanner.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Log like text of \a size bytes, with 1% of lines containing "ERROR"
+auto MakeLog(std::size_t size) -> std::string {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<std::size_t> padding(0, 60);
+
+  std::string log;
+  while (log.size() < size) {
+    log += "2024-01-01T00:00:00 host app[1234]: ";
+    log += (percent(gen) == 0) ? "ERROR " : "INFO ";
+    log.append(padding(gen), 'x');
+    log += '\n';
+  }
+  return log;
+}
+
+constexpr std::int64_t kLogSize = 64 << 20;
+
+void BM_LinesGetlineBaseline(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  const auto matcher = atb::StrContains("ERROR");
+  for (auto _ : state) {
+    std::istringstream stream(log);
+    std::size_t count = 0;
+    for (std::string line; std::getline(stream, line);) {
+      if (::IsMatching(matcher, line)) ++count;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_LinesGetlineBaseline)->Unit(benchmark::kMillisecond);
+
+void BM_StrForEachLineScalar(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  const auto matcher = atb::StrContains("ERROR");
+  for (auto _ : state) {
+    std::size_t count = 0;
+    atb::StrForEachLineScalar(log, [&](std::string_view line) {
+      if (::IsMatching(matcher, line)) ++count;
+    });
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_StrForEachLineScalar)->Unit(benchmark::kMillisecond);
+
+void BM_StrForEachLineCountScalar(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    atb::StrForEachLineScalar(log, [&](std::string_view) { ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_StrForEachLineCountScalar)->Unit(benchmark::kMillisecond);
+
+void BM_StrForEachLineCount(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    atb::StrForEachLine(log, [&](std::string_view) { ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_StrForEachLineCount)->Unit(benchmark::kMillisecond);
+
+void BM_StrForEachMatchingLine(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  const auto matcher = atb::StrContains("ERROR");
+  for (auto _ : state) {
+    std::size_t count = 0;
+    atb::StrForEachMatchingLine(log, matcher,
+                                [&](std::string_view) { ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_StrForEachMatchingLine)->Unit(benchmark::kMillisecond);
+
+void BM_StrForEachMatchingLineParallel(benchmark::State& state) {
+  const auto log = MakeLog(kLogSize);
+  const auto matcher = atb::StrContains("ERROR");
+  for (auto _ : state) {
+    std::size_t count = 0;
+    atb::StrForEachMatchingLineParallel(
+        log, matcher, [&](std::string_view) { ++count; },
+        static_cast<std::size_t>(state.range(0)));
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * kLogSize);
+}
+BENCHMARK(BM_StrForEachMatchingLineParallel)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
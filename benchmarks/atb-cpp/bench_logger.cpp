@@ -0,0 +1,49 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/format.hpp"
+#include "atb-cpp/logger.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::string_view kPath = "/api/v1/items";
+
+/// @return A file descriptor on /dev/null, shared by all benchmarks
+auto DevNull() -> int {
+  static const int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+  return fd;
+}
+
+void BM_LoggerSyncStrCat(benchmark::State& state) {
+  // What the producers pay when writing synchronously
+  std::uint64_t id = 123456;
+  for (auto _ : state) {
+    const auto line = atb::StrCat({"req=", std::to_string(id++), " path=",
+                                   kPath, " took=", "1234", "us\n"});
+    benchmark::DoNotOptimize(::write(DevNull(), line->data(), line->size()));
+  }
+}
+BENCHMARK(BM_LoggerSyncStrCat)->Threads(1)->Threads(4);
+
+void BM_LoggerAsync(benchmark::State& state) {
+  static atb::AsyncLogger logger{DevNull(), [] {
+                                   atb::LogOptions options;
+                                   options.overflow = atb::LogOverflow::kBlock;
+                                   return options;
+                                 }()};
+
+  std::uint64_t id = 123456;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        logger.Log(ATB_FMT("req={} path={} took={}us"), id++, kPath, 1234));
+  }
+}
+BENCHMARK(BM_LoggerAsync)->Threads(1)->Threads(4);
+
+}  // namespace
@@ -0,0 +1,80 @@
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "atb-cpp/number.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Column of random integers of \a digits digits
+auto MakeColumn(std::size_t digits) -> std::vector<std::string> {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int> digit('0', '9');
+
+  std::vector<std::string> column(1024);
+  for (auto& token : column) {
+    token.resize(digits);
+    for (auto& c : token) c = static_cast<char>(digit(gen));
+  }
+  return column;
+}
+
+void BM_StrToNumberBaseline(benchmark::State& state) {
+  const auto column = MakeColumn(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& token : column) {
+      std::uint64_t value = 0;
+      std::from_chars(token.data(), token.data() + token.size(), value);
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(column.size()));
+}
+BENCHMARK(BM_StrToNumberBaseline)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+
+void BM_StrToNumberStoull(benchmark::State& state) {
+  const auto column = MakeColumn(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& token : column) sum += std::stoull(token);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(column.size()));
+}
+BENCHMARK(BM_StrToNumberStoull)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+
+void BM_StrToNumber(benchmark::State& state) {
+  const auto column = MakeColumn(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& token : column) {
+      sum += *atb::StrToNumber<std::uint64_t>(token);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(column.size()));
+}
+BENCHMARK(BM_StrToNumber)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+
+void BM_StrToNumbers(benchmark::State& state) {
+  const auto column = MakeColumn(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::uint64_t> values(column.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::StrToNumbers(column, values.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(column.size()));
+}
+BENCHMARK(BM_StrToNumbers)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+
+}  // namespace
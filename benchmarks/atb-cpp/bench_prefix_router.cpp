@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/prefix_router.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// \a count routes looking like "/service<i>/v<j>", sharing common prefixes
+auto MakeRoutes(std::size_t count) -> std::vector<std::string> {
+  std::vector<std::string> routes;
+  for (std::size_t i = 0; routes.size() < count; ++i) {
+    const auto service = "/service" + std::to_string(i);
+    routes.push_back(service);
+    for (std::size_t v = 1; (v <= 3) && (routes.size() < count); ++v) {
+      routes.push_back(service + "/v" + std::to_string(v));
+    }
+  }
+  return routes;
+}
+
+/// Inputs to route, hitting all routes (and some misses)
+auto MakeInputs(const std::vector<std::string>& routes)
+    -> std::vector<std::string> {
+  std::vector<std::string> inputs;
+  for (const auto& route : routes) inputs.push_back(route + "/items/42");
+  inputs.push_back("/unknown/path");
+  return inputs;
+}
+
+void BM_StrStartsWithChain(benchmark::State& state) {
+  const auto routes = MakeRoutes(static_cast<std::size_t>(state.range(0)));
+  const auto inputs = MakeInputs(routes);
+
+  using Matcher = decltype(atb::StrStartsWith(std::string_view{}));
+  std::vector<Matcher> chain;
+  for (const auto& route : routes) chain.push_back(atb::StrStartsWith(route));
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string_view str = inputs[i++ % inputs.size()];
+
+    // Longest prefix wins: all matchers must be evaluated
+    std::size_t best = routes.size();
+    std::size_t best_size = 0;
+    for (std::size_t r = 0; r < chain.size(); ++r) {
+      if ((routes[r].size() >= best_size) && ::IsMatching(chain[r], str)) {
+        best = r;
+        best_size = routes[r].size();
+      }
+    }
+    benchmark::DoNotOptimize(best);
+  }
+}
+BENCHMARK(BM_StrStartsWithChain)->RangeMultiplier(4)->Range(4, 256);
+
+void BM_StrPrefixRouter(benchmark::State& state) {
+  const auto routes = MakeRoutes(static_cast<std::size_t>(state.range(0)));
+  const auto inputs = MakeInputs(routes);
+
+  atb::StrPrefixRouter<std::size_t> router;
+  for (std::size_t r = 0; r < routes.size(); ++r) router.Insert(routes[r], r);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const std::string_view str = inputs[i++ % inputs.size()];
+    benchmark::DoNotOptimize(router.LongestMatch(str));
+  }
+}
+BENCHMARK(BM_StrPrefixRouter)->RangeMultiplier(4)->Range(4, 256);
+
+}  // namespace
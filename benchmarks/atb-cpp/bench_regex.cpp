@@ -0,0 +1,92 @@
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/regex.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr const char* kVersion = R"(v\d+(\.\d+){0,2}(-rc\d+)?)";
+constexpr const char* kError = "(error|fail(ed|ure)): [a-z]+";
+
+/// Version like strings, half of them matching kVersion
+auto MakeVersions() -> std::vector<std::string> {
+  std::vector<std::string> versions;
+  for (int i = 0; i < 64; ++i) {
+    std::string version = "v" + std::to_string(i) + "." + std::to_string(i * 7);
+    if ((i % 2) == 0) version += "-rc" + std::to_string(i % 5);
+    if ((i % 4) == 1) version += ".0.0";
+    versions.push_back(std::move(version));
+  }
+  return versions;
+}
+
+/// Log lines, with a few errors
+auto MakeLines() -> std::vector<std::string> {
+  std::vector<std::string> lines;
+  for (int i = 0; i < 64; ++i) {
+    std::string line = "2024-01-01T00:00:" + std::to_string(i) +
+                       " worker=" + std::to_string(i % 8) +
+                       " request handled in " + std::to_string(i * 13) + "us";
+    if ((i % 16) == 0) line += " failure: timeout";
+    lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+void BM_StdRegexMatch(benchmark::State& state) {
+  const auto versions = MakeVersions();
+  const std::regex regex(kVersion, std::regex::optimize);
+  for (auto _ : state) {
+    for (const auto& version : versions) {
+      benchmark::DoNotOptimize(std::regex_match(version, regex));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(versions.size()));
+}
+BENCHMARK(BM_StdRegexMatch);
+
+void BM_RegexMatch(benchmark::State& state) {
+  const auto versions = MakeVersions();
+  const auto regex = atb::StrRegex(kVersion);
+  for (auto _ : state) {
+    for (const auto& version : versions) {
+      benchmark::DoNotOptimize(regex.IsMatching(version));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(versions.size()));
+}
+BENCHMARK(BM_RegexMatch);
+
+void BM_StdRegexSearch(benchmark::State& state) {
+  const auto lines = MakeLines();
+  const std::regex regex(kError, std::regex::optimize);
+  for (auto _ : state) {
+    for (const auto& line : lines) {
+      benchmark::DoNotOptimize(std::regex_search(line, regex));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(lines.size()));
+}
+BENCHMARK(BM_StdRegexSearch);
+
+void BM_RegexSearch(benchmark::State& state) {
+  const auto lines = MakeLines();
+  const auto regex = atb::StrContainsRegex(kError);
+  for (auto _ : state) {
+    for (const auto& line : lines) {
+      benchmark::DoNotOptimize(regex.IsMatching(line));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(lines.size()));
+}
+BENCHMARK(BM_RegexSearch);
+
+}  // namespace
@@ -0,0 +1,47 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/rope.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr std::string_view kName = "some.metric.name";
+constexpr std::string_view kValue = "123456.789";
+
+/// Number of rows needed to build a report of \a size bytes
+auto RowsFor(benchmark::State& state) -> std::size_t {
+  return static_cast<std::size_t>(state.range(0)) /
+         (kName.size() + kValue.size() + 2);
+}
+
+void BM_StrAppendReport(benchmark::State& state) {
+  const auto rows = RowsFor(state);
+  for (auto _ : state) {
+    std::string report;
+    for (std::size_t i = 0; i < rows; ++i) {
+      atb::StrAppend({kName, ";", kValue, "\n"}, report);
+    }
+    benchmark::DoNotOptimize(report.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrAppendReport)->RangeMultiplier(8)->Range(1 << 16, 1 << 25);
+
+void BM_StrRopeReport(benchmark::State& state) {
+  const auto rows = RowsFor(state);
+  atb::StrBlockPool pool;
+  for (auto _ : state) {
+    atb::StrRope report(pool);
+    for (std::size_t i = 0; i < rows; ++i) {
+      report.Append({kName, ";", kValue, "\n"});
+    }
+    benchmark::DoNotOptimize(report.Chunk(0).data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrRopeReport)->RangeMultiplier(8)->Range(1 << 16, 1 << 25);
+
+}  // namespace
@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/str_column.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr std::size_t kRows = 1'000'000;
+
+/// Columns of an export: id, name, count
+struct Table {
+  std::vector<std::uint64_t> ids;
+  std::vector<std::string> names;
+  std::vector<int> counts;
+};
+
+auto MakeTable() -> const Table& {
+  static const Table table = [] {
+    Table t;
+    for (std::size_t i = 0; i < kRows; ++i) {
+      t.ids.push_back(1'000'000'000 + (i * 7919));
+      t.names.push_back("item_" + std::to_string(i % 1000));
+      t.counts.push_back(static_cast<int>(i % 10'000) - 5000);
+    }
+    return t;
+  }();
+  return table;
+}
+
+void BM_StrColumnStrCatPerRow(benchmark::State& state) {
+  const Table& table = MakeTable();
+  for (auto _ : state) {
+    std::vector<std::string> rows;
+    rows.reserve(kRows);
+    for (std::size_t i = 0; i < kRows; ++i) {
+      rows.push_back(*atb::StrCat({std::to_string(table.ids[i]), ",",
+                                   table.names[i], ",",
+                                   std::to_string(table.counts[i]), "\n"}));
+    }
+    benchmark::DoNotOptimize(rows.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kRows));
+}
+BENCHMARK(BM_StrColumnStrCatPerRow)->Unit(benchmark::kMillisecond);
+
+void BM_StrColumnStrCatColumns(benchmark::State& state) {
+  const Table& table = MakeTable();
+  const auto threads = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    const atb::StrColumn column = atb::StrCatColumnsParallel(
+        threads, table.ids, ',', table.names, ',', table.counts, '\n');
+    benchmark::DoNotOptimize(column.data.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(kRows));
+}
+BENCHMARK(BM_StrColumnStrCatColumns)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,89 @@
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/str_expr.hpp"
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// The same URL built across 3 levels of helpers
+
+namespace eager {
+
+auto Endpoint(std::string_view host, int port) -> std::string {
+  return std::string{host} + ':' + std::to_string(port);
+}
+
+auto Origin(std::string_view host, int port) -> std::string {
+  return "https://" + Endpoint(host, port);
+}
+
+auto Url(std::string_view host, int port, std::string_view path)
+    -> std::string {
+  return Origin(host, port) + std::string{path} + "?lang=en";
+}
+
+}  // namespace eager
+
+namespace strcat {
+
+auto Endpoint(std::string_view host, int port) -> std::string {
+  return *atb::StrCat({host, ":", std::to_string(port)});
+}
+
+auto Origin(std::string_view host, int port) -> std::string {
+  return *atb::StrCat({"https://", Endpoint(host, port)});
+}
+
+auto Url(std::string_view host, int port, std::string_view path)
+    -> std::string {
+  return *atb::StrCat({Origin(host, port), path, "?lang=en"});
+}
+
+}  // namespace strcat
+
+namespace lazy {
+
+auto Endpoint(std::string_view host, int port) {
+  return atb::StrLazyCat(host, ':', port);
+}
+
+auto Origin(std::string_view host, int port) {
+  return "https://" + Endpoint(host, port);
+}
+
+auto Url(std::string_view host, int port, std::string_view path) {
+  return Origin(host, port) + path + "?lang=en";
+}
+
+}  // namespace lazy
+
+constexpr std::string_view kHost = "api.example.com";
+constexpr std::string_view kPath = "/v1/items/42/details";
+
+void BM_StrExprEagerStrings(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string url = eager::Url(kHost, 8443, kPath);
+    benchmark::DoNotOptimize(url);
+  }
+}
+BENCHMARK(BM_StrExprEagerStrings);
+
+void BM_StrExprStrCat(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string url = strcat::Url(kHost, 8443, kPath);
+    benchmark::DoNotOptimize(url);
+  }
+}
+BENCHMARK(BM_StrExprStrCat);
+
+void BM_StrExprLazy(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string url = lazy::Url(kHost, 8443, kPath);
+    benchmark::DoNotOptimize(url);
+  }
+}
+BENCHMARK(BM_StrExprLazy);
+
+}  // namespace
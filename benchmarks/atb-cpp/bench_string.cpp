@@ -0,0 +1,191 @@
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/string.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Haystack of \a size bytes, containing \a pattern only at its very end
+auto MakeHaystack(std::size_t size, std::string_view pattern) -> std::string {
+  std::string str;
+  str.reserve(size);
+  const std::string_view filler = "the quick brown fox jumps over a lazy dog ";
+  while (str.size() + pattern.size() < size) {
+    str.append(filler.substr(0, size - pattern.size() - str.size()));
+  }
+  str.append(pattern);
+  return str;
+}
+
+/// Pattern of \a size bytes, made of the filler's bytes
+auto MakePattern(std::size_t size) -> std::string {
+  std::string pattern = "quick brown fox jumps over a lazy dog";
+  pattern.resize(size, '!');
+  pattern.back() = '!';
+  return pattern;
+}
+
+/// StrContains as it used to be implemented (std::string_view::find)
+auto StrContainsBaseline(std::string_view pattern) {
+  return [=](std::string_view str) noexcept -> bool {
+    return str.find(pattern) != std::string_view::npos;
+  };
+}
+
+/// StrContainsR as it used to be implemented (std::string_view::rfind)
+auto StrContainsRBaseline(std::string_view pattern) {
+  return [=](std::string_view str) noexcept -> bool {
+    return str.rfind(pattern) != std::string_view::npos;
+  };
+}
+
+template <class MatcherFactory>
+void BM_Contains(benchmark::State& state, MatcherFactory&& factory,
+                 bool reversed) {
+  const auto pattern = MakePattern(static_cast<std::size_t>(state.range(0)));
+  auto str = MakeHaystack(static_cast<std::size_t>(state.range(1)), pattern);
+  if (reversed) str = pattern + str.substr(0, str.size() - pattern.size());
+
+  const auto matcher = factory(pattern);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(::IsMatching(matcher, std::string_view{str}));
+  }
+
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(str.size()));
+}
+
+void PatternAndHaystackSizes(benchmark::internal::Benchmark* b) {
+  for (auto pattern : {1, 4, 16, 64}) {
+    for (auto haystack : {64, 4096}) b->Args({pattern, haystack});
+  }
+}
+
+void BM_StrContainsBaseline(benchmark::State& state) {
+  BM_Contains(state, StrContainsBaseline, false);
+}
+BENCHMARK(BM_StrContainsBaseline)->Apply(PatternAndHaystackSizes);
+
+void BM_StrContains(benchmark::State& state) {
+  BM_Contains(
+      state, [](std::string_view p) { return atb::StrContains(p); }, false);
+}
+BENCHMARK(BM_StrContains)->Apply(PatternAndHaystackSizes);
+
+void BM_StrContainsRBaseline(benchmark::State& state) {
+  BM_Contains(state, StrContainsRBaseline, true);
+}
+BENCHMARK(BM_StrContainsRBaseline)->Apply(PatternAndHaystackSizes);
+
+void BM_StrContainsR(benchmark::State& state) {
+  BM_Contains(
+      state, [](std::string_view p) { return atb::StrContainsR(p); }, true);
+}
+BENCHMARK(BM_StrContainsR)->Apply(PatternAndHaystackSizes);
+
+/// Case insensitive StrContains as it used to be done (lower case copy)
+auto StrIContainsBaseline(std::string_view pattern) {
+  return [=](std::string_view str) -> bool {
+    std::string lower{str};
+    for (auto& c : lower) c = atb::AsciiToLower(c);
+    return ::IsMatching(atb::StrContains(pattern), lower);
+  };
+}
+
+void BM_StrIContainsBaseline(benchmark::State& state) {
+  BM_Contains(state, StrIContainsBaseline, false);
+}
+BENCHMARK(BM_StrIContainsBaseline)->Apply(PatternAndHaystackSizes);
+
+void BM_StrIContains(benchmark::State& state) {
+  BM_Contains(
+      state, [](std::string_view p) { return atb::StrIContains(p); }, false);
+}
+BENCHMARK(BM_StrIContains)->Apply(PatternAndHaystackSizes);
+
+/// Replace all as it used to be hand written (repeated std::string::replace)
+auto StrReplaceAllBaseline(std::string str, std::string_view from,
+                           std::string_view to) -> std::string {
+  for (auto pos = str.find(from); pos != std::string::npos;
+       pos = str.find(from, pos + to.size())) {
+    str.replace(pos, from.size(), to);
+  }
+  return str;
+}
+
+/// Haystack of \a size bytes where 1 word out of 8 has to be replaced
+auto MakeReplaceHaystack(std::size_t size) -> std::string {
+  std::string str;
+  while (str.size() < size) str.append("foo bar baz qux quux corge <&> ");
+  str.resize(size);
+  return str;
+}
+
+void BM_StrReplaceAllBaseline(benchmark::State& state) {
+  const auto str = MakeReplaceHaystack(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(StrReplaceAllBaseline(str, "&", "&amp;"));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrReplaceAllBaseline)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_StrReplaceAll(benchmark::State& state) {
+  const auto str = MakeReplaceHaystack(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::StrReplaceAll(str, {{"&", "&amp;"}}));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrReplaceAll)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_StrReplaceAllMany(benchmark::State& state) {
+  const auto str = MakeReplaceHaystack(static_cast<std::size_t>(state.range(0)));
+  const atb::StrReplacer escape({{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}});
+  for (auto _ : state) benchmark::DoNotOptimize(escape.Replace(str));
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrReplaceAllMany)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+/// URL like paths, none matching the glob below
+auto MakePaths() -> std::vector<std::string> {
+  std::vector<std::string> paths;
+  for (int i = 0; i < 64; ++i) {
+    paths.push_back("api/users/" + std::to_string(i) + "/v" +
+                    std::to_string(i % 12) + "/item" + std::to_string(i));
+  }
+  return paths;
+}
+
+void BM_GlobRegex(benchmark::State& state) {
+  const auto paths = MakePaths();
+  const std::regex glob("api/.*/v./items", std::regex::optimize);
+  for (auto _ : state) {
+    for (const auto& path : paths) {
+      benchmark::DoNotOptimize(std::regex_match(path, glob));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(paths.size()));
+}
+BENCHMARK(BM_GlobRegex);
+
+void BM_StrGlob(benchmark::State& state) {
+  const auto paths = MakePaths();
+  const auto glob = atb::StrGlob("api/*/v?/items");
+  for (auto _ : state) {
+    for (const auto& path : paths) {
+      benchmark::DoNotOptimize(::IsMatching(glob, path));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(paths.size()));
+}
+BENCHMARK(BM_StrGlob);
+
+}  // namespace
@@ -0,0 +1,62 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "atb-cpp/utf8.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Mostly ASCII text, with some 2/3/4 bytes sequences
+auto MakeText(std::size_t size) -> std::string {
+  constexpr const char* kWords[] = {
+      "hello ", "Gr\xC3\xBC\xC3\x9F ", "\xE2\x82\xAC ", "\xF0\x9F\x98\x80 ",
+      "world ", "na\xC3\xAFve ",     "caf\xC3\xA9 ",
+  };
+
+  std::string text;
+  for (std::size_t i = 0; text.size() < size; ++i) text += kWords[i % 7];
+  return text;
+}
+
+void BM_Utf8IsValidScalar(benchmark::State& state) {
+  const auto text = MakeText(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::Utf8IsValidScalar(text));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8IsValidScalar)->Range(64, 1 << 20);
+
+void BM_Utf8IsValid(benchmark::State& state) {
+  const auto text = MakeText(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::Utf8IsValid(text));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8IsValid)->Range(64, 1 << 20);
+
+void BM_Utf8CountScalar(benchmark::State& state) {
+  const auto text = MakeText(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::Utf8CountScalar(text));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8CountScalar)->Range(64, 1 << 20);
+
+void BM_Utf8Count(benchmark::State& state) {
+  const auto text = MakeText(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atb::Utf8Count(text));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_Utf8Count)->Range(64, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace atb {
+
+/**
+ * @brief Multi-patterns substring searcher, based on a Aho-Corasick automaton
+ *
+ * All the patterns are compiled, once, into a single DFA that can be used to
+ * look for ANY of them by scanning the input string only once (instead of
+ * once per pattern).
+ *
+ * The automaton is stored as a dense transition table (one row per state) in
+ * a contiguous buffer. In order to keep it small (and cache friendly), the
+ * input bytes are first mapped into 'byte classes': each byte used by at least
+ * one pattern has its own class, all the other bytes share the class 0. A row
+ * is therefore only as wide as the number of distinct bytes used by the
+ * patterns (+1).
+ *
+ * @code{.cpp}
+ * const AhoCorasick ac({"he", "she", "his", "hers"});
+ *
+ * assert(ac.Contains("ushers"));
+ *
+ * auto match = ac.Find("ushers");
+ * assert(match->pattern == 1);   // "she"
+ * assert(match->position == 1);
+ * assert(match->size == 3);
+ * @endcode
+ *
+ * @note The patterns are copied into the automaton (they don't need to outlive
+ *       it).
+ */
+class AhoCorasick final {
+ public:
+  /// Index of a state inside the automaton
+  using State = std::uint32_t;
+
+  /// Value used for 'no pattern'
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /// Description of a pattern found inside a string
+  struct Match {
+    std::size_t pattern;   /*!< Index of the pattern matched */
+    std::size_t position;  /*!< Location of the pattern within the string */
+    std::size_t size;      /*!< Size of the pattern matched */
+
+    constexpr auto operator==(const Match& other) const noexcept -> bool {
+      return (pattern == other.pattern) && (position == other.position) &&
+             (size == other.size);
+    }
+
+    constexpr auto operator!=(const Match& other) const noexcept -> bool {
+      return !(*this == other);
+    }
+  };
+
+  /// Default ctor (no patterns, never matches)
+  AhoCorasick() : AhoCorasick(std::initializer_list<std::string_view>{}) {}
+
+  /// Construct the automaton from a list of \a patterns
+  explicit AhoCorasick(std::initializer_list<std::string_view> patterns)
+      : AhoCorasick(patterns.begin(), patterns.end()) {}
+
+  /**
+   * @brief Construct the automaton from a range of string-like patterns
+   *
+   * @param[in] first, last Range of objects convertible to std::string_view.
+   *                        The index of each pattern within the range is used
+   *                        to identify it in the Match found.
+   */
+  template <class It>
+  AhoCorasick(It first, It last) {
+    std::vector<std::string_view> patterns;
+    for (; first != last; ++first) patterns.emplace_back(*first);
+    Build(patterns);
+  }
+
+  /// @return The number of patterns compiled
+  auto PatternsCount() const noexcept -> std::size_t {
+    return m_sizes.size();
+  }
+
+  /// @return The number of states of the automaton
+  auto StatesCount() const noexcept -> std::size_t { return m_depth.size(); }
+
+  /// @return The number of byte classes (i.e. the width of a table row)
+  auto ClassesCount() const noexcept -> std::size_t { return m_width; }
+
+  /**
+   * @return true whenever \a str contains at least ONE of the patterns
+   *
+   * @note Stops as soon as any pattern is found
+   */
+  auto Contains(std::string_view str) const noexcept -> bool {
+    State state = 0;
+    if (m_match[state] != npos) return true;
+
+    for (auto c : str) {
+      state = Next(state, c);
+      if (m_match[state] != npos) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @return The LEFTMOST pattern found in \a str (the LONGEST one when several
+   *         patterns start at the same location, the first one provided when
+   *         they are identical). std::nullopt when none are found.
+   */
+  auto Find(std::string_view str) const noexcept -> std::optional<Match> {
+    std::optional<Match> best;
+
+    State state = 0;
+    if (m_match[state] != npos) best = Match{m_match[state], 0, 0};
+
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      state = Next(state, str[i]);
+      const std::size_t end = i + 1;
+
+      if (const auto p = m_match[state]; p != npos) {
+        const std::size_t position = end - m_sizes[p];
+        if (!best || (position < best->position) ||
+            ((position == best->position) && (m_sizes[p] > best->size))) {
+          best = Match{p, position, m_sizes[p]};
+        }
+      }
+
+      // No pattern started before (or at) the best location is still in
+      // progress: nothing found later can be more on the left
+      if (best && ((end - m_depth[state]) > best->position)) break;
+    }
+
+    return best;
+  }
+
+  /**
+   * @brief Invoke \a f(match) for ALL the (possibly overlapping) patterns
+   *        found inside \a str, ordered by their end location
+   *
+   * @param[in] str The string we wish to scan
+   * @param[in] f Callable with the signature `f(Match) -> bool`. The scan stops
+   *              as soon as it returns false.
+   */
+  template <class F>
+  auto ForEachMatch(std::string_view str, F&& f) const -> void {
+    State state = 0;
+    if (!ReportAll(state, 0, f)) return;
+
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      state = Next(state, str[i]);
+      if (!ReportAll(state, i + 1, f)) return;
+    }
+  }
+
+  /**
+   * @brief Mandatory matcher interface (see matchers.hpp)
+   *
+   * @return true whenever \a str contains at least ONE of the patterns
+   */
+  auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Contains(str);
+  }
+
+  /// @return The state reached from \a state when reading \a c
+  auto Next(State state, char c) const noexcept -> State {
+    return m_delta[(state * m_width) +
+                   m_classes[static_cast<std::uint8_t>(c)]];
+  }
+
+ private:
+  template <class F>
+  auto ReportAll(State state, std::size_t end, F& f) const -> bool {
+    for (; state != kNone; state = m_next_match[state]) {
+      const auto p = m_own[state];
+      if ((p != npos) && !f(Match{p, end - m_sizes[p], m_sizes[p]})) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto Build(const std::vector<std::string_view>& patterns) -> void {
+    // Byte classes
+    std::array<bool, 256> used = {};
+    std::size_t used_count = 0;
+    for (auto pattern : patterns) {
+      for (auto c : pattern) {
+        auto& u = used[static_cast<std::uint8_t>(c)];
+        if (!u) ++used_count;
+        u = true;
+      }
+    }
+
+    if (used_count == used.size()) {
+      // All bytes are used, no need for the 'others' class
+      for (std::size_t b = 0; b < used.size(); ++b) {
+        m_classes[b] = static_cast<std::uint8_t>(b);
+      }
+      m_width = used.size();
+    } else {
+      m_width = 1;
+      for (std::size_t b = 0; b < used.size(); ++b) {
+        m_classes[b] = used[b] ? static_cast<std::uint8_t>(m_width++) : 0;
+      }
+    }
+
+    // Trie (0 is both the root and 'no transition' since the root is never
+    // the target of a trie edge)
+    m_delta.assign(m_width, 0);
+    m_depth.assign(1, 0);
+    m_own.assign(1, npos);
+    m_sizes.clear();
+
+    for (std::size_t p = 0; p < patterns.size(); ++p) {
+      State state = 0;
+      for (auto c : patterns[p]) {
+        const std::size_t edge =
+            (state * m_width) + m_classes[static_cast<std::uint8_t>(c)];
+        if (m_delta[edge] == 0) {
+          m_delta[edge] = static_cast<State>(m_depth.size());
+          m_delta.resize(m_delta.size() + m_width, 0);
+          m_depth.push_back(m_depth[state] + 1);
+          m_own.push_back(npos);
+        }
+        state = m_delta[edge];
+      }
+
+      // Keep the first of identical patterns
+      if (m_own[state] == npos) m_own[state] = p;
+      m_sizes.push_back(patterns[p].size());
+    }
+
+    // Failure links (BFS), folded into the transition table
+    std::vector<State> fail(m_depth.size(), 0);
+    m_match = m_own;
+    m_next_match.assign(m_depth.size(), kNone);
+
+    std::vector<State> queue;
+    queue.reserve(m_depth.size());
+    queue.push_back(0);
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const State state = queue[head];
+
+      if (state != 0) {
+        // Longest proper suffix of the state being also a pattern
+        const State suffix = fail[state];
+        m_next_match[state] =
+            (m_own[suffix] != npos) ? suffix : m_next_match[suffix];
+        if (m_match[state] == npos) m_match[state] = m_match[suffix];
+      }
+
+      for (std::size_t cls = 0; cls < m_width; ++cls) {
+        auto& target = m_delta[(state * m_width) + cls];
+        const State fallback =
+            (state == 0) ? 0 : m_delta[(fail[state] * m_width) + cls];
+
+        if (target != 0) {
+          // Trie edge (rows are only filled once the state is dequeued)
+          fail[target] = fallback;
+          queue.push_back(target);
+        } else {
+          target = fallback;
+        }
+      }
+    }
+  }
+
+  static constexpr State kNone = static_cast<State>(-1);
+
+  std::array<std::uint8_t, 256> m_classes = {};
+  std::size_t m_width = 1;
+
+  std::vector<State> m_delta;         /*!< Dense table: [state][class] */
+  std::vector<std::uint32_t> m_depth; /*!< Depth of each state */
+  std::vector<std::size_t> m_own;     /*!< Pattern ending exactly on a state */
+  std::vector<std::size_t> m_match;   /*!< Longest pattern ending on a state */
+  std::vector<State> m_next_match;    /*!< Next suffix state with a pattern */
+  std::vector<std::size_t> m_sizes;   /*!< Size of each pattern */
+};
+
+}  // namespace atb
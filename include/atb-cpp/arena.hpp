@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>  // std::size_t, std::byte, std::max_align_t
+#include <cstring>  // std::memcpy
+#include <memory>   // std::unique_ptr, std::align
+#include <string_view>
+#include <utility>  // std::exchange, std::move
+#include <vector>
+
+namespace atb {
+
+/**
+ * @brief Monotonic memory arena: memory is carved out of big blocks and only
+ *        released all at once (on Reset() or destruction)
+ *
+ * Allocating is only a pointer bump (a new block is allocated when the current
+ * one is exhausted) and, since blocks are never moved nor freed individually,
+ * all pointers returned remain valid until the arena is reset/destroyed.
+ *
+ * @code{.cpp}
+ * MonotonicArena arena;
+ * std::string_view foo = arena.Copy(std::string{"foo"});
+ * // foo remains valid as long as arena is
+ * @endcode
+ *
+ * @note This class is NOT thread safe
+ * @note No destructors are called: only use it for trivially destructible
+ *       objects
+ */
+class MonotonicArena final {
+ public:
+  /// Default size of the blocks allocated
+  static constexpr std::size_t kDefaultBlockSize = 4096;
+
+  /**
+   * @brief Construct an empty arena (no memory is allocated until the first
+   *        call to Allocate())
+   *
+   * @param[in] block_size Size of the blocks allocated. Requests bigger than
+   *                       half this size get their own dedicated block.
+   */
+  explicit MonotonicArena(std::size_t block_size = kDefaultBlockSize) noexcept
+      : m_block_size(block_size > 0 ? block_size : kDefaultBlockSize) {}
+
+  /// Not copyable
+  MonotonicArena(const MonotonicArena&) = delete;
+  auto operator=(const MonotonicArena&) -> MonotonicArena& = delete;
+
+  /// Movable (pointers previously returned remain valid)
+  MonotonicArena(MonotonicArena&& other) noexcept
+      : m_block_size(other.m_block_size),
+        m_blocks(std::move(other.m_blocks)),
+        m_current(std::exchange(other.m_current, nullptr)),
+        m_left(std::exchange(other.m_left, 0)),
+        m_used(std::exchange(other.m_used, 0)) {}
+
+  auto operator=(MonotonicArena&& other) noexcept -> MonotonicArena& {
+    m_block_size = other.m_block_size;
+    m_blocks = std::move(other.m_blocks);
+    m_current = std::exchange(other.m_current, nullptr);
+    m_left = std::exchange(other.m_left, 0);
+    m_used = std::exchange(other.m_used, 0);
+    return *this;
+  }
+
+  ~MonotonicArena() noexcept = default;
+
+  /**
+   * @return A pointer to \a size bytes, aligned on \a alignment
+   *
+   * @pre alignment is a power of 2 <= alignof(std::max_align_t)
+   */
+  auto Allocate(std::size_t size,
+                std::size_t alignment = alignof(std::max_align_t)) -> void* {
+    void* ptr = m_current;
+    if ((ptr == nullptr) ||
+        (std::align(alignment, size, ptr, m_left) == nullptr)) {
+      if (size > (m_block_size / 2)) {
+        // Big requests get their own block, keeping the current one
+        m_blocks.emplace_back(new std::byte[size]);
+        m_used += size;
+        return m_blocks.back().get();
+      }
+
+      m_blocks.emplace_back(new std::byte[m_block_size]);
+      ptr = m_blocks.back().get();
+      m_left = m_block_size;
+    }
+
+    m_current = static_cast<std::byte*>(ptr) + size;
+    m_left -= size;
+    m_used += size;
+    return ptr;
+  }
+
+  /**
+   * @return A view to a copy of \a str, stored inside the arena
+   */
+  auto Copy(std::string_view str) -> std::string_view {
+    if (str.empty()) return {};
+
+    auto* data = static_cast<char*>(Allocate(str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    return {data, str.size()};
+  }
+
+  /**
+   * @brief Release all the memory allocated (invalidates all pointers
+   *        returned)
+   */
+  auto Reset() noexcept -> void {
+    m_blocks.clear();
+    m_current = nullptr;
+    m_left = 0;
+    m_used = 0;
+  }
+
+  /// @return The number of blocks allocated
+  auto BlocksCount() const noexcept -> std::size_t { return m_blocks.size(); }
+
+  /// @return The number of bytes requested through Allocate()
+  auto BytesUsed() const noexcept -> std::size_t { return m_used; }
+
+ private:
+  std::size_t m_block_size; /*!< Size of the blocks */
+  std::vector<std::unique_ptr<std::byte[]>> m_blocks; /*!< All the blocks */
+  std::byte* m_current = nullptr; /*!< Next free byte of the current block */
+  std::size_t m_left = 0;         /*!< Bytes left in the current block */
+  std::size_t m_used = 0;         /*!< Bytes requested so far */
+};
+
+}  // namespace atb
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+/**
+ * @return \a c converted to lower case, when \a c is an ASCII upper case letter
+ *
+ * @note Contrary to std::tolower, it doesn't depend on the current locale
+ */
+constexpr auto AsciiToLower(char c) noexcept -> char {
+  return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c | 0x20) : c;
+}
+
+/**
+ * @return \a c converted to upper case, when \a c is an ASCII lower case letter
+ *
+ * @note Contrary to std::toupper, it doesn't depend on the current locale
+ */
+constexpr auto AsciiToUpper(char c) noexcept -> char {
+  return ((c >= 'a') && (c <= 'z')) ? static_cast<char>(c & ~0x20) : c;
+}
+
+/**
+ * @brief Scalar implementation of AsciiIEquals()
+ */
+constexpr auto AsciiIEqualsScalar(std::string_view lhs,
+                                  std::string_view rhs) noexcept -> bool {
+  if (lhs.size() != rhs.size()) return false;
+
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (AsciiToLower(lhs[i]) != AsciiToLower(rhs[i])) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Scalar implementation of AsciiIFind()
+ */
+constexpr auto AsciiIFindScalar(std::string_view str, std::string_view pattern,
+                                std::size_t pos = 0) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  if ((pos > str.size()) || (m > (str.size() - pos))) {
+    return std::string_view::npos;
+  }
+
+  if (m == 0) return pos;
+
+  const char first = AsciiToLower(pattern.front());
+  for (; (pos + m) <= str.size(); ++pos) {
+    if ((AsciiToLower(str[pos]) == first) &&
+        AsciiIEqualsScalar(str.substr(pos + 1, m - 1), pattern.substr(1))) {
+      return pos;
+    }
+  }
+  return std::string_view::npos;
+}
+
+/**
+ * @brief Scalar implementation of AsciiIRFind()
+ */
+constexpr auto AsciiIRFindScalar(std::string_view str, std::string_view pattern,
+                                 std::size_t pos = std::string_view::npos)
+    noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  if (m > str.size()) return std::string_view::npos;
+
+  std::size_t i = (str.size() - m);
+  if (pos < i) i = pos;
+  if (m == 0) return i;
+
+  const char first = AsciiToLower(pattern.front());
+  for (++i; i > 0; --i) {
+    if ((AsciiToLower(str[i - 1]) == first) &&
+        AsciiIEqualsScalar(str.substr(i, m - 1), pattern.substr(1))) {
+      return i - 1;
+    }
+  }
+  return std::string_view::npos;
+}
+
+/**
+ * @return true when \a lhs and \a rhs are equal, ignoring ASCII case
+ *
+ * @note The case is folded on the fly (16/32 bytes at once with SSE2/AVX2),
+ *       without any allocation
+ */
+inline auto AsciiIEquals(std::string_view lhs, std::string_view rhs) noexcept
+    -> bool;
+
+/**
+ * @return The index of the FIRST occurrence of \a pattern in \a str, starting
+ *         at \a pos and ignoring ASCII case. npos if not found.
+ *
+ * @note Same as std::string_view::find, but case insensitive
+ */
+inline auto AsciiIFind(std::string_view str, std::string_view pattern,
+                       std::size_t pos = 0) noexcept -> std::size_t;
+
+/**
+ * @return The index of the LAST occurrence of \a pattern in \a str, starting
+ *         at or before \a pos and ignoring ASCII case. npos if not found.
+ *
+ * @note Same as std::string_view::rfind, but case insensitive
+ */
+inline auto AsciiIRFind(std::string_view str, std::string_view pattern,
+                        std::size_t pos = std::string_view::npos) noexcept
+    -> std::size_t;
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+// Lower casing 16/32 bytes at once: 'A' is shifted to -128 (the lowest signed
+// value), hence upper case letters are exactly the bytes lower than -128 + 26.
+// The 0x20 bit is then set on those bytes only.
+
+ATB_SIMD_TARGET("sse2")
+inline auto AsciiToLowerSse2(__m128i v) noexcept -> __m128i {
+  const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(128 - 'A'));
+  const __m128i is_upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+  return _mm_or_si128(v, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto AsciiToLowerAvx2(__m256i v) noexcept -> __m256i {
+  const __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(128 - 'A'));
+  const __m256i is_upper =
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+  return _mm256_or_si256(v, _mm256_and_si256(is_upper, _mm256_set1_epi8(0x20)));
+}
+
+ATB_SIMD_TARGET("sse2")
+inline auto AsciiLoadLowerSse2(const char* data) noexcept -> __m128i {
+  return AsciiToLowerSse2(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto AsciiLoadLowerAvx2(const char* data) noexcept -> __m256i {
+  return AsciiToLowerAvx2(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)));
+}
+
+/// @pre lhs.size() == rhs.size()
+ATB_SIMD_TARGET("sse2")
+inline auto AsciiIEqualsSse2(std::string_view lhs,
+                             std::string_view rhs) noexcept -> bool {
+  std::size_t i = 0;
+  for (; (i + 16) <= lhs.size(); i += 16) {
+    const __m128i eq = _mm_cmpeq_epi8(AsciiLoadLowerSse2(lhs.data() + i),
+                                      AsciiLoadLowerSse2(rhs.data() + i));
+    if (_mm_movemask_epi8(eq) != 0xFFFF) return false;
+  }
+  return AsciiIEqualsScalar(lhs.substr(i), rhs.substr(i));
+}
+
+/// @pre lhs.size() == rhs.size()
+ATB_SIMD_TARGET("avx2")
+inline auto AsciiIEqualsAvx2(std::string_view lhs,
+                             std::string_view rhs) noexcept -> bool {
+  std::size_t i = 0;
+  for (; (i + 32) <= lhs.size(); i += 32) {
+    const __m256i eq = _mm256_cmpeq_epi8(AsciiLoadLowerAvx2(lhs.data() + i),
+                                         AsciiLoadLowerAvx2(rhs.data() + i));
+    if (static_cast<std::uint32_t>(_mm256_movemask_epi8(eq)) != 0xFFFFFFFFu) {
+      return false;
+    }
+  }
+  return AsciiIEqualsSse2(lhs.substr(i), rhs.substr(i));
+}
+
+/// @return true when the pattern middle bytes (all but first/last) match
+inline auto AsciiIMiddleEquals(const char* candidate,
+                               std::string_view pattern) noexcept -> bool {
+  return (pattern.size() <= 2) ||
+         AsciiIEquals(std::string_view{candidate + 1, pattern.size() - 2},
+                      pattern.substr(1, pattern.size() - 2));
+}
+
+/// @pre 0 < pattern.size() <= (str.size() - pos)
+ATB_SIMD_TARGET("sse2")
+inline auto AsciiIFindSse2(std::string_view str, std::string_view pattern,
+                           std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m128i first = _mm_set1_epi8(AsciiToLower(pattern.front()));
+  const __m128i last = _mm_set1_epi8(AsciiToLower(pattern.back()));
+
+  for (; (pos + m - 1 + 16) <= str.size(); pos += 16) {
+    const char* data = str.data() + pos;
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, AsciiLoadLowerSse2(data)),
+        _mm_cmpeq_epi8(last, AsciiLoadLowerSse2(data + m - 1)))));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const auto bit = simd::CountTrailingZeros(mask);
+      if (AsciiIMiddleEquals(data + bit, pattern)) return pos + bit;
+    }
+  }
+
+  return AsciiIFindScalar(str, pattern, pos);
+}
+
+/// @pre 0 < pattern.size() <= (str.size() - pos)
+ATB_SIMD_TARGET("avx2")
+inline auto AsciiIFindAvx2(std::string_view str, std::string_view pattern,
+                           std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m256i first = _mm256_set1_epi8(AsciiToLower(pattern.front()));
+  const __m256i last = _mm256_set1_epi8(AsciiToLower(pattern.back()));
+
+  for (; (pos + m - 1 + 32) <= str.size(); pos += 32) {
+    const char* data = str.data() + pos;
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, AsciiLoadLowerAvx2(data)),
+            _mm256_cmpeq_epi8(last, AsciiLoadLowerAvx2(data + m - 1)))));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const auto bit = simd::CountTrailingZeros(mask);
+      if (AsciiIMiddleEquals(data + bit, pattern)) return pos + bit;
+    }
+  }
+
+  return AsciiIFindSse2(str, pattern, pos);
+}
+
+/// @param[in] end One past the last candidate index to look at
+/// @pre 0 < pattern.size() && (end + pattern.size() - 1) <= str.size()
+ATB_SIMD_TARGET("sse2")
+inline auto AsciiIRFindSse2(std::string_view str, std::string_view pattern,
+                            std::size_t end) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m128i first = _mm_set1_epi8(AsciiToLower(pattern.front()));
+  const __m128i last = _mm_set1_epi8(AsciiToLower(pattern.back()));
+
+  for (; end >= 16; end -= 16) {
+    const char* data = str.data() + end - 16;
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, AsciiLoadLowerSse2(data)),
+        _mm_cmpeq_epi8(last, AsciiLoadLowerSse2(data + m - 1)))));
+
+    while (mask != 0) {
+      const auto bit = simd::HighestBitSet(mask);
+      if (AsciiIMiddleEquals(data + bit, pattern)) return end - 16 + bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return (end == 0) ? std::string_view::npos
+                    : AsciiIRFindScalar(str, pattern, end - 1);
+}
+
+/// @param[in] end One past the last candidate index to look at
+/// @pre 0 < pattern.size() && (end + pattern.size() - 1) <= str.size()
+ATB_SIMD_TARGET("avx2")
+inline auto AsciiIRFindAvx2(std::string_view str, std::string_view pattern,
+                            std::size_t end) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m256i first = _mm256_set1_epi8(AsciiToLower(pattern.front()));
+  const __m256i last = _mm256_set1_epi8(AsciiToLower(pattern.back()));
+
+  for (; end >= 32; end -= 32) {
+    const char* data = str.data() + end - 32;
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, AsciiLoadLowerAvx2(data)),
+            _mm256_cmpeq_epi8(last, AsciiLoadLowerAvx2(data + m - 1)))));
+
+    while (mask != 0) {
+      const auto bit = simd::HighestBitSet(mask);
+      if (AsciiIMiddleEquals(data + bit, pattern)) return end - 32 + bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return AsciiIRFindSse2(str, pattern, end);
+}
+
+#endif  // ATB_SIMD_X86
+
+}  // namespace details
+
+inline auto AsciiIEquals(std::string_view lhs, std::string_view rhs) noexcept
+    -> bool {
+  if (lhs.size() != rhs.size()) return false;
+
+#if ATB_SIMD_X86
+  if (lhs.size() >= 16) {
+    switch (simd::DetectedIsa()) {
+      case simd::Isa::kAvx2:
+        return details::AsciiIEqualsAvx2(lhs, rhs);
+      case simd::Isa::kSsse3:
+      case simd::Isa::kSse2:
+        return details::AsciiIEqualsSse2(lhs, rhs);
+      case simd::Isa::kScalar:
+        break;
+    }
+  }
+#endif
+
+  return AsciiIEqualsScalar(lhs, rhs);
+}
+
+inline auto AsciiIFind(std::string_view str, std::string_view pattern,
+                       std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  if ((pos > str.size()) || (m > (str.size() - pos))) {
+    return std::string_view::npos;
+  }
+  if (m == 0) return pos;
+
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return details::AsciiIFindAvx2(str, pattern, pos);
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      return details::AsciiIFindSse2(str, pattern, pos);
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+
+  return AsciiIFindScalar(str, pattern, pos);
+}
+
+inline auto AsciiIRFind(std::string_view str, std::string_view pattern,
+                        std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  if (m > str.size()) return std::string_view::npos;
+  if (m == 0) return (pos < str.size()) ? pos : str.size();
+
+#if ATB_SIMD_X86
+  const std::size_t last_candidate = str.size() - m;
+  const std::size_t end = ((pos < last_candidate) ? pos : last_candidate) + 1;
+
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return details::AsciiIRFindAvx2(str, pattern, end);
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      return details::AsciiIRFindSse2(str, pattern, end);
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+
+  return AsciiIRFindScalar(str, pattern, pos);
+}
+
+}  // namespace atb
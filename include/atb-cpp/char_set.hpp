@@ -0,0 +1,277 @@
+#pragma once
+
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+/**
+ * @brief Precompiled set of chars, used to search for ANY of its chars inside
+ *        a string
+ *
+ * The set is stored as:
+ * - A 256 bits bitmap, used by the scalar search (and constexpr contexts);
+ * - Two 16 bytes nibble tables, used by the vectorized search (SSSE3/AVX2)
+ *   through `pshufb` lookups, testing 16/32 chars per step.
+ *
+ * For a char c = (hi << 4 | lo), the bit (hi % 8) of `m_nibbles[hi / 8][lo]`
+ * is set whenever c is part of the set. Hence testing a char only requires 2
+ * table lookups (one per half of the high nibble range) and a AND.
+ *
+ * @code{.cpp}
+ * constexpr CharSet spaces(" \t\r\n");
+ * assert(spaces.Find("foo bar") == 3);
+ * assert(spaces.RFind("foo bar baz") == 7);
+ * @endcode
+ */
+class CharSet final {
+ public:
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  /// Default ctor (empty set)
+  constexpr CharSet() noexcept = default;
+
+  /// Construct a set containing all the chars of \a chars
+  constexpr explicit CharSet(std::string_view chars) noexcept {
+    for (auto c : chars) Insert(c);
+  }
+
+  /**
+   * @brief Add \a c to the set
+   */
+  constexpr auto Insert(char c) noexcept -> CharSet& {
+    const auto u = static_cast<std::uint8_t>(c);
+    m_bitmap[u / 64u] |= (std::uint64_t{1} << (u % 64u));
+    m_nibbles[u >> 7u][u & 0x0Fu] |=
+        static_cast<std::uint8_t>(1u << ((u >> 4u) & 0x07u));
+    return *this;
+  }
+
+  /**
+   * @return true when \a c is part of the set
+   */
+  constexpr auto Contains(char c) const noexcept -> bool {
+    const auto u = static_cast<std::uint8_t>(c);
+    return (m_bitmap[u / 64u] & (std::uint64_t{1} << (u % 64u))) != 0;
+  }
+
+  /**
+   * @return true when the set doesn't contain any char
+   */
+  constexpr auto Empty() const noexcept -> bool {
+    return (m_bitmap[0] | m_bitmap[1] | m_bitmap[2] | m_bitmap[3]) == 0;
+  }
+
+  /**
+   * @return The index of the FIRST char of \a str, starting at \a pos, that is
+   *         part of the set. npos if none.
+   *
+   * @note Same as std::string_view::find_first_of
+   */
+  auto Find(std::string_view str, std::size_t pos = 0) const noexcept
+      -> std::size_t;
+
+  /**
+   * @return The index of the LAST char of \a str, ending at \a pos (included),
+   *         that is part of the set. npos if none.
+   *
+   * @note Same as std::string_view::find_last_of
+   */
+  auto RFind(std::string_view str, std::size_t pos = npos) const noexcept
+      -> std::size_t;
+
+  /**
+   * @brief Scalar (bitmap based) implementation of Find()
+   */
+  constexpr auto FindScalar(std::string_view str, std::size_t pos = 0) const
+      noexcept -> std::size_t {
+    for (; pos < str.size(); ++pos) {
+      if (Contains(str[pos])) return pos;
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Scalar (bitmap based) implementation of RFind()
+   */
+  constexpr auto RFindScalar(std::string_view str,
+                             std::size_t pos = npos) const noexcept
+      -> std::size_t {
+    if (str.empty()) return npos;
+    if (pos >= str.size()) pos = str.size() - 1;
+
+    for (std::size_t i = pos + 1; i > 0; --i) {
+      if (Contains(str[i - 1])) return i - 1;
+    }
+    return npos;
+  }
+
+  /// Nibble lookup tables, used by the vectorized kernels
+  constexpr auto Nibbles() const noexcept
+      -> const std::array<std::array<std::uint8_t, 16>, 2>& {
+    return m_nibbles;
+  }
+
+ private:
+  std::array<std::uint64_t, 4> m_bitmap = {};
+  std::array<std::array<std::uint8_t, 16>, 2> m_nibbles = {};
+};
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+/// @return A mask with bit i set when `data[i]` is part of the set
+ATB_SIMD_TARGET("ssse3")
+inline auto CharSetMatchSsse3(const CharSet& set, const char* data) noexcept
+    -> std::uint32_t {
+  const auto& nibbles = set.Nibbles();
+  const __m128i low_tbl = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(nibbles[0].data()));
+  const __m128i high_tbl = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(nibbles[1].data()));
+  const __m128i low_bits =
+      _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i high_bits =
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i lo = _mm_and_si128(v, nibble_mask);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask);
+
+  const __m128i hits = _mm_or_si128(
+      _mm_and_si128(_mm_shuffle_epi8(low_tbl, lo),
+                    _mm_shuffle_epi8(low_bits, hi)),
+      _mm_and_si128(_mm_shuffle_epi8(high_tbl, lo),
+                    _mm_shuffle_epi8(high_bits, hi)));
+
+  const auto misses = static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(hits, _mm_setzero_si128())));
+  return (~misses) & 0xFFFFu;
+}
+
+/// @return A mask with bit i set when `data[i]` is part of the set
+ATB_SIMD_TARGET("avx2")
+inline auto CharSetMatchAvx2(const CharSet& set, const char* data) noexcept
+    -> std::uint32_t {
+  const auto& nibbles = set.Nibbles();
+  const __m256i low_tbl = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(nibbles[0].data())));
+  const __m256i high_tbl = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(nibbles[1].data())));
+  const __m256i low_bits = _mm256_setr_epi8(
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,  //
+      1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i high_bits = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128,  //
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+
+  const __m256i v =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m256i lo = _mm256_and_si256(v, nibble_mask);
+  const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask);
+
+  const __m256i hits = _mm256_or_si256(
+      _mm256_and_si256(_mm256_shuffle_epi8(low_tbl, lo),
+                       _mm256_shuffle_epi8(low_bits, hi)),
+      _mm256_and_si256(_mm256_shuffle_epi8(high_tbl, lo),
+                       _mm256_shuffle_epi8(high_bits, hi)));
+
+  return ~static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256())));
+}
+
+ATB_SIMD_TARGET("ssse3")
+inline auto CharSetFindSsse3(const CharSet& set, std::string_view str,
+                             std::size_t pos) noexcept -> std::size_t {
+  for (; (pos + 16) <= str.size(); pos += 16) {
+    if (const auto m = CharSetMatchSsse3(set, str.data() + pos); m != 0) {
+      return pos + simd::CountTrailingZeros(m);
+    }
+  }
+  return set.FindScalar(str, pos);
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto CharSetFindAvx2(const CharSet& set, std::string_view str,
+                            std::size_t pos) noexcept -> std::size_t {
+  for (; (pos + 32) <= str.size(); pos += 32) {
+    if (const auto m = CharSetMatchAvx2(set, str.data() + pos); m != 0) {
+      return pos + simd::CountTrailingZeros(m);
+    }
+  }
+  return set.FindScalar(str, pos);
+}
+
+/// @param[in] end One past the last index to look at
+ATB_SIMD_TARGET("ssse3")
+inline auto CharSetRFindSsse3(const CharSet& set, std::string_view str,
+                              std::size_t end) noexcept -> std::size_t {
+  for (; end >= 16; end -= 16) {
+    if (const auto m = CharSetMatchSsse3(set, str.data() + end - 16); m != 0) {
+      return end - 16 + simd::HighestBitSet(m);
+    }
+  }
+  return (end == 0) ? CharSet::npos : set.RFindScalar(str, end - 1);
+}
+
+/// @param[in] end One past the last index to look at
+ATB_SIMD_TARGET("avx2")
+inline auto CharSetRFindAvx2(const CharSet& set, std::string_view str,
+                             std::size_t end) noexcept -> std::size_t {
+  for (; end >= 32; end -= 32) {
+    if (const auto m = CharSetMatchAvx2(set, str.data() + end - 32); m != 0) {
+      return end - 32 + simd::HighestBitSet(m);
+    }
+  }
+  return (end == 0) ? CharSet::npos : set.RFindScalar(str, end - 1);
+}
+
+#endif  // ATB_SIMD_X86
+
+}  // namespace details
+
+inline auto CharSet::Find(std::string_view str, std::size_t pos) const noexcept
+    -> std::size_t {
+#if ATB_SIMD_X86
+  if ((pos < str.size()) && ((str.size() - pos) >= 16)) {
+    switch (simd::DetectedIsa()) {
+      case simd::Isa::kAvx2:
+        return details::CharSetFindAvx2(*this, str, pos);
+      case simd::Isa::kSsse3:
+        return details::CharSetFindSsse3(*this, str, pos);
+      case simd::Isa::kSse2:
+      case simd::Isa::kScalar:
+        break;
+    }
+  }
+#endif
+  return FindScalar(str, pos);
+}
+
+inline auto CharSet::RFind(std::string_view str, std::size_t pos) const noexcept
+    -> std::size_t {
+#if ATB_SIMD_X86
+  const std::size_t end = (pos >= str.size()) ? str.size() : (pos + 1);
+  if (end >= 16) {
+    switch (simd::DetectedIsa()) {
+      case simd::Isa::kAvx2:
+        return details::CharSetRFindAvx2(*this, str, end);
+      case simd::Isa::kSsse3:
+        return details::CharSetRFindSsse3(*this, str, end);
+      case simd::Isa::kSse2:
+      case simd::Isa::kScalar:
+        break;
+    }
+  }
+#endif
+  return RFindScalar(str, pos);
+}
+
+}  // namespace atb
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>  // std::min
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <cstdint>
+#include <limits>  // std::numeric_limits
+#include <optional>
+#include <string_view>
+#include <utility>  // std::swap
+#include <vector>
+
+namespace atb {
+
+/**
+ * @brief Approximate string matcher, based on the Levenshtein distance (number
+ *        of chars inserted, deleted or substituted) to a pattern
+ *
+ * This is Myers' bit-vector algorithm: a column of the dynamic programming
+ * matrix (one cell per char of the pattern) is encoded as vertical deltas (+1,
+ * 0 or -1) packed into 64 bits words, updated in O(1) word operations per
+ * char of the input. Hence the cost is O(n * ceil(m / 64)), instead of the
+ * O(n * m) of the usual dynamic programming.
+ *
+ * Two modes are available (see StrNear() and StrContainsNear()):
+ * - kFullMatch: distance between the pattern and the WHOLE input;
+ * - kSearch: smallest distance between the pattern and any substring of the
+ *   input.
+ *
+ * @code{.cpp}
+ * const auto near = StrNear("kitten", 2);
+ * assert(near.Distance("sitting") == 3);
+ * assert(near.Score("sitten") == 1);
+ * assert(!near.Score("sitting").has_value());
+ *
+ * assert(::IsMatching(near, "kitchen"));
+ * assert(::IsMatching(StrContainsNear("kitten", 1), "my kiten is cute"));
+ * @endcode
+ */
+class StrNearMatcher final {
+ public:
+  /// Part of the inputs compared to the pattern
+  enum class Mode : std::uint8_t {
+    kFullMatch, /*!< The whole input */
+    kSearch,    /*!< Any substring of the input */
+  };
+
+  /**
+   * @brief Construct a matcher of strings at most \a max_edits edits away
+   *        from \a pattern
+   *
+   * @param[in] pattern The pattern to compare inputs to
+   * @param[in] max_edits Maximum distance accepted by Score()/IsMatching()
+   * @param[in] mode Part of the inputs compared to the pattern
+   */
+  StrNearMatcher(std::string_view pattern, std::size_t max_edits,
+                 Mode mode = Mode::kFullMatch)
+      : m_size(pattern.size()),
+        m_blocks((pattern.size() + 63) / 64),
+        m_max_edits(max_edits),
+        m_mode(mode),
+        m_peq(256 * m_blocks, 0) {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+      const auto c = static_cast<std::uint8_t>(pattern[i]);
+      m_peq[(c * m_blocks) + (i / 64)] |= (std::uint64_t{1} << (i % 64));
+    }
+  }
+
+  /// @return The size of the pattern
+  auto PatternSize() const noexcept -> std::size_t { return m_size; }
+
+  /// @return The maximum distance accepted
+  auto MaxEdits() const noexcept -> std::size_t { return m_max_edits; }
+
+  /// @return The mode of the matcher
+  auto GetMode() const noexcept -> Mode { return m_mode; }
+
+  /// @return The distance between the pattern and \a str (see Mode)
+  auto Distance(std::string_view str) const -> std::size_t {
+    return Run(str, std::numeric_limits<std::size_t>::max());
+  }
+
+  /**
+   * @return The distance between the pattern and \a str, when not greater
+   *         than MaxEdits()
+   *
+   * @note Faster than Distance(): inputs are rejected as soon as their
+   *       distance can't be lower than MaxEdits() (e.g. based on their size)
+   */
+  auto Score(std::string_view str) const -> std::optional<std::size_t> {
+    if ((m_mode == Mode::kFullMatch) &&
+        (Difference(str.size(), m_size) > m_max_edits)) {
+      return std::nullopt;
+    }
+
+    const std::size_t distance = Run(str, m_max_edits);
+    if (distance > m_max_edits) return std::nullopt;
+    return distance;
+  }
+
+  /**
+   * @brief Batch mode: Score() each string of \a candidates
+   *
+   * @param[in] candidates Range of strings (convertible to std::string_view)
+   * @param[inout] d_first Output iterator receiving, for each candidate, its
+   *                       std::optional<std::size_t> score
+   *
+   * @return The output iterator, past the last score written
+   */
+  template <class Range, class OutputIt>
+  auto ScoreAll(const Range& candidates, OutputIt d_first) const -> OutputIt {
+    for (const auto& candidate : candidates) {
+      *d_first = Score(std::string_view{candidate});
+      ++d_first;
+    }
+    return d_first;
+  }
+
+  /// @brief Matcher interface (see matchers.hpp)
+  /// @return true when the distance to \a str is not greater than MaxEdits()
+  auto IsMatching(std::string_view str) const -> bool {
+    return Score(str).has_value();
+  }
+
+ private:
+  static constexpr auto Difference(std::size_t a, std::size_t b) noexcept
+      -> std::size_t {
+    return a > b ? a - b : b - a;
+  }
+
+  /// Vertical deltas of a block of 64 cells of a column
+  struct Block {
+    std::uint64_t pv = ~std::uint64_t{0}; /*!< +1 deltas */
+    std::uint64_t mv = 0;                 /*!< -1 deltas */
+  };
+
+  /**
+   * @brief Process the char whose equality mask is \a eq on \a block, given
+   *        the horizontal delta \a hin of the row above the block
+   *
+   * @param[in] high The bit of the last row of the block
+   * @return The horizontal delta of the last row of the block
+   */
+  static auto Advance(Block& block, std::uint64_t eq, int hin,
+                      std::uint64_t high) noexcept -> int {
+    const std::uint64_t xv = eq | block.mv;
+    if (hin < 0) eq |= 1;  // Carry of the addition of the previous block
+    const std::uint64_t xh = (((eq & block.pv) + block.pv) ^ block.pv) | eq;
+
+    std::uint64_t ph = block.mv | ~(xh | block.pv);
+    std::uint64_t mh = block.pv & xh;
+
+    int hout = 0;
+    if ((ph & high) != 0) {
+      hout = 1;
+    } else if ((mh & high) != 0) {
+      hout = -1;
+    }
+
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) {
+      mh |= 1;
+    } else if (hin > 0) {
+      ph |= 1;
+    }
+
+    block.pv = mh | ~(xv | ph);
+    block.mv = ph & xv;
+    return hout;
+  }
+
+  /// @return The distance to \a str, or any value > \a limit when it is
+  ///         known to be greater than \a limit
+  auto Run(std::string_view str, std::size_t limit) const -> std::size_t {
+    if (m_size == 0) return m_mode == Mode::kFullMatch ? str.size() : 0;
+
+    // Horizontal delta of the first row: D[0][j] = j when matching the whole
+    // input, 0 (the match may start anywhere) otherwise
+    const int hin = (m_mode == Mode::kFullMatch) ? 1 : 0;
+    const std::uint64_t high = std::uint64_t{1} << ((m_size - 1) % 64);
+
+    std::size_t score = m_size;
+    std::size_t best = score;
+    const auto update = [&](int hout, std::size_t remaining) -> bool {
+      score = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(score) +
+                                       hout);
+      if (m_mode == Mode::kSearch) {
+        best = std::min(best, score);
+        return best > 0;
+      }
+      // Each remaining char lowers the score by 1 at most
+      return (score <= remaining) || ((score - remaining) <= limit);
+    };
+
+    if (m_blocks == 1) {
+      Block block;
+      for (std::size_t j = 0; j < str.size(); ++j) {
+        const auto c = static_cast<std::uint8_t>(str[j]);
+        const int hout = Advance(block, m_peq[c], hin, high);
+        if (!update(hout, str.size() - j - 1)) break;
+      }
+    } else {
+      constexpr std::uint64_t kHigh = std::uint64_t{1} << 63;
+      std::vector<Block> blocks(m_blocks);
+      for (std::size_t j = 0; j < str.size(); ++j) {
+        const std::uint64_t* eq =
+            &m_peq[static_cast<std::uint8_t>(str[j]) * m_blocks];
+
+        int hout = hin;
+        for (std::size_t b = 0; (b + 1) < m_blocks; ++b) {
+          hout = Advance(blocks[b], eq[b], hout, kHigh);
+        }
+        hout = Advance(blocks.back(), eq[m_blocks - 1], hout, high);
+        if (!update(hout, str.size() - j - 1)) break;
+      }
+    }
+
+    return m_mode == Mode::kSearch ? best : score;
+  }
+
+  std::size_t m_size;      /*!< Size of the pattern */
+  std::size_t m_blocks;    /*!< Number of 64 bits blocks per column */
+  std::size_t m_max_edits; /*!< Maximum distance accepted */
+  Mode m_mode;
+
+  /// Equality masks: bit i of block b of char c is set when
+  /// pattern[b * 64 + i] == c (at index c * m_blocks + b)
+  std::vector<std::uint64_t> m_peq;
+};
+
+/**
+ * @return A StrNearMatcher, true whenever the given str is at most
+ *         \a max_edits edits (insertions, deletions, substitutions) away from
+ *         \a pattern
+ */
+inline auto StrNear(std::string_view pattern, std::size_t max_edits)
+    -> StrNearMatcher {
+  return StrNearMatcher(pattern, max_edits, StrNearMatcher::Mode::kFullMatch);
+}
+
+/**
+ * @return A StrNearMatcher, true whenever the given str contains a substring
+ *         at most \a max_edits edits away from \a pattern
+ */
+inline auto StrContainsNear(std::string_view pattern, std::size_t max_edits)
+    -> StrNearMatcher {
+  return StrNearMatcher(pattern, max_edits, StrNearMatcher::Mode::kSearch);
+}
+
+/// @return The Levenshtein distance between \a lhs and \a rhs
+inline auto StrEditDistance(std::string_view lhs, std::string_view rhs)
+    -> std::size_t {
+  // The shortest string is the pattern: less blocks per column
+  if (lhs.size() > rhs.size()) std::swap(lhs, rhs);
+  return StrNearMatcher(lhs, 0).Distance(rhs);
+}
+
+}  // namespace atb
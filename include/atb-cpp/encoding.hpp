@@ -0,0 +1,1320 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+// SIZES ///////////////////////////////////////////////////////////////////////
+
+/// @return The size of \a size bytes, hex encoded
+constexpr auto HexEncodedSize(std::size_t size) noexcept -> std::size_t {
+  return size * 2;
+}
+
+/// @return The size of \a hex, decoded. std::nullopt when the size is odd.
+constexpr auto HexDecodedSize(std::string_view hex) noexcept
+    -> std::optional<std::size_t> {
+  if ((hex.size() % 2) != 0) return std::nullopt;
+  return hex.size() / 2;
+}
+
+/// @return The size of \a size bytes, base64 encoded (with padding)
+constexpr auto Base64EncodedSize(std::size_t size) noexcept -> std::size_t {
+  return ((size + 2) / 3) * 4;
+}
+
+/**
+ * @return The size of \a base64, decoded. std::nullopt when its size isn't a
+ *         multiple of 4.
+ */
+constexpr auto Base64DecodedSize(std::string_view base64) noexcept
+    -> std::optional<std::size_t> {
+  if ((base64.size() % 4) != 0) return std::nullopt;
+
+  std::size_t padding = 0;
+  if (!base64.empty() && (base64.back() == '=')) ++padding;
+  if ((base64.size() > 1) && (base64[base64.size() - 2] == '=')) ++padding;
+  return ((base64.size() / 4) * 3) - padding;
+}
+
+namespace details {
+
+constexpr std::string_view kHexDigits = "0123456789abcdef";
+
+constexpr std::string_view kBase64Alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// @return The value of the hex digit \a c. -1 if not a hex digit.
+constexpr auto HexValue(char c) noexcept -> int {
+  if ((c >= '0') && (c <= '9')) return c - '0';
+  if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+  if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+  return -1;
+}
+
+/// @return The value of the base64 char \a c. -1 if not a base64 char.
+constexpr auto Base64Value(char c) noexcept -> int {
+  if ((c >= 'A') && (c <= 'Z')) return c - 'A';
+  if ((c >= 'a') && (c <= 'z')) return c - 'a' + 26;
+  if ((c >= '0') && (c <= '9')) return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+/// @return The byte \a value (0..255) as a char
+constexpr auto ToChar(unsigned value) noexcept -> char {
+  return static_cast<char>(static_cast<unsigned char>(value));
+}
+
+/// @return \a c as an unsigned byte value
+constexpr auto ToByte(char c) noexcept -> unsigned {
+  return static_cast<unsigned char>(c);
+}
+
+}  // namespace details
+
+// HEX /////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Scalar implementation of StrHexEncode()
+ */
+constexpr auto StrHexEncodeScalar(std::string_view data, char* d_first,
+                                  std::size_t d_size) noexcept
+    -> std::optional<char*> {
+  if (data.size() > (d_size / 2)) return std::nullopt;
+
+  for (char c : data) {
+    *d_first++ = details::kHexDigits[details::ToByte(c) >> 4];
+    *d_first++ = details::kHexDigits[details::ToByte(c) & 0x0Fu];
+  }
+  return d_first;
+}
+
+/**
+ * @brief Scalar implementation of StrHexDecode()
+ */
+constexpr auto StrHexDecodeScalar(std::string_view hex, char* d_first,
+                                  std::size_t d_size,
+                                  std::size_t* const d_where = nullptr) noexcept
+    -> std::optional<char*> {
+  const auto size = HexDecodedSize(hex);
+  if (!size || (*size > d_size)) return std::nullopt;
+
+  for (std::size_t i = 0; i < hex.size(); i += 2) {
+    const int high = details::HexValue(hex[i]);
+    const int low = details::HexValue(hex[i + 1]);
+    if ((high < 0) || (low < 0)) {
+      if (d_where != nullptr) *d_where = (high < 0) ? i : (i + 1);
+      return std::nullopt;
+    }
+    *d_first++ = details::ToChar(static_cast<unsigned>((high << 4) | low));
+  }
+  return d_first;
+}
+
+/**
+ * @brief Write \a data, hex encoded (lower case), into \a d_first
+ *
+ * @code{.cpp}
+ * char buffer[8];
+ * auto end = StrHexEncode("\x01\xAB", buffer, sizeof(buffer));
+ * assert(std::string_view(buffer, *end - buffer) == "01ab");
+ * @endcode
+ *
+ * @note Encodes 16/32 bytes at once with SSSE3/AVX2
+ *
+ * @param[in] data The bytes to encode
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ *
+ * @return One past the last char written. std::nullopt (nothing written) when
+ *         \a d_size is smaller than HexEncodedSize(data.size()).
+ */
+inline auto StrHexEncode(std::string_view data, char* d_first,
+                         std::size_t d_size) noexcept -> std::optional<char*>;
+
+/**
+ * @brief Write \a hex, decoded, into \a d_first
+ *
+ * @note Decodes 32/64 chars at once with SSSE3/AVX2. Both lower and upper case
+ *       digits are accepted.
+ *
+ * @param[in] hex The hex digits to decode
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid digit
+ *
+ * @return One past the last byte written. std::nullopt when \a hex has an odd
+ *         size, contains an invalid digit (the content of \a d_first is then
+ *         unspecified) or when \a d_size is too small (nothing written).
+ */
+inline auto StrHexDecode(std::string_view hex, char* d_first,
+                         std::size_t d_size,
+                         std::size_t* const d_where = nullptr) noexcept
+    -> std::optional<char*>;
+
+// BASE64 //////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Scalar implementation of StrBase64Encode()
+ */
+constexpr auto StrBase64EncodeScalar(std::string_view data, char* d_first,
+                                     std::size_t d_size) noexcept
+    -> std::optional<char*> {
+  if (((data.size() + 2) / 3) > (d_size / 4)) return std::nullopt;
+
+  using details::kBase64Alphabet;
+  using details::ToByte;
+
+  std::size_t i = 0;
+  for (; (i + 3) <= data.size(); i += 3) {
+    const unsigned bits = (ToByte(data[i]) << 16) |
+                          (ToByte(data[i + 1]) << 8) | ToByte(data[i + 2]);
+    *d_first++ = kBase64Alphabet[bits >> 18];
+    *d_first++ = kBase64Alphabet[(bits >> 12) & 0x3Fu];
+    *d_first++ = kBase64Alphabet[(bits >> 6) & 0x3Fu];
+    *d_first++ = kBase64Alphabet[bits & 0x3Fu];
+  }
+
+  if (i < data.size()) {
+    const bool two = (i + 2) == data.size();
+    const unsigned bits =
+        (ToByte(data[i]) << 16) | (two ? (ToByte(data[i + 1]) << 8) : 0u);
+    *d_first++ = kBase64Alphabet[bits >> 18];
+    *d_first++ = kBase64Alphabet[(bits >> 12) & 0x3Fu];
+    *d_first++ = two ? kBase64Alphabet[(bits >> 6) & 0x3Fu] : '=';
+    *d_first++ = '=';
+  }
+
+  return d_first;
+}
+
+/**
+ * @brief Scalar implementation of StrBase64Decode()
+ */
+constexpr auto StrBase64DecodeScalar(std::string_view base64, char* d_first,
+                                     std::size_t d_size,
+                                     std::size_t* const d_where = nullptr)
+    noexcept -> std::optional<char*> {
+  const auto size = Base64DecodedSize(base64);
+  if (!size || (*size > d_size)) return std::nullopt;
+
+  for (std::size_t i = 0; i < base64.size(); i += 4) {
+    // Padding is only allowed at the end of the last quantum
+    const bool last = (i + 4) == base64.size();
+    const std::size_t padding =
+        last ? ((base64[i + 3] == '=') ? ((base64[i + 2] == '=') ? 2 : 1) : 0)
+             : 0;
+
+    unsigned bits = 0;
+    for (std::size_t j = 0; j < (4 - padding); ++j) {
+      const int value = details::Base64Value(base64[i + j]);
+      if (value < 0) {
+        if (d_where != nullptr) *d_where = i + j;
+        return std::nullopt;
+      }
+      bits |= static_cast<unsigned>(value) << (18 - (6 * j));
+    }
+
+    *d_first++ = details::ToChar(bits >> 16);
+    if (padding < 2) *d_first++ = details::ToChar((bits >> 8) & 0xFFu);
+    if (padding < 1) *d_first++ = details::ToChar(bits & 0xFFu);
+  }
+
+  return d_first;
+}
+
+/**
+ * @brief Write \a data, base64 encoded (standard alphabet, padded with '='),
+ *        into \a d_first
+ *
+ * @note Encodes 12/24 bytes at once with SSSE3/AVX2
+ *
+ * @param[in] data The bytes to encode
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ *
+ * @return One past the last char written. std::nullopt (nothing written) when
+ *         \a d_size is smaller than Base64EncodedSize(data.size()).
+ */
+inline auto StrBase64Encode(std::string_view data, char* d_first,
+                            std::size_t d_size) noexcept
+    -> std::optional<char*>;
+
+/**
+ * @brief Write \a base64 (standard alphabet, padded), decoded, into \a d_first
+ *
+ * @note Decodes 16/32 chars at once with SSSE3/AVX2
+ *
+ * @param[in] base64 The base64 chars to decode
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid char
+ *
+ * @return One past the last byte written. std::nullopt when \a base64 size
+ *         isn't a multiple of 4, contains an invalid char (the content of
+ *         \a d_first is then unspecified) or when \a d_size is too small
+ *         (nothing written).
+ */
+inline auto StrBase64Decode(std::string_view base64, char* d_first,
+                            std::size_t d_size,
+                            std::size_t* const d_where = nullptr) noexcept
+    -> std::optional<char*>;
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+/**
+ * @brief Hex encode the first bytes of \a data into \a d_first
+ * @return The number of bytes of \a data encoded
+ */
+ATB_SIMD_TARGET("ssse3")
+inline auto HexEncodeSsse3(std::string_view data, char* d_first) noexcept
+    -> std::size_t {
+  const __m128i digits = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kHexDigits.data()));
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+
+  std::size_t i = 0;
+  for (; (i + 16) <= data.size(); i += 16) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i));
+    const __m128i high = _mm_shuffle_epi8(
+        digits, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(input, nibble));
+
+    auto* out = reinterpret_cast<__m128i*>(d_first + (2 * i));
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(high, low));
+  }
+  return i;
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto HexEncodeAvx2(std::string_view data, char* d_first) noexcept
+    -> std::size_t {
+  const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kHexDigits.data())));
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+  std::size_t i = 0;
+  for (; (i + 32) <= data.size(); i += 32) {
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + i));
+    const __m256i high = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    const __m256i low =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(input, nibble));
+
+    // Unpacking is done per 128 bits lanes
+    const __m256i first = _mm256_unpacklo_epi8(high, low);
+    const __m256i second = _mm256_unpackhi_epi8(high, low);
+
+    auto* out = reinterpret_cast<__m256i*>(d_first + (2 * i));
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(out + 1,
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i + HexEncodeSsse3(data.substr(i), d_first + (2 * i));
+}
+
+/// @return The nibble values of the 16 hex digits of \a input (or a non zero
+///         \a invalid mask)
+ATB_SIMD_TARGET("ssse3")
+inline auto HexValuesSsse3(__m128i input, int& invalid) noexcept -> __m128i {
+  const __m128i lower = _mm_or_si128(input, _mm_set1_epi8(0x20));
+  const __m128i is_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), input));
+  const __m128i is_letter =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                    _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+
+  invalid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) ^ 0xFFFF;
+  return _mm_or_si128(
+      _mm_and_si128(is_digit, _mm_sub_epi8(input, _mm_set1_epi8('0'))),
+      _mm_and_si128(is_letter,
+                    _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+/**
+ * @brief Hex decode the first digits of \a hex into \a d_first, stopping
+ *        before the first block containing an invalid digit
+ * @return The number of digits of \a hex decoded
+ */
+ATB_SIMD_TARGET("ssse3")
+inline auto HexDecodeSsse3(std::string_view hex, char* d_first) noexcept
+    -> std::size_t {
+  // (high, low) pairs -> high * 16 + low, in 16 bits lanes
+  const __m128i merge = _mm_set1_epi16(0x0110);
+
+  std::size_t i = 0;
+  for (; (i + 32) <= hex.size(); i += 32) {
+    int invalid_a = 0;
+    int invalid_b = 0;
+    const __m128i a = HexValuesSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex.data() + i)),
+        invalid_a);
+    const __m128i b = HexValuesSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex.data() + i + 16)),
+        invalid_b);
+    if ((invalid_a | invalid_b) != 0) break;
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first + (i / 2)),
+                     _mm_packus_epi16(_mm_maddubs_epi16(a, merge),
+                                      _mm_maddubs_epi16(b, merge)));
+  }
+  return i;
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto HexValuesAvx2(__m256i input, std::uint32_t& invalid) noexcept
+    -> __m256i {
+  const __m256i lower = _mm256_or_si256(input, _mm256_set1_epi8(0x20));
+  const __m256i is_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), input));
+  const __m256i is_letter =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+
+  invalid = ~static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)));
+  return _mm256_or_si256(
+      _mm256_and_si256(is_digit, _mm256_sub_epi8(input, _mm256_set1_epi8('0'))),
+      _mm256_and_si256(is_letter,
+                       _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto HexDecodeAvx2(std::string_view hex, char* d_first) noexcept
+    -> std::size_t {
+  const __m256i merge = _mm256_set1_epi16(0x0110);
+
+  std::size_t i = 0;
+  for (; (i + 64) <= hex.size(); i += 64) {
+    std::uint32_t invalid_a = 0;
+    std::uint32_t invalid_b = 0;
+    const __m256i a = HexValuesAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex.data() + i)),
+        invalid_a);
+    const __m256i b = HexValuesAvx2(
+        _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(hex.data() + i + 32)),
+        invalid_b);
+    if ((invalid_a | invalid_b) != 0) break;
+
+    // Packing is done per 128 bits lanes: put the 64 bits blocks back in order
+    const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, merge),
+                                               _mm256_maddubs_epi16(b, merge));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first + (i / 2)),
+                        _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+  return i + HexDecodeSsse3(hex.substr(i), d_first + (i / 2));
+}
+
+/// @return The 6 bits indices of the 16 base64 chars encoding the 12 first
+///         bytes of \a input (Muła's multiply based reshuffle)
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64IndicesSsse3(__m128i input) noexcept -> __m128i {
+  input = _mm_shuffle_epi8(
+      input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003F03F0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+/// @return The base64 chars of the 6 bits \a indices
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64CharsSsse3(__m128i indices) noexcept -> __m128i {
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+  __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  offsets = _mm_or_si128(
+      offsets, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices),
+                             _mm_set1_epi8(13)));
+
+  const __m128i shifts = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shifts, offsets), indices);
+}
+
+/**
+ * @brief Base64 encode the first bytes of \a data (multiple of 3) into
+ *        \a d_first
+ * @return The number of bytes of \a data encoded
+ */
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64EncodeSsse3(std::string_view data, char* d_first) noexcept
+    -> std::size_t {
+  std::size_t i = 0;
+  for (; (i + 16) <= data.size(); i += 12) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first + ((i / 3) * 4)),
+                     Base64CharsSsse3(Base64IndicesSsse3(input)));
+  }
+  return i;
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Base64CharsAvx2(__m256i indices) noexcept -> __m256i {
+  __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  offsets = _mm256_or_si256(
+      offsets,
+      _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices),
+                       _mm256_set1_epi8(13)));
+
+  const __m256i shifts = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm256_add_epi8(_mm256_shuffle_epi8(shifts, offsets), indices);
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Base64EncodeAvx2(std::string_view data, char* d_first) noexcept
+    -> std::size_t {
+  const __m256i reshuffle = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,  //
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+  std::size_t i = 0;
+  for (; (i + 28) <= data.size(); i += 24) {
+    // 12 bytes in each 128 bits lane
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + i + 12)),
+        1);
+
+    input = _mm256_shuffle_epi8(input, reshuffle);
+    const __m256i t0 = _mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first + ((i / 3) * 4)),
+                        Base64CharsAvx2(_mm256_or_si256(t1, t3)));
+  }
+  return i + Base64EncodeSsse3(data.substr(i), d_first + ((i / 3) * 4));
+}
+
+/// @return The 6 bits values of the 16 base64 chars of \a input (or a non
+///         zero \a invalid mask)
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64ValuesSsse3(__m128i input, int& invalid) noexcept -> __m128i {
+  const __m128i lut_lo =
+      _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                    0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi =
+      _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+                    0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll =
+      _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+  const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask_2f);
+  const __m128i lo_nibbles = _mm_and_si128(input, mask_2f);
+  const __m128i classes = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo_nibbles),
+                                        _mm_shuffle_epi8(lut_hi, hi_nibbles));
+  invalid = _mm_movemask_epi8(_mm_cmpeq_epi8(classes, _mm_setzero_si128())) ^
+            0xFFFF;
+
+  const __m128i roll = _mm_shuffle_epi8(
+      lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(input, mask_2f), hi_nibbles));
+  return _mm_add_epi8(input, roll);
+}
+
+/// @return The 12 bytes decoded from the 16 6-bits \a values (in the first
+///         12 bytes)
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64PackSsse3(__m128i values) noexcept -> __m128i {
+  const __m128i merged_ab_bc =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i merged =
+      _mm_madd_epi16(merged_ab_bc, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                                13, 12, -1, -1, -1, -1));
+}
+
+/**
+ * @brief Base64 decode the first chars of \a base64 into \a d_first,
+ *        stopping before the first block containing an invalid char (or the
+ *        padding)
+ * @return The number of chars of \a base64 decoded
+ */
+ATB_SIMD_TARGET("ssse3")
+inline auto Base64DecodeSsse3(std::string_view base64, char* d_first) noexcept
+    -> std::size_t {
+  std::size_t i = 0;
+  // 16 bytes are written for 12 decoded: keep at least 16 chars after
+  for (; (i + 32) <= base64.size(); i += 16) {
+    int invalid = 0;
+    const __m128i values = Base64ValuesSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(base64.data() + i)),
+        invalid);
+    if (invalid != 0) break;
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d_first + ((i / 4) * 3)),
+                     Base64PackSsse3(values));
+  }
+  return i;
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Base64DecodeAvx2(std::string_view base64, char* d_first) noexcept
+    -> std::size_t {
+  const __m256i lut_lo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+      0x1B, 0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,  //
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+  const __m256i pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,  //
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  std::size_t i = 0;
+  // 32 bytes are written for 24 decoded: keep at least 32 chars after
+  for (; (i + 64) <= base64.size(); i += 32) {
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base64.data() + i));
+
+    const __m256i hi_nibbles =
+        _mm256_and_si256(_mm256_srli_epi32(input, 4), mask_2f);
+    const __m256i lo_nibbles = _mm256_and_si256(input, mask_2f);
+    const __m256i classes =
+        _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo_nibbles),
+                         _mm256_shuffle_epi8(lut_hi, hi_nibbles));
+    if (!_mm256_testz_si256(classes, classes)) break;
+
+    const __m256i roll = _mm256_shuffle_epi8(
+        lut_roll,
+        _mm256_add_epi8(_mm256_cmpeq_epi8(input, mask_2f), hi_nibbles));
+    const __m256i values = _mm256_add_epi8(input, roll);
+
+    const __m256i merged = _mm256_madd_epi16(
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+        _mm256_set1_epi32(0x00011000));
+    const __m256i bytes = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(merged, pack),
+        _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d_first + ((i / 4) * 3)),
+                        bytes);
+  }
+  return i + Base64DecodeSsse3(base64.substr(i), d_first + ((i / 4) * 3));
+}
+
+#endif  // ATB_SIMD_X86
+
+/// Signature of the kernels, returning the number of input chars processed
+using CodecKernel = std::size_t (*)(std::string_view, char*) noexcept;
+
+/**
+ * @return The best kernel available among \a avx2 and \a ssse3. nullptr if
+ *         none.
+ */
+inline auto SelectCodecKernel([[maybe_unused]] CodecKernel avx2,
+                              [[maybe_unused]] CodecKernel ssse3) noexcept
+    -> CodecKernel {
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return avx2;
+    case simd::Isa::kSsse3:
+      return ssse3;
+    case simd::Isa::kSse2:
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+  return nullptr;
+}
+
+}  // namespace details
+
+inline auto StrHexEncode(std::string_view data, char* d_first,
+                         std::size_t d_size) noexcept -> std::optional<char*> {
+  if (data.size() > (d_size / 2)) return std::nullopt;
+
+  std::size_t done = 0;
+#if ATB_SIMD_X86
+  if (const auto kernel = details::SelectCodecKernel(details::HexEncodeAvx2,
+                                                     details::HexEncodeSsse3);
+      kernel != nullptr) {
+    done = kernel(data, d_first);
+  }
+#endif
+
+  return StrHexEncodeScalar(data.substr(done), d_first + (2 * done),
+                            d_size - (2 * done));
+}
+
+inline auto StrHexDecode(std::string_view hex, char* d_first,
+                         std::size_t d_size,
+                         std::size_t* const d_where) noexcept
+    -> std::optional<char*> {
+  const auto size = HexDecodedSize(hex);
+  if (!size || (*size > d_size)) return std::nullopt;
+
+  std::size_t done = 0;
+#if ATB_SIMD_X86
+  if (const auto kernel = details::SelectCodecKernel(details::HexDecodeAvx2,
+                                                     details::HexDecodeSsse3);
+      kernel != nullptr) {
+    done = kernel(hex, d_first);
+  }
+#endif
+
+  const auto last = StrHexDecodeScalar(hex.substr(done), d_first + (done / 2),
+                                       d_size - (done / 2), d_where);
+  if (!last && (d_where != nullptr)) *d_where += done;
+  return last;
+}
+
+inline auto StrBase64Encode(std::string_view data, char* d_first,
+                            std::size_t d_size) noexcept
+    -> std::optional<char*> {
+  if (((data.size() + 2) / 3) > (d_size / 4)) return std::nullopt;
+
+  std::size_t done = 0;
+#if ATB_SIMD_X86
+  if (const auto kernel = details::SelectCodecKernel(
+          details::Base64EncodeAvx2, details::Base64EncodeSsse3);
+      kernel != nullptr) {
+    done = kernel(data, d_first);
+  }
+#endif
+
+  const std::size_t written = (done / 3) * 4;
+  return StrBase64EncodeScalar(data.substr(done), d_first + written,
+                               d_size - written);
+}
+
+inline auto StrBase64Decode(std::string_view base64, char* d_first,
+                            std::size_t d_size,
+                            std::size_t* const d_where) noexcept
+    -> std::optional<char*> {
+  const auto size = Base64DecodedSize(base64);
+  if (!size || (*size > d_size)) return std::nullopt;
+
+  std::size_t done = 0;
+#if ATB_SIMD_X86
+  if (const auto kernel = details::SelectCodecKernel(
+          details::Base64DecodeAvx2, details::Base64DecodeSsse3);
+      kernel != nullptr) {
+    done = kernel(base64, d_first);
+  }
+#endif
+
+  const std::size_t written = (done / 4) * 3;
+  const auto last = StrBase64DecodeScalar(
+      base64.substr(done), d_first + written, d_size - written, d_where);
+  if (!last && (d_where != nullptr)) *d_where += done;
+  return last;
+}
+
+// APPEND //////////////////////////////////////////////////////////////////////
+
+namespace details {
+
+/**
+ * @brief Append up to \a max_size bytes into \a d_str, using \a write, by
+ *        doing only one resize (shrunk to the size actually written)
+ *
+ * @return The number of bytes added. std::nullopt when it would overflow or
+ *         \a write failed (\a d_str is left untouched).
+ */
+template <class Write>
+auto StrAppendCodec(std::optional<std::size_t> max_size, std::string& d_str,
+                    Write&& write) -> std::optional<std::size_t> {
+  const std::size_t old_size = d_str.size();
+  if (!max_size || (*max_size > (d_str.max_size() - old_size))) {
+    return std::nullopt;
+  }
+
+  d_str.resize(old_size + *max_size);
+  const std::optional<char*> last = write(d_str.data() + old_size, *max_size);
+  if (!last) {
+    d_str.resize(old_size);
+    return std::nullopt;
+  }
+
+  const auto added =
+      static_cast<std::size_t>(*last - (d_str.data() + old_size));
+  d_str.resize(old_size + added);
+  return added;
+}
+
+/// @return \a size * \a factor / \a divisor (rounded up), std::nullopt on
+///         overflow
+constexpr auto ScaledSize(std::size_t size, std::size_t factor,
+                          std::size_t divisor) noexcept
+    -> std::optional<std::size_t> {
+  const std::size_t blocks =
+      (size / divisor) + (((size % divisor) != 0) ? 1 : 0);
+  if (blocks > (std::numeric_limits<std::size_t>::max() / factor)) {
+    return std::nullopt;
+  }
+  return blocks * factor;
+}
+
+}  // namespace details
+
+/**
+ * @brief Append \a data, hex encoded, at the end of \a d_str (one resize)
+ *
+ * @important \a data MUST NOT reference \a d_str
+ *
+ * @return The number of chars added. std::nullopt if it would overflow.
+ */
+inline auto StrAppendHex(std::string_view data, std::string& d_str)
+    -> std::optional<std::size_t> {
+  return details::StrAppendCodec(
+      details::ScaledSize(data.size(), 2, 1), d_str,
+      [&](char* d_first, std::size_t d_size) {
+        return StrHexEncode(data, d_first, d_size);
+      });
+}
+
+/**
+ * @brief Append \a hex, decoded, at the end of \a d_str (one resize)
+ *
+ * @important \a hex MUST NOT reference \a d_str
+ *
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid digit
+ *
+ * @return The number of bytes added. std::nullopt when \a hex isn't valid
+ *         (\a d_str is left untouched).
+ */
+inline auto StrAppendHexDecoded(std::string_view hex, std::string& d_str,
+                                std::size_t* const d_where = nullptr)
+    -> std::optional<std::size_t> {
+  return details::StrAppendCodec(
+      HexDecodedSize(hex), d_str, [&](char* d_first, std::size_t d_size) {
+        return StrHexDecode(hex, d_first, d_size, d_where);
+      });
+}
+
+/**
+ * @brief Append \a data, base64 encoded, at the end of \a d_str (one resize)
+ *
+ * @important \a data MUST NOT reference \a d_str
+ *
+ * @return The number of chars added. std::nullopt if it would overflow.
+ */
+inline auto StrAppendBase64(std::string_view data, std::string& d_str)
+    -> std::optional<std::size_t> {
+  return details::StrAppendCodec(
+      details::ScaledSize(data.size(), 4, 3), d_str,
+      [&](char* d_first, std::size_t d_size) {
+        return StrBase64Encode(data, d_first, d_size);
+      });
+}
+
+/**
+ * @brief Append \a base64, decoded, at the end of \a d_str (one resize)
+ *
+ * @important \a base64 MUST NOT reference \a d_str
+ *
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid char
+ *
+ * @return The number of bytes added. std::nullopt when \a base64 isn't valid
+ *         (\a d_str is left untouched).
+ */
+inline auto StrAppendBase64Decoded(std::string_view base64, std::string& d_str,
+                                   std::size_t* const d_where = nullptr)
+    -> std::optional<std::size_t> {
+  return details::StrAppendCodec(
+      Base64DecodedSize(base64), d_str, [&](char* d_first, std::size_t d_size) {
+        return StrBase64Decode(base64, d_first, d_size, d_where);
+      });
+}
+
+// ESCAPING ////////////////////////////////////////////////////////////////////
+
+namespace details {
+
+/// @return true when \a c must be escaped inside a JSON string
+constexpr auto JsonNeedsEscape(char c) noexcept -> bool {
+  return (ToByte(c) < 0x20) || (c == '"') || (c == '\\');
+}
+
+/// @return The index of the first char to escape in \a str, from \a pos
+constexpr auto JsonFindScalar(std::string_view str, std::size_t pos) noexcept
+    -> std::size_t {
+  while ((pos < str.size()) && !JsonNeedsEscape(str[pos])) ++pos;
+  return pos;
+}
+
+/// @return The size of the JSON escape sequence of \a c
+constexpr auto JsonEscapeSequenceSize(char c) noexcept -> std::size_t {
+  switch (c) {
+    case '"':
+    case '\\':
+    case '\b':
+    case '\f':
+    case '\n':
+    case '\r':
+    case '\t':
+      return 2;
+    default:
+      return 6;  // \u00XX
+  }
+}
+
+/// @brief Write the JSON escape sequence of \a c into \a d_first
+/// @return One past the last char written
+constexpr auto JsonEscape(char c, char* d_first) noexcept -> char* {
+  *d_first++ = '\\';
+  switch (c) {
+    case '"':
+    case '\\':
+      *d_first++ = c;
+      break;
+    case '\b':
+      *d_first++ = 'b';
+      break;
+    case '\f':
+      *d_first++ = 'f';
+      break;
+    case '\n':
+      *d_first++ = 'n';
+      break;
+    case '\r':
+      *d_first++ = 'r';
+      break;
+    case '\t':
+      *d_first++ = 't';
+      break;
+    default:
+      *d_first++ = 'u';
+      *d_first++ = '0';
+      *d_first++ = '0';
+      *d_first++ = kHexDigits[ToByte(c) >> 4];
+      *d_first++ = kHexDigits[ToByte(c) & 0x0Fu];
+      break;
+  }
+  return d_first;
+}
+
+/// @return true when a CSV field containing \a c must be quoted
+constexpr auto CsvNeedsQuotes(char c, char separator) noexcept -> bool {
+  return (c == separator) || (c == '"') || (c == '\n') || (c == '\r');
+}
+
+/**
+ * @return The index of the first char of \a str, from \a pos, requiring the
+ *         field to be quoted
+ */
+constexpr auto CsvFindScalar(std::string_view str, std::size_t pos,
+                             char separator) noexcept -> std::size_t {
+  while ((pos < str.size()) && !CsvNeedsQuotes(str[pos], separator)) ++pos;
+  return pos;
+}
+
+#if ATB_SIMD_X86
+
+ATB_SIMD_TARGET("sse2")
+inline auto JsonFindSse2(std::string_view str, std::size_t pos) noexcept
+    -> std::size_t {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1F);
+
+  for (; (pos + 16) <= str.size(); pos += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + pos));
+    const __m128i escaped = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(escaped));
+    if (mask != 0) return pos + simd::CountTrailingZeros(mask);
+  }
+  return JsonFindScalar(str, pos);
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto JsonFindAvx2(std::string_view str, std::size_t pos) noexcept
+    -> std::size_t {
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i control = _mm256_set1_epi8(0x1F);
+
+  for (; (pos + 32) <= str.size(); pos += 32) {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + pos));
+    const __m256i escaped = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                        _mm256_cmpeq_epi8(chunk, backslash)),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+
+    const auto mask =
+        static_cast<std::uint32_t>(_mm256_movemask_epi8(escaped));
+    if (mask != 0) return pos + simd::CountTrailingZeros(mask);
+  }
+  return JsonFindSse2(str, pos);
+}
+
+ATB_SIMD_TARGET("sse2")
+inline auto CsvFindSse2(std::string_view str, std::size_t pos,
+                        char separator) noexcept -> std::size_t {
+  const __m128i sep = _mm_set1_epi8(separator);
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i lf = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+
+  for (; (pos + 16) <= str.size(); pos += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + pos));
+    const __m128i quoted = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, sep), _mm_cmpeq_epi8(chunk, quote)),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(quoted));
+    if (mask != 0) return pos + simd::CountTrailingZeros(mask);
+  }
+  return CsvFindScalar(str, pos, separator);
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto CsvFindAvx2(std::string_view str, std::size_t pos,
+                        char separator) noexcept -> std::size_t {
+  const __m256i sep = _mm256_set1_epi8(separator);
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  const __m256i cr = _mm256_set1_epi8('\r');
+
+  for (; (pos + 32) <= str.size(); pos += 32) {
+    const __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + pos));
+    const __m256i quoted = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, sep),
+                        _mm256_cmpeq_epi8(chunk, quote)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf),
+                        _mm256_cmpeq_epi8(chunk, cr)));
+
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(quoted));
+    if (mask != 0) return pos + simd::CountTrailingZeros(mask);
+  }
+  return CsvFindSse2(str, pos, separator);
+}
+
+#endif  // ATB_SIMD_X86
+
+/// @return The index of the first char to escape in \a str, from \a pos
+inline auto JsonFind(std::string_view str, std::size_t pos) noexcept
+    -> std::size_t {
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return JsonFindAvx2(str, pos);
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      return JsonFindSse2(str, pos);
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+  return JsonFindScalar(str, pos);
+}
+
+/// @return The index of the first char of \a str, from \a pos, requiring the
+///         field to be quoted
+inline auto CsvFind(std::string_view str, std::size_t pos,
+                    char separator) noexcept -> std::size_t {
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return CsvFindAvx2(str, pos, separator);
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      return CsvFindSse2(str, pos, separator);
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+  return CsvFindScalar(str, pos, separator);
+}
+
+/**
+ * @return The size of \a str, JSON escaped, using \a find to skip the runs of
+ *         clean chars. std::nullopt if it would overflow.
+ */
+template <class Find>
+constexpr auto JsonEscapedSize(std::string_view str, Find find) noexcept
+    -> std::optional<std::size_t> {
+  std::size_t size = str.size();
+  for (std::size_t pos = find(str, 0); pos < str.size();
+       pos = find(str, pos + 1)) {
+    const std::size_t extra = JsonEscapeSequenceSize(str[pos]) - 1;
+    if (size > (std::numeric_limits<std::size_t>::max() - extra)) {
+      return std::nullopt;
+    }
+    size += extra;
+  }
+  return size;
+}
+
+/**
+ * @brief Copy the \a count chars at \a first into \a d_first
+ * @return One past the last char written
+ *
+ * @note A plain loop, since std::copy_n isn't constexpr in C++17 (optimizing
+ *       compilers turn it into a memmove() anyway)
+ */
+constexpr auto EscapeCopy(const char* first, std::size_t count,
+                          char* d_first) noexcept -> char* {
+  for (std::size_t i = 0; i < count; ++i) *d_first++ = first[i];
+  return d_first;
+}
+
+/**
+ * @brief Write \a str, JSON escaped, into \a d_first, bulk copying the runs of
+ *        clean chars found by \a find
+ * @return One past the last char written
+ */
+template <class Find>
+constexpr auto JsonEscapeUnsafe(std::string_view str, char* d_first,
+                                Find find) noexcept -> char* {
+  for (std::size_t pos = 0;;) {
+    const std::size_t next = find(str, pos);
+    d_first = EscapeCopy(str.data() + pos, next - pos, d_first);
+    if (next == str.size()) return d_first;
+
+    d_first = JsonEscape(str[next], d_first);
+    pos = next + 1;
+  }
+}
+
+/**
+ * @return The size of the CSV field \a str, quoted when needed, using \a find
+ *         to skip the runs of clean chars. std::nullopt if it would overflow.
+ */
+template <class Find>
+constexpr auto CsvEscapedSize(std::string_view str, char separator,
+                              Find find) noexcept
+    -> std::optional<std::size_t> {
+  std::size_t pos = find(str, 0, separator);
+  if (pos == str.size()) return str.size();
+
+  const std::size_t size = str.size();
+  std::size_t extra = 2;  // Surrounding quotes
+  for (; pos < str.size(); pos = find(str, pos + 1, separator)) {
+    if (str[pos] == '"') ++extra;
+  }
+
+  if (size > (std::numeric_limits<std::size_t>::max() - extra)) {
+    return std::nullopt;
+  }
+  return size + extra;
+}
+
+/**
+ * @brief Write the CSV field \a str, quoted when needed, into \a d_first,
+ *        bulk copying the runs of clean chars found by \a find
+ * @return One past the last char written
+ */
+template <class Find>
+constexpr auto CsvEscapeUnsafe(std::string_view str, char separator,
+                               char* d_first, Find find) noexcept -> char* {
+  std::size_t next = find(str, 0, separator);
+  const bool quoted = next != str.size();
+  if (quoted) *d_first++ = '"';
+
+  for (std::size_t pos = 0;;) {
+    d_first = EscapeCopy(str.data() + pos, next - pos, d_first);
+    if (next == str.size()) break;
+
+    if (str[next] == '"') *d_first++ = '"';
+    *d_first++ = str[next];
+    pos = next + 1;
+    next = find(str, pos, separator);
+  }
+
+  if (quoted) *d_first++ = '"';
+  return d_first;
+}
+
+/// Same as StrAppendCodec(), for an exactly known \a size
+template <class Write>
+auto StrAppendExact(std::optional<std::size_t> size, std::string& d_str,
+                    Write&& write) -> std::optional<std::size_t> {
+  const std::size_t old_size = d_str.size();
+  if (!size || (*size > (d_str.max_size() - old_size))) return std::nullopt;
+
+  d_str.resize(old_size + *size);
+  write(d_str.data() + old_size);
+  return size;
+}
+
+}  // namespace details
+
+/**
+ * @return The size of \a str once JSON escaped (see StrEscapeJson()).
+ *         std::nullopt if it would overflow.
+ */
+inline auto StrEscapedJsonSize(std::string_view str) noexcept
+    -> std::optional<std::size_t> {
+  return details::JsonEscapedSize(str, details::JsonFind);
+}
+
+/**
+ * @brief Scalar implementation of StrEscapeJson()
+ */
+constexpr auto StrEscapeJsonScalar(std::string_view str, char* d_first,
+                                   std::size_t d_size) noexcept
+    -> std::optional<char*> {
+  const auto size = details::JsonEscapedSize(str, details::JsonFindScalar);
+  if (!size || (*size > d_size)) return std::nullopt;
+  return details::JsonEscapeUnsafe(str, d_first, details::JsonFindScalar);
+}
+
+/**
+ * @brief Write \a str, escaped to be used as the content of a JSON string,
+ *        into \a d_first
+ *
+ * '"' and '\\' are backslash escaped, as well as control chars (using their
+ * short form \\n, \\t, ... when available, \\u00XX otherwise). All other
+ * bytes (UTF-8 included) are copied as is.
+ *
+ * @code{.cpp}
+ * char buffer[16];
+ * auto end = StrEscapeJson("say \"hi\"\n", buffer, sizeof(buffer));
+ * assert(std::string_view(buffer, *end - buffer) == R"(say \"hi\"\n)");
+ * @endcode
+ *
+ * @note Chars to escape are searched 16/32 bytes at once with SSE2/AVX2, and
+ *       runs of chars in between are copied in bulk
+ *
+ * @param[in] str The string to escape
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ *
+ * @return One past the last char written. std::nullopt (nothing written) when
+ *         \a d_size is smaller than StrEscapedJsonSize(str).
+ */
+inline auto StrEscapeJson(std::string_view str, char* d_first,
+                          std::size_t d_size) noexcept
+    -> std::optional<char*> {
+  const auto size = StrEscapedJsonSize(str);
+  if (!size || (*size > d_size)) return std::nullopt;
+  return details::JsonEscapeUnsafe(str, d_first, details::JsonFind);
+}
+
+/**
+ * @brief Append \a str, JSON escaped (see StrEscapeJson()), at the end of
+ *        \a d_str, by doing only one resize of the exact size
+ *
+ * @important \a str MUST NOT reference \a d_str
+ *
+ * @return The number of chars added. std::nullopt if it would overflow.
+ */
+inline auto StrAppendEscapedJson(std::string_view str, std::string& d_str)
+    -> std::optional<std::size_t> {
+  return details::StrAppendExact(
+      StrEscapedJsonSize(str), d_str, [&](char* d_first) {
+        details::JsonEscapeUnsafe(str, d_first, details::JsonFind);
+      });
+}
+
+/**
+ * @return The size of the CSV field \a str once escaped (see StrEscapeCsv()).
+ *         std::nullopt if it would overflow.
+ */
+inline auto StrEscapedCsvSize(std::string_view str,
+                              char separator = ',') noexcept
+    -> std::optional<std::size_t> {
+  return details::CsvEscapedSize(str, separator, details::CsvFind);
+}
+
+/**
+ * @brief Scalar implementation of StrEscapeCsv()
+ */
+constexpr auto StrEscapeCsvScalar(std::string_view str, char* d_first,
+                                  std::size_t d_size,
+                                  char separator = ',') noexcept
+    -> std::optional<char*> {
+  const auto size =
+      details::CsvEscapedSize(str, separator, details::CsvFindScalar);
+  if (!size || (*size > d_size)) return std::nullopt;
+  return details::CsvEscapeUnsafe(str, separator, d_first,
+                                  details::CsvFindScalar);
+}
+
+/**
+ * @brief Write \a str, escaped to be used as a CSV field (RFC 4180), into
+ *        \a d_first
+ *
+ * Fields containing the \a separator, '"', '\\n' or '\\r' are surrounded by
+ * '"', with their '"' doubled. Other fields are copied as is.
+ *
+ * @code{.cpp}
+ * char buffer[16];
+ * auto end = StrEscapeCsv("a,\"b\"", buffer, sizeof(buffer));
+ * assert(std::string_view(buffer, *end - buffer) == R"("a,""b""")");
+ * @endcode
+ *
+ * @note Chars to escape are searched 16/32 bytes at once with SSE2/AVX2, and
+ *       runs of chars in between are copied in bulk
+ *
+ * @param[in] str The field to escape
+ * @param[in] d_first The destination char buffer
+ * @param[in] d_size The destination char buffer size
+ * @param[in] separator The fields separator
+ *
+ * @return One past the last char written. std::nullopt (nothing written) when
+ *         \a d_size is smaller than StrEscapedCsvSize(str, separator).
+ */
+inline auto StrEscapeCsv(std::string_view str, char* d_first,
+                         std::size_t d_size, char separator = ',') noexcept
+    -> std::optional<char*> {
+  const auto size = StrEscapedCsvSize(str, separator);
+  if (!size || (*size > d_size)) return std::nullopt;
+  return details::CsvEscapeUnsafe(str, separator, d_first, details::CsvFind);
+}
+
+/**
+ * @brief Append the CSV field \a str, escaped (see StrEscapeCsv()), at the end
+ *        of \a d_str, by doing only one resize of the exact size
+ *
+ * @important \a str MUST NOT reference \a d_str
+ *
+ * @return The number of chars added. std::nullopt if it would overflow.
+ */
+inline auto StrAppendEscapedCsv(std::string_view str, std::string& d_str,
+                                char separator = ',')
+    -> std::optional<std::size_t> {
+  return details::StrAppendExact(
+      StrEscapedCsvSize(str, separator), d_str, [&](char* d_first) {
+        details::CsvEscapeUnsafe(str, separator, d_first, details::CsvFind);
+      });
+}
+
+}  // namespace atb
@@ -0,0 +1,714 @@
+#pragma once
+
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <cstdint>
+#include <cstring>     // std::memset
+#include <functional>  // std::equal_to
+#include <initializer_list>
+#include <iterator>  // std::forward_iterator_tag
+#include <limits>    // std::numeric_limits
+#include <memory>    // std::allocator
+#include <new>       // placement new
+#include <optional>
+#include <stdexcept>  // std::length_error, std::invalid_argument
+#include <tuple>      // std::piecewise_construct, std::forward_as_tuple
+#include <type_traits>
+#include <utility>  // std::pair, std::move, std::swap
+
+#include "atb-cpp/hash.hpp"
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+namespace details {
+
+/**
+ * Control byte of a slot:
+ * - Full slots store the 7 lowest bits of the hash of their key (H2), >= 0;
+ * - Empty/deleted (tombstone) slots use negative values.
+ */
+using HashCtrl = std::int8_t;
+
+constexpr HashCtrl kHashCtrlEmpty = -128;
+constexpr HashCtrl kHashCtrlDeleted = -2;
+
+/// Number of control bytes compared at once when probing
+constexpr std::size_t kHashGroupWidth = 16;
+
+/**
+ * @brief kHashGroupWidth consecutive control bytes, matched at once
+ *
+ * Each match returns a bit mask where the bit i is set when the control byte
+ * i of the group matches.
+ *
+ * @note Probing happens on every lookup: dispatching at runtime (see
+ *       simd::DetectedIsa()) would cost more than the comparisons
+ *       themselves. The SSE2 version is therefore selected at compile time,
+ *       SSE2 being part of the x86-64 baseline.
+ */
+class HashGroup final {
+ public:
+  explicit HashGroup(const HashCtrl* ctrl) noexcept
+#if ATB_SIMD_X86 && defined(__SSE2__)
+      : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {
+  }
+#else
+      : m_ctrl(ctrl) {
+  }
+#endif
+
+  /// @return The mask of the control bytes equal to \a h2
+  auto Match(HashCtrl h2) const noexcept -> std::uint32_t {
+#if ATB_SIMD_X86 && defined(__SSE2__)
+    return MoveMask(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(h2)));
+#else
+    return MatchIf([h2](HashCtrl c) { return c == h2; });
+#endif
+  }
+
+  /// @return The mask of the empty control bytes
+  auto MatchEmpty() const noexcept -> std::uint32_t {
+    return Match(kHashCtrlEmpty);
+  }
+
+  /// @return The mask of the empty or deleted control bytes
+  auto MatchEmptyOrDeleted() const noexcept -> std::uint32_t {
+#if ATB_SIMD_X86 && defined(__SSE2__)
+    // Empty/deleted are the only values < -1
+    return MoveMask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_ctrl));
+#else
+    return MatchIf([](HashCtrl c) { return c < -1; });
+#endif
+  }
+
+ private:
+#if ATB_SIMD_X86 && defined(__SSE2__)
+  static auto MoveMask(__m128i mask) noexcept -> std::uint32_t {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(mask));
+  }
+
+  __m128i m_ctrl;
+#else
+  template <class Pred>
+  auto MatchIf(Pred&& pred) const noexcept -> std::uint32_t {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kHashGroupWidth; ++i) {
+      if (pred(m_ctrl[i])) mask |= (1u << i);
+    }
+    return mask;
+  }
+
+  const HashCtrl* m_ctrl;
+#endif
+};
+
+template <class T>
+constexpr auto HashIsNegative(T value) noexcept -> bool {
+  if constexpr (std::is_signed_v<T>) {
+    return value < 0;
+  } else {
+    static_cast<void>(value);
+    return false;
+  }
+}
+
+/**
+ * @return \a value converted to To, std::nullopt when To can't represent it
+ *         exactly (out of range, fractional part, sign change, NaN...)
+ */
+template <class To, class From>
+constexpr auto HashExactCast(From value) noexcept -> std::optional<To> {
+  if constexpr (std::is_floating_point_v<From> && std::is_integral_v<To>) {
+    // [min, max + 1), exactly representable (powers of 2). false when NaN.
+    constexpr auto kMin = static_cast<From>(std::numeric_limits<To>::min());
+    constexpr auto kEnd =
+        static_cast<From>((std::numeric_limits<To>::max() / 2) + 1) * 2;
+    if (!((value >= kMin) && (value < kEnd))) return std::nullopt;
+  } else if constexpr (std::is_floating_point_v<From> &&
+                       std::is_floating_point_v<To> &&
+                       (sizeof(To) < sizeof(From))) {
+    constexpr auto kMax = static_cast<From>(std::numeric_limits<To>::max());
+    if ((value > kMax) || (value < -kMax)) return std::nullopt;
+  }
+
+  const auto converted = static_cast<To>(value);
+  if constexpr (std::is_integral_v<From> && std::is_floating_point_v<To>) {
+    // Converting back may be out of range too
+    if (HashExactCast<From>(converted) != value) return std::nullopt;
+  } else if ((static_cast<From>(converted) != value) ||
+             (HashIsNegative(converted) != HashIsNegative(value))) {
+    return std::nullopt;
+  }
+  return converted;
+}
+
+/// Select the type of the key arguments accepted by lookups (see FlatHashMap)
+template <bool kTransparent>
+struct HashKeyArg {
+  template <class K, class Key>
+  using type = K;
+};
+
+template <>
+struct HashKeyArg<false> {
+  template <class K, class Key>
+  using type = Key;
+};
+
+template <class T, class = void>
+struct IsTransparent : std::false_type {};
+
+template <class T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type {};
+
+}  // namespace details
+
+/**
+ * @brief Open addressing hash map, storing its elements inline (Swiss table)
+ *
+ * The elements (std::pair<Key, Value>) are stored in a single flat array,
+ * along with an array of 1 byte per slot (the control bytes) storing the 7
+ * lowest bits of the hash of each key. A lookup:
+ * 1. Starts probing at the slot given by the highest bits of the hash;
+ * 2. Compares the 7 low bits against 16 control bytes at once (SSE2), only
+ *    comparing the keys of the candidates (false positive rate of 1/128);
+ * 3. Stops as soon as a group contains an empty slot, or jumps to the next
+ *    group (triangular probing).
+ *
+ * The table grows (doubles) when more than 7/8 of its slots are used.
+ *
+ * When both \a Hash and \a Eq are transparent (`is_transparent`, the default)
+ * lookups accept any type comparable to \a Key without building a \a Key
+ * (e.g. a std::string_view for std::string keys):
+ *
+ * @code{.cpp}
+ * FlatHashMap<std::string, int> ports{{"http", 80}, {"https", 443}};
+ *
+ * assert(*ports.Find("http"sv) == 80);  // No std::string built
+ * assert(ports.Find("ssh"sv) == nullptr);
+ *
+ * ports["ssh"] = 22;
+ * assert(ports.TryEmplace("ssh", 2222).second == false);
+ * assert(ports.Erase("http"));
+ * assert(ports.Size() == 2);
+ *
+ * for (auto& [name, port] : ports) { ... }
+ * @endcode
+ *
+ * @important Pointers/iterators are invalidated when the map grows (like
+ *            std::vector), and keys must NOT be modified through them
+ *
+ * @tparam Key Type of the keys
+ * @tparam Value Type of the values
+ * @tparam Hash Hash functor of the keys (defaults to Hasher)
+ * @tparam Eq Equality functor of the keys
+ */
+template <class Key, class Value, class Hash = Hasher,
+          class Eq = std::equal_to<>>
+class FlatHashMap final {
+  static constexpr bool kIsTransparent =
+      details::IsTransparent<Hash>::value && details::IsTransparent<Eq>::value;
+
+  /// true when K and Key are different arithmetic types
+  template <class K, class D = std::decay_t<K>>
+  static constexpr bool kArithmeticKey = std::is_arithmetic_v<D> &&
+                                         std::is_arithmetic_v<Key> &&
+                                         !std::is_same_v<D, Key>;
+
+  /// true when the lookup key K is converted to Key first: numbers of
+  /// different types may be equal (i.e. -1 and std::int64_t{-1}) but hash
+  /// differently. Not needed for integers hashed by Hasher.
+  template <class K, class D = std::decay_t<K>>
+  static constexpr bool kConvertKey =
+      kArithmeticKey<K> &&
+      !(std::is_same_v<Hash, Hasher> && std::is_integral_v<D> &&
+        std::is_integral_v<Key>);
+
+  /// Lookups argument type: K when transparent, Key otherwise
+  template <class K>
+  using KeyArg =
+      typename details::HashKeyArg<kIsTransparent>::template type<K, Key>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = std::size_t;
+
+  /// Forward iterator over the elements (in unspecified order)
+  template <class T>
+  class BasicIterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr BasicIterator() noexcept = default;
+
+    /// Conversion from iterator to const_iterator
+    template <class U, std::enable_if_t<std::is_same_v<const U, T> &&
+                                            !std::is_same_v<U, T>,
+                                        bool> = true>
+    constexpr BasicIterator(const BasicIterator<U>& other) noexcept
+        : m_ctrl(other.m_ctrl), m_slot(other.m_slot), m_end(other.m_end) {}
+
+    auto operator*() const noexcept -> reference { return *m_slot; }
+    auto operator->() const noexcept -> pointer { return m_slot; }
+
+    auto operator++() noexcept -> BasicIterator& {
+      ++m_ctrl;
+      ++m_slot;
+      SkipFree();
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> BasicIterator {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    friend auto operator==(const BasicIterator& lhs,
+                           const BasicIterator& rhs) noexcept -> bool {
+      return lhs.m_slot == rhs.m_slot;
+    }
+
+    friend auto operator!=(const BasicIterator& lhs,
+                           const BasicIterator& rhs) noexcept -> bool {
+      return lhs.m_slot != rhs.m_slot;
+    }
+
+   private:
+    friend class FlatHashMap;
+    template <class U>
+    friend class BasicIterator;
+
+    BasicIterator(const details::HashCtrl* ctrl, T* slot,
+                  const details::HashCtrl* end) noexcept
+        : m_ctrl(ctrl), m_slot(slot), m_end(end) {
+      SkipFree();
+    }
+
+    auto SkipFree() noexcept -> void {
+      while ((m_ctrl != m_end) && (*m_ctrl < 0)) {
+        ++m_ctrl;
+        ++m_slot;
+      }
+    }
+
+    const details::HashCtrl* m_ctrl = nullptr;
+    T* m_slot = nullptr;
+    const details::HashCtrl* m_end = nullptr;
+  };
+
+  using iterator = BasicIterator<value_type>;
+  using const_iterator = BasicIterator<const value_type>;
+
+  /// Default ctor: empty map, nothing allocated
+  FlatHashMap() noexcept(std::is_nothrow_default_constructible_v<Hash> &&
+                         std::is_nothrow_default_constructible_v<Eq>) =
+      default;
+
+  /// Construct an empty map, able to hold \a size elements without growing
+  explicit FlatHashMap(std::size_t size, const Hash& hash = Hash{},
+                       const Eq& eq = Eq{})
+      : m_hash(hash), m_eq(eq) {
+    Reserve(size);
+  }
+
+  /// Construct a map from \a elements (the first duplicated key wins)
+  FlatHashMap(std::initializer_list<value_type> elements,
+              const Hash& hash = Hash{}, const Eq& eq = Eq{})
+      : FlatHashMap(elements.size(), hash, eq) {
+    for (const auto& [key, value] : elements) TryEmplace(key, value);
+  }
+
+  FlatHashMap(const FlatHashMap& other)
+      : FlatHashMap(other.Size(), other.m_hash, other.m_eq) {
+    for (const auto& [key, value] : other) TryEmplace(key, value);
+  }
+
+  FlatHashMap(FlatHashMap&& other) noexcept
+      : m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+        m_slots(std::exchange(other.m_slots, nullptr)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_growth_left(std::exchange(other.m_growth_left, 0)),
+        m_hash(other.m_hash),
+        m_eq(other.m_eq) {}
+
+  auto operator=(const FlatHashMap& other) -> FlatHashMap& {
+    if (this != &other) {
+      FlatHashMap copy{other};
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  auto operator=(FlatHashMap&& other) noexcept -> FlatHashMap& {
+    if (this != &other) {
+      FlatHashMap moved{std::move(other)};
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  ~FlatHashMap() noexcept { Release(); }
+
+  /// Swap the content of this map with \a other
+  auto Swap(FlatHashMap& other) noexcept -> void {
+    using std::swap;
+    swap(m_ctrl, other.m_ctrl);
+    swap(m_slots, other.m_slots);
+    swap(m_capacity, other.m_capacity);
+    swap(m_size, other.m_size);
+    swap(m_growth_left, other.m_growth_left);
+    swap(m_hash, other.m_hash);
+    swap(m_eq, other.m_eq);
+  }
+
+  /// @return The number of elements stored
+  constexpr auto Size() const noexcept -> std::size_t { return m_size; }
+
+  /// @return true when no elements are stored
+  constexpr auto Empty() const noexcept -> bool { return m_size == 0; }
+
+  /// @return The number of slots allocated (0 or a power of 2)
+  constexpr auto Capacity() const noexcept -> std::size_t {
+    return m_capacity;
+  }
+
+  /**
+   * @brief Grow the table such that \a size elements can be stored without
+   *        growing again
+   *
+   * @throw std::length_error When \a size is too big
+   */
+  auto Reserve(std::size_t size) -> void {
+    if (size <= m_size + m_growth_left) return;
+    Resize(CapacityFor(size));
+  }
+
+  /// @brief Remove all elements (keeping the memory allocated)
+  auto Clear() noexcept -> void {
+    if (m_capacity == 0) return;
+    DestroySlots();
+    ResetCtrl();
+    m_size = 0;
+    m_growth_left = MaxLoad(m_capacity);
+  }
+
+  /**
+   * @return A pointer to the value associated to \a key, nullptr if not found
+   *
+   * @note Accepts any \a key type when the map is transparent (see class doc)
+   */
+  template <class K = Key>
+  auto Find(const KeyArg<K>& key) noexcept -> Value* {
+    const std::size_t i = FindIndex(key);
+    return i == kNotFound ? nullptr : &m_slots[i].second;
+  }
+
+  template <class K = Key>
+  auto Find(const KeyArg<K>& key) const noexcept -> const Value* {
+    const std::size_t i = FindIndex(key);
+    return i == kNotFound ? nullptr : &m_slots[i].second;
+  }
+
+  /// @return true when \a key is stored into the map
+  template <class K = Key>
+  auto Contains(const KeyArg<K>& key) const noexcept -> bool {
+    return FindIndex(key) != kNotFound;
+  }
+
+  /**
+   * @brief Insert an element constructed from \a key and \a args..., only
+   *        when \a key is not already stored
+   *
+   * When transparent, the Key is only constructed (from \a key) when the
+   * element is inserted.
+   *
+   * @return std::pair<Value*, bool> The value associated to \a key, and true
+   *         when it has been inserted
+   *
+   * @throw std::invalid_argument When \a key is a number that can't be
+   *                              represented exactly as a Key (i.e. 1.5 for
+   *                              an int)
+   */
+  template <class K = Key, class... Args>
+  auto TryEmplace(KeyArg<K>&& key, Args&&... args) -> std::pair<Value*, bool> {
+    if constexpr (kArithmeticKey<K>) {
+      return Emplace(ToKey(key), std::forward<Args>(args)...);
+    } else {
+      return Emplace(std::forward<KeyArg<K>>(key),
+                     std::forward<Args>(args)...);
+    }
+  }
+
+  template <class K = Key, class... Args>
+  auto TryEmplace(const KeyArg<K>& key, Args&&... args)
+      -> std::pair<Value*, bool> {
+    if constexpr (kArithmeticKey<K>) {
+      return Emplace(ToKey(key), std::forward<Args>(args)...);
+    } else {
+      return Emplace(key, std::forward<Args>(args)...);
+    }
+  }
+
+  /// @return The value associated to \a key, default constructed if missing
+  /// @throw std::invalid_argument See TryEmplace()
+  template <class K = Key>
+  auto operator[](KeyArg<K>&& key) -> Value& {
+    return *TryEmplace(std::forward<KeyArg<K>>(key)).first;
+  }
+
+  template <class K = Key>
+  auto operator[](const KeyArg<K>& key) -> Value& {
+    return *TryEmplace(key).first;
+  }
+
+  /// @return true when \a key was stored and has been removed
+  template <class K = Key>
+  auto Erase(const KeyArg<K>& key) -> bool {
+    const std::size_t i = FindIndex(key);
+    if (i == kNotFound) return false;
+    EraseAt(i);
+    return true;
+  }
+
+  auto begin() noexcept -> iterator {
+    return iterator{m_ctrl, m_slots, m_ctrl + m_capacity};
+  }
+  auto end() noexcept -> iterator {
+    return iterator{m_ctrl + m_capacity, m_slots + m_capacity,
+                    m_ctrl + m_capacity};
+  }
+  auto begin() const noexcept -> const_iterator {
+    return const_iterator{m_ctrl, m_slots, m_ctrl + m_capacity};
+  }
+  auto end() const noexcept -> const_iterator {
+    return const_iterator{m_ctrl + m_capacity, m_slots + m_capacity,
+                          m_ctrl + m_capacity};
+  }
+
+ private:
+  using SlotAllocator = std::allocator<value_type>;
+
+  static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+  static constexpr std::size_t kMinCapacity = details::kHashGroupWidth;
+
+  /// @return The number of elements that can be stored into \a capacity slots
+  static constexpr auto MaxLoad(std::size_t capacity) noexcept
+      -> std::size_t {
+    return capacity - (capacity / 8);
+  }
+
+  /// @return The smallest capacity able to store \a size elements
+  static auto CapacityFor(std::size_t size) -> std::size_t {
+    std::size_t capacity = kMinCapacity;
+    while (MaxLoad(capacity) < size) {
+      if (capacity > (static_cast<std::size_t>(-1) / 4)) {
+        throw std::length_error("FlatHashMap: Too many elements");
+      }
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  /// @return The control byte (H2) of \a hash
+  static constexpr auto H2(std::size_t hash) noexcept -> details::HashCtrl {
+    return static_cast<details::HashCtrl>(hash & 0x7F);
+  }
+
+  /// @return The first slot probed for \a hash (H1)
+  constexpr auto H1(std::size_t hash) const noexcept -> std::size_t {
+    return (hash >> 7) & (m_capacity - 1);
+  }
+
+  /// @throw std::invalid_argument When \a key can't be represented as a Key
+  template <class K>
+  static auto ToKey(const K& key) -> Key {
+    const std::optional<Key> converted = details::HashExactCast<Key>(key);
+    if (!converted) {
+      throw std::invalid_argument(
+          "FlatHashMap: the key can't be represented exactly as a Key");
+    }
+    return *converted;
+  }
+
+  template <class K>
+  auto FindIndex(const K& key) const noexcept -> std::size_t {
+    if constexpr (kConvertKey<K>) {
+      // Not representable as a Key: can't be equal to any of them
+      const std::optional<Key> converted = details::HashExactCast<Key>(key);
+      return converted ? FindIndex(*converted) : kNotFound;
+    } else {
+      return m_capacity == 0 ? kNotFound : FindIndex(key, m_hash(key));
+    }
+  }
+
+  /// @return The index of the slot storing \a key (whose hash is \a hash),
+  ///         kNotFound otherwise
+  template <class K>
+  auto FindIndex(const K& key, std::size_t hash) const noexcept
+      -> std::size_t {
+    if (m_capacity == 0) return kNotFound;
+
+    const auto h2 = H2(hash);
+    const std::size_t mask = m_capacity - 1;
+
+    std::size_t pos = H1(hash);
+    for (std::size_t step = details::kHashGroupWidth;;
+         step += details::kHashGroupWidth) {
+      const details::HashGroup group{m_ctrl + pos};
+      for (auto bits = group.Match(h2); bits != 0; bits &= (bits - 1)) {
+        const std::size_t i = (pos + simd::CountTrailingZeros(bits)) & mask;
+        if (m_eq(m_slots[i].first, key)) return i;
+      }
+      if (group.MatchEmpty() != 0) return kNotFound;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  /// @return The index of the first empty/deleted slot on the probing
+  ///         sequence of \a hash
+  auto FindFreeIndex(std::size_t hash) const noexcept -> std::size_t {
+    const std::size_t mask = m_capacity - 1;
+
+    std::size_t pos = H1(hash);
+    for (std::size_t step = details::kHashGroupWidth;;
+         step += details::kHashGroupWidth) {
+      const details::HashGroup group{m_ctrl + pos};
+      if (const auto bits = group.MatchEmptyOrDeleted(); bits != 0) {
+        return (pos + simd::CountTrailingZeros(bits)) & mask;
+      }
+      pos = (pos + step) & mask;
+    }
+  }
+
+  template <class K, class... Args>
+  auto Emplace(K&& key, Args&&... args) -> std::pair<Value*, bool> {
+    const std::size_t hash = m_hash(key);
+    if (const std::size_t i = FindIndex(key, hash); i != kNotFound) {
+      return {&m_slots[i].second, false};
+    }
+
+    std::size_t i = m_capacity == 0 ? kNotFound : FindFreeIndex(hash);
+    if ((i == kNotFound) ||
+        ((m_growth_left == 0) && (m_ctrl[i] == details::kHashCtrlEmpty))) {
+      // Too many tombstones: rehash in place, otherwise grow
+      Resize(m_size < (MaxLoad(m_capacity) / 2) ? m_capacity
+                                                : CapacityFor(m_size + 1));
+      i = FindFreeIndex(hash);
+    }
+
+    ::new (static_cast<void*>(m_slots + i))
+        value_type(std::piecewise_construct,
+                   std::forward_as_tuple(std::forward<K>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+
+    if (m_ctrl[i] == details::kHashCtrlEmpty) --m_growth_left;
+    SetCtrl(i, H2(hash));
+    ++m_size;
+    return {&m_slots[i].second, true};
+  }
+
+  auto EraseAt(std::size_t i) noexcept -> void {
+    m_slots[i].~value_type();
+    --m_size;
+
+    // The slot can be marked as empty (instead of deleted) when no probing
+    // sequence went through it: i.e. it never belonged to a full window of
+    // kHashGroupWidth slots
+    const std::size_t mask = m_capacity - 1;
+    const auto empty_before =
+        details::HashGroup{m_ctrl + ((i - details::kHashGroupWidth) & mask)}
+            .MatchEmpty();
+    const auto empty_after = details::HashGroup{m_ctrl + i}.MatchEmpty();
+
+    const bool was_never_full =
+        (empty_before != 0) && (empty_after != 0) &&
+        ((simd::CountTrailingZeros(empty_after) +
+          (details::kHashGroupWidth - 1 -
+           simd::HighestBitSet(empty_before))) < details::kHashGroupWidth);
+
+    if (was_never_full) {
+      SetCtrl(i, details::kHashCtrlEmpty);
+      ++m_growth_left;
+    } else {
+      SetCtrl(i, details::kHashCtrlDeleted);
+    }
+  }
+
+  /// @brief Set the control byte of the slot \a i (and its clone)
+  auto SetCtrl(std::size_t i, details::HashCtrl ctrl) noexcept -> void {
+    m_ctrl[i] = ctrl;
+    // The first kHashGroupWidth control bytes are cloned after the last one,
+    // such that groups can be loaded from any slot without wrapping around
+    if (i < details::kHashGroupWidth) m_ctrl[m_capacity + i] = ctrl;
+  }
+
+  auto ResetCtrl() noexcept -> void {
+    std::memset(m_ctrl, static_cast<unsigned char>(details::kHashCtrlEmpty),
+                m_capacity + details::kHashGroupWidth);
+  }
+
+  /// @brief Move all elements into a new table of \a capacity slots
+  auto Resize(std::size_t capacity) -> void {
+    FlatHashMap resized;
+    resized.m_ctrl = new details::HashCtrl[capacity + details::kHashGroupWidth];
+    try {
+      resized.m_slots = SlotAllocator{}.allocate(capacity);
+    } catch (...) {
+      delete[] resized.m_ctrl;
+      throw;
+    }
+    resized.m_capacity = capacity;
+    resized.m_growth_left = MaxLoad(capacity);
+    resized.ResetCtrl();
+
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+      if (m_ctrl[i] < 0) continue;
+
+      const std::size_t hash = m_hash(m_slots[i].first);
+      const std::size_t j = resized.FindFreeIndex(hash);
+      ::new (static_cast<void*>(resized.m_slots + j))
+          value_type(std::move(m_slots[i]));
+      resized.SetCtrl(j, H2(hash));
+      --resized.m_growth_left;
+      ++resized.m_size;
+    }
+
+    resized.m_hash = std::move(m_hash);
+    resized.m_eq = std::move(m_eq);
+    Swap(resized);
+  }
+
+  auto DestroySlots() noexcept -> void {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (std::size_t i = 0; i < m_capacity; ++i) {
+        if (m_ctrl[i] >= 0) m_slots[i].~value_type();
+      }
+    }
+  }
+
+  auto Release() noexcept -> void {
+    if (m_capacity == 0) return;
+    DestroySlots();
+    SlotAllocator{}.deallocate(m_slots, m_capacity);
+    delete[] m_ctrl;
+  }
+
+  details::HashCtrl* m_ctrl = nullptr; /*!< m_capacity + kHashGroupWidth */
+  value_type* m_slots = nullptr;       /*!< m_capacity slots */
+  std::size_t m_capacity = 0;          /*!< 0 or a power of 2 (>= 16) */
+  std::size_t m_size = 0;              /*!< Number of full slots */
+  std::size_t m_growth_left = 0;       /*!< Empty slots usable */
+  Hash m_hash;
+  Eq m_eq;
+};
+
+}  // namespace atb
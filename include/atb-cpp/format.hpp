@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>  // std::copy_n
+#include <array>
+#include <charconv>  // std::to_chars
+#include <cstddef>   // std::size_t
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace atb {
+
+/**
+ * @brief View of a string, or of the text representation of a number/char
+ *
+ * Numbers are formatted on construction (std::to_chars: locale independent,
+ * shortest round trip representation for floating points) into an inline
+ * buffer, hence a StrPiece never allocates. It is the argument type of the
+ * formatting functions (see Format()), which need the size of all pieces
+ * before writing anything.
+ *
+ * @code{.cpp}
+ * assert(StrPiece{42}.View() == "42");
+ * assert(StrPiece{-1.5}.View() == "-1.5");
+ * assert(StrPiece{'c'}.View() == "c");
+ * assert(StrPiece{true}.View() == "true");
+ * assert(StrPiece{"foo"}.View() == "foo");  // No copy
+ * @endcode
+ *
+ * @important Pieces of strings only VIEW them: the strings must outlive them
+ */
+class StrPiece final {
+ public:
+  /// Size of the inline buffer (big enough for any double/64 bits integer)
+  static constexpr std::size_t kBufferSize = 32;
+
+  StrPiece(std::string_view str) noexcept
+      : m_data(str.data()), m_size(str.size()) {}
+  StrPiece(const std::string& str) noexcept
+      : m_data(str.data()), m_size(str.size()) {}
+  StrPiece(const char* str) noexcept : StrPiece(std::string_view{str}) {}
+
+  StrPiece(char c) noexcept : m_size(1) { m_buffer[0] = c; }
+
+  StrPiece(bool value) noexcept
+      : StrPiece(value ? std::string_view{"true"} : std::string_view{"false"}) {
+  }
+
+  /// Integers and floating points
+  template <class T,
+            std::enable_if_t<std::is_arithmetic_v<T> &&
+                                 !std::is_same_v<T, bool> &&
+                                 !std::is_same_v<T, char>,
+                             bool> = true>
+  StrPiece(T value) noexcept {
+    const auto result =
+        std::to_chars(m_buffer.data(), m_buffer.data() + kBufferSize, value);
+    m_size = static_cast<std::size_t>(result.ptr - m_buffer.data());
+  }
+
+  /// StrPiece are views: copying one copies its buffer
+  StrPiece(const StrPiece&) noexcept = default;
+  auto operator=(const StrPiece&) noexcept -> StrPiece& = default;
+
+  /// @return The characters of the piece
+  auto View() const noexcept -> std::string_view {
+    return {m_data == nullptr ? m_buffer.data() : m_data, m_size};
+  }
+
+  /// @return The number of characters of the piece
+  auto Size() const noexcept -> std::size_t { return m_size; }
+
+  operator std::string_view() const noexcept { return View(); }
+
+ private:
+  const char* m_data = nullptr; /*!< Viewed string (nullptr: m_buffer) */
+  std::size_t m_size = 0;
+  std::array<char, kBufferSize> m_buffer; /*!< Formatted number/char */
+};
+
+namespace details {
+
+/// A literal segment of a format string, followed (or not) by an argument
+struct FormatItem {
+  std::string_view literal;
+  bool arg = false;
+};
+
+/// FormatScan() result on invalid format strings
+constexpr std::size_t kFormatInvalid = std::string_view::npos;
+
+/**
+ * @brief Split \a fmt into FormatItem (written into \a d_items, if not null)
+ *
+ * @return The number of items of \a fmt, kFormatInvalid when it contains a
+ *         single '{'/'}' not part of a '{}' placeholder
+ */
+constexpr auto FormatScan(std::string_view fmt, FormatItem* d_items) noexcept
+    -> std::size_t {
+  std::size_t count = 0;
+  const auto push = [&count, d_items](std::string_view literal, bool arg) {
+    if (d_items != nullptr) d_items[count] = FormatItem{literal, arg};
+    ++count;
+  };
+
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < fmt.size(); ++i) {
+    if ((fmt[i] != '{') && (fmt[i] != '}')) continue;
+
+    if (((i + 1) < fmt.size()) && (fmt[i + 1] == fmt[i])) {
+      // '{{' or '}}': keep the first one only
+      push(fmt.substr(start, i + 1 - start), false);
+    } else if ((fmt[i] == '{') && ((i + 1) < fmt.size()) &&
+               (fmt[i + 1] == '}')) {
+      push(fmt.substr(start, i - start), true);
+    } else {
+      return kFormatInvalid;
+    }
+
+    start = i + 2;
+    ++i;
+  }
+
+  if (start < fmt.size()) push(fmt.substr(start), false);
+  return count;
+}
+
+/// Format string \a Fmt (see ATB_FMT()), parsed at compile time
+template <class Fmt>
+struct FormatTraits {
+  static constexpr std::size_t kItemsCount =
+      FormatScan(Fmt::Value(), nullptr);
+  static_assert(kItemsCount != kFormatInvalid,
+                "Format: single '{' or '}' in the format string (use '{{' or "
+                "'}}' to write them)");
+
+  using Items =
+      std::array<FormatItem, kItemsCount == kFormatInvalid ? 0 : kItemsCount>;
+
+  static constexpr auto Parse() noexcept -> Items {
+    Items items = {};
+    FormatScan(Fmt::Value(), items.data());
+    return items;
+  }
+
+  static constexpr Items kItems = Parse();
+
+  static constexpr auto Count(bool args) noexcept -> std::size_t {
+    std::size_t count = 0;
+    for (const auto& item : kItems) {
+      count += args ? static_cast<std::size_t>(item.arg) : item.literal.size();
+    }
+    return count;
+  }
+
+  /// Number of '{}' placeholders
+  static constexpr std::size_t kArgsCount = Count(true);
+
+  /// Size of all literals
+  static constexpr std::size_t kLiteralsSize = Count(false);
+};
+
+/// @return The size of the formatted output, given its arguments \a pieces
+template <class Traits, std::size_t N>
+auto FormatSize(const std::array<StrPiece, N>& pieces) noexcept
+    -> std::size_t {
+  static_assert(Traits::kArgsCount == N,
+                "Format: the number of arguments doesn't match the number of "
+                "'{}' placeholders");
+
+  std::size_t size = Traits::kLiteralsSize;
+  for (const auto& piece : pieces) size += piece.Size();
+  return size;
+}
+
+/// @brief Write the formatted output into \a d_first (large enough)
+/// @return One past the last char written
+template <class Traits, std::size_t N>
+auto FormatWriteUnsafe(const std::array<StrPiece, N>& pieces,
+                       char* d_first) noexcept -> char* {
+  std::size_t arg = 0;
+  for (const auto& item : Traits::kItems) {
+    d_first = std::copy_n(item.literal.data(), item.literal.size(), d_first);
+    if (item.arg) {
+      const auto piece = pieces[arg++].View();
+      d_first = std::copy_n(piece.data(), piece.size(), d_first);
+    }
+  }
+  return d_first;
+}
+
+}  // namespace details
+
+/**
+ * @brief Wrap the string literal \a str into a format string type, parsed at
+ *        compile time by Format(), FormatTo(), ...
+ *
+ * Placeholders are '{}', replaced by the arguments in order. '{{' and '}}'
+ * write a single '{'/'}'. Invalid format strings, or a number of arguments not
+ * matching the number of placeholders, are compilation errors.
+ *
+ * @note C++17 doesn't allow string literals as template arguments (i.e.
+ *       Format<"{}">(...)): the literal is carried by the type of a local
+ *       class instead
+ */
+#define ATB_FMT(str)                                                 \
+  [] {                                                               \
+    struct AtbFormatString {                                         \
+      static constexpr auto Value() noexcept -> std::string_view {   \
+        return str;                                                  \
+      }                                                              \
+    };                                                               \
+    return AtbFormatString{};                                        \
+  }()
+
+/**
+ * @return The size of the output of Format(fmt, args...)
+ */
+template <class Fmt, class... Args>
+auto FormatSize(Fmt, const Args&... args) noexcept -> std::size_t {
+  return details::FormatSize<details::FormatTraits<Fmt>>(
+      std::array<StrPiece, sizeof...(Args)>{StrPiece(args)...});
+}
+
+/**
+ * @brief Write \a fmt, with its placeholders replaced by \a args, into the
+ *        buffer \a d_first of \a d_size chars
+ *
+ * @return One past the last char written. std::nullopt when the buffer is
+ *         too small (nothing is written)
+ */
+template <class Fmt, class... Args>
+auto FormatTo(Fmt, char* d_first, std::size_t d_size,
+              const Args&... args) noexcept -> std::optional<char*> {
+  using Traits = details::FormatTraits<Fmt>;
+  const std::array<StrPiece, sizeof...(Args)> pieces = {StrPiece(args)...};
+
+  if (details::FormatSize<Traits>(pieces) > d_size) return std::nullopt;
+  return details::FormatWriteUnsafe<Traits>(pieces, d_first);
+}
+
+/**
+ * @brief Append \a fmt, with its placeholders replaced by \a args, to \a d_str
+ *        with a single resize
+ *
+ * @important \a args must NOT view \a d_str
+ *
+ * @return The number of chars appended
+ */
+template <class Fmt, class... Args>
+auto FormatAppend(Fmt, std::string& d_str, const Args&... args)
+    -> std::size_t {
+  using Traits = details::FormatTraits<Fmt>;
+  const std::array<StrPiece, sizeof...(Args)> pieces = {StrPiece(args)...};
+
+  const std::size_t size = details::FormatSize<Traits>(pieces);
+  const std::size_t old_size = d_str.size();
+  d_str.resize(old_size + size);
+  details::FormatWriteUnsafe<Traits>(pieces, d_str.data() + old_size);
+  return size;
+}
+
+/**
+ * @return \a fmt, with its placeholders replaced by \a args
+ *
+ * Each argument is converted to a StrPiece (strings, chars, bools and
+ * numbers), the output size is computed from them and the compile time
+ * literals of \a fmt, and the output written with a single allocation.
+ *
+ * @code{.cpp}
+ * const std::string line = Format(ATB_FMT("req={} took={}us"), id, us);
+ * @endcode
+ */
+template <class Fmt, class... Args>
+auto Format(Fmt fmt, const Args&... args) -> std::string {
+  std::string str;
+  FormatAppend(fmt, str, args...);
+  return str;
+}
+
+}  // namespace atb
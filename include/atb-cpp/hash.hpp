@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <cstring>  // std::memcpy
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>  // std::pair
+
+#include "atb-cpp/tuple.hpp"
+
+namespace atb {
+
+namespace details {
+
+/// wyhash default secrets
+constexpr std::uint64_t kHashSecret[4] = {
+    0x2d358dccaa6c78a5u, 0x8bb84b93962eacc9u, 0x4b33a62ed433d4a3u,
+    0x4d5a2da51de1aa47u};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using HashUint128 = unsigned __int128;
+#endif
+
+/// @brief Set \a a and \a b to the low and high halves of their 128 bits
+///        product
+constexpr auto HashMul128(std::uint64_t& a, std::uint64_t& b) noexcept
+    -> void {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<HashUint128>(a) * b;
+  a = static_cast<std::uint64_t>(product);
+  b = static_cast<std::uint64_t>(product >> 64);
+#else
+  const std::uint64_t a_hi = a >> 32;
+  const std::uint64_t a_lo = a & 0xFFFFFFFFu;
+  const std::uint64_t b_hi = b >> 32;
+  const std::uint64_t b_lo = b & 0xFFFFFFFFu;
+
+  const std::uint64_t lo_lo = a_lo * b_lo;
+  const std::uint64_t hi_lo = a_hi * b_lo;
+  const std::uint64_t lo_hi = a_lo * b_hi;
+  const std::uint64_t cross =
+      (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + (lo_hi & 0xFFFFFFFFu);
+
+  a = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+  b = (a_hi * b_hi) + (hi_lo >> 32) + (lo_hi >> 32) + (cross >> 32);
+#endif
+}
+
+/// @return The 128 bits product of \a a by \a b, folded as (low ^ high)
+constexpr auto HashMum(std::uint64_t a, std::uint64_t b) noexcept
+    -> std::uint64_t {
+  HashMul128(a, b);
+  return a ^ b;
+}
+
+/// @return The hash \a hash narrowed to a std::size_t (folded if needed)
+constexpr auto HashToSize(std::uint64_t hash) noexcept -> std::size_t {
+#if SIZE_MAX < UINT64_MAX
+  return static_cast<std::size_t>(hash ^ (hash >> 32));
+#else
+  return hash;
+#endif
+}
+
+/// @return The 8 bytes at \a p, as a little endian integer
+inline auto HashRead8(const char* p) noexcept -> std::uint64_t {
+  std::uint64_t value = 0;
+  std::memcpy(&value, p, 8);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  value = __builtin_bswap64(value);
+#endif
+  return value;
+}
+
+/// @return The 4 bytes at \a p, as a little endian integer
+inline auto HashRead4(const char* p) noexcept -> std::uint64_t {
+  std::uint32_t value = 0;
+  std::memcpy(&value, p, 4);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  value = __builtin_bswap32(value);
+#endif
+  return value;
+}
+
+/// @return The 1 to 3 bytes at \a p (of size \a size) packed together
+inline auto HashRead3(const char* p, std::size_t size) noexcept
+    -> std::uint64_t {
+  const auto byte = [p](std::size_t i) -> std::uint64_t {
+    return static_cast<std::uint8_t>(p[i]);
+  };
+  return (byte(0) << 16) | (byte(size >> 1) << 8) | byte(size - 1);
+}
+
+}  // namespace details
+
+/**
+ * @brief Fast, non cryptographic, 64 bits hash of \a size bytes at \a data
+ *
+ * This is wyhash (final version 4): bytes are consumed 48 at once (3
+ * independent lanes) and mixed using 64x64 -> 128 bits multiplications.
+ *
+ * @important NOT suited against hash flooding attacks: use a random \a seed
+ *            when the keys are controlled by untrusted users
+ *
+ * @param[in] data The bytes to hash
+ * @param[in] size The number of bytes to hash
+ * @param[in] seed The seed of the hash
+ */
+inline auto Hash64(const void* data, std::size_t size,
+                   std::uint64_t seed = 0) noexcept -> std::uint64_t {
+  using details::HashMum;
+  using details::HashRead4;
+  using details::HashRead8;
+  using details::kHashSecret;
+
+  const char* p = static_cast<const char*>(data);
+  seed ^= HashMum(seed ^ kHashSecret[0], kHashSecret[1]);
+
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (size <= 16) {
+    if (size >= 4) {
+      const std::size_t middle = (size >> 3) << 2;
+      a = (HashRead4(p) << 32) | HashRead4(p + middle);
+      b = (HashRead4(p + size - 4) << 32) | HashRead4(p + size - 4 - middle);
+    } else if (size > 0) {
+      a = details::HashRead3(p, size);
+    }
+  } else {
+    std::size_t i = size;
+    if (i > 48) {
+      std::uint64_t see1 = seed;
+      std::uint64_t see2 = seed;
+      do {
+        seed = HashMum(HashRead8(p) ^ kHashSecret[1], HashRead8(p + 8) ^ seed);
+        see1 = HashMum(HashRead8(p + 16) ^ kHashSecret[2],
+                       HashRead8(p + 24) ^ see1);
+        see2 = HashMum(HashRead8(p + 32) ^ kHashSecret[3],
+                       HashRead8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = HashMum(HashRead8(p) ^ kHashSecret[1], HashRead8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = HashRead8(p + i - 16);
+    b = HashRead8(p + i - 8);
+  }
+
+  a ^= kHashSecret[1];
+  b ^= seed;
+  details::HashMul128(a, b);
+  return HashMum(a ^ kHashSecret[0] ^ size, b ^ kHashSecret[1]);
+}
+
+/// @return The hash of the bytes of \a str (see Hash64(data, size, seed))
+inline auto Hash64(std::string_view str, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t {
+  return Hash64(str.data(), str.size(), seed);
+}
+
+/// @return A well distributed 64 bits hash of the integer \a value
+constexpr auto HashMix(std::uint64_t value) noexcept -> std::uint64_t {
+  return details::HashMum(value ^ details::kHashSecret[0],
+                          value ^ details::kHashSecret[1]);
+}
+
+/// @return The hash of \a seed combined with the hash \a value (order matters)
+constexpr auto HashCombine(std::uint64_t seed, std::uint64_t value) noexcept
+    -> std::uint64_t {
+  return details::HashMum(seed ^ details::kHashSecret[2],
+                          value ^ details::kHashSecret[3]);
+}
+
+/**
+ * @brief Transparent hash functor, using Hash64() for strings, HashMix() for
+ *        integers and combining the hashes of each element of tuples/pairs
+ *
+ * Since it is transparent (`is_transparent`), and hashes all strings (i.e.
+ * std::string, std::string_view, const char*) through std::string_view, it
+ * allows heterogeneous lookups without building temporary std::string:
+ *
+ * @code{.cpp}
+ * std::unordered_set<std::string, Hasher, std::equal_to<>> names;
+ * names.insert("foo");
+ * assert(Hasher{}(std::string{"foo"}) == Hasher{}("foo"sv));
+ * @endcode
+ *
+ * @note std::unordered_* containers only support heterogeneous lookups from
+ *       C++20, see FlatHashMap (flat_hash_map.hpp)
+ */
+struct Hasher {
+  using is_transparent = void;
+
+  auto operator()(std::string_view str) const noexcept -> std::size_t {
+    return details::HashToSize(Hash64(str));
+  }
+
+  template <class T, std::enable_if_t<std::is_integral_v<T> ||
+                                          std::is_enum_v<T>,
+                                      bool> = true>
+  constexpr auto operator()(T value) const noexcept -> std::size_t {
+    if constexpr (std::is_enum_v<T>) {
+      return (*this)(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_signed_v<T>) {
+      // Sign extended: equal values hash the same, whatever their types
+      const std::int64_t wide = value;
+      return details::HashToSize(HashMix(static_cast<std::uint64_t>(wide)));
+    } else {
+      const std::uint64_t wide = value;
+      return details::HashToSize(HashMix(wide));
+    }
+  }
+
+  template <class... T>
+  auto operator()(const std::tuple<T...>& tpl) const noexcept -> std::size_t {
+    return HashElements(tpl);
+  }
+
+  template <class T, class U>
+  auto operator()(const std::pair<T, U>& pair) const noexcept -> std::size_t {
+    return HashElements(pair);
+  }
+
+ private:
+  template <class Tpl>
+  auto HashElements(const Tpl& tpl) const noexcept -> std::size_t {
+    return details::HashToSize(tpl::Reduce(
+        std::uint64_t{std::tuple_size_v<Tpl>},
+        [this](std::uint64_t seed, const auto& element) {
+          return HashCombine(seed, (*this)(element));
+        },
+        tpl));
+  }
+};
+
+}  // namespace atb
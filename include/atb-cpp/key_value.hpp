@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>  // std::min
+#include <array>
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <iterator>  // std::forward_iterator_tag
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/ascii.hpp"
+#include "atb-cpp/char_set.hpp"
+
+namespace atb {
+
+/// Syntax of the key/value pairs tokenized by StrKeyValues
+struct StrKeyValueFormat {
+  char pairs_separator = ';'; /*!< Between 2 pairs */
+  char key_separator = '=';   /*!< Between a key and its value */
+  char quote = '"';           /*!< Quotes values ('\0': no quoting) */
+  bool ignore_case = false;   /*!< Keys comparisons of Find()/Extract() */
+};
+
+/// Attributes like `k1=v1; k2="v 2"`
+constexpr StrKeyValueFormat kStrAttributesFormat{};
+
+/// HTTP like headers `Name: value\r\n` (values are NOT unquoted)
+constexpr StrKeyValueFormat kStrHeadersFormat{'\n', ':', '\0', true};
+
+/// A key/value pair, viewing the tokenized text
+struct StrKeyValue {
+  std::string_view key;   /*!< Trimmed key */
+  std::string_view value; /*!< Trimmed value, unquoted, escapes NOT decoded */
+  bool escaped = false;   /*!< true when value contains '\' escapes */
+
+  /**
+   * @return The value with its escapes decoded ('\x' gives 'x')
+   *
+   * @note This is the only operation allocating: only call it on the values
+   *       actually needed
+   */
+  auto Unescaped() const -> std::string {
+    if (!escaped) return std::string{value};
+
+    std::string unescaped;
+    unescaped.reserve(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      if ((value[i] == '\\') && ((i + 1) < value.size())) ++i;
+      unescaped.push_back(value[i]);
+    }
+    return unescaped;
+  }
+};
+
+/**
+ * @brief Zero copy tokenizer of key/value pairs (attributes, headers, ...)
+ *
+ * The text is lazily split into StrKeyValue while iterating, without any
+ * allocation: keys and values are std::string_view into the text. Given a
+ * StrKeyValueFormat:
+ * - Pairs are separated by `pairs_separator`, empty pairs are skipped;
+ * - The key ends at the first `key_separator` (pairs without it have an empty
+ *   value);
+ * - Keys and unquoted values are trimmed (spaces, tabs, '\r' and '\n');
+ * - Values starting with `quote` end at the next unescaped `quote` ('\\'
+ *   escapes the next char) and may contain separators. Anything between the
+ *   closing quote and the next pair is ignored. Unterminated quoted values end
+ *   with the text.
+ *
+ * The separators are searched using CharSet::Find() (16/32 chars at once with
+ * SSSE3/AVX2).
+ *
+ * @code{.cpp}
+ * for (const auto& [key, value, escaped] :
+ *      StrKeyValues{R"(k1=v1; k2="v;\"2\"")"}) {
+ *   // {"k1", "v1", false} then {"k2", R"(v;\"2\")", true}
+ * }
+ *
+ * // Lookup fast path: a single pass, stopping once all keys are found
+ * const auto [host, length] = StrKeyValues{request_headers, kStrHeadersFormat}
+ *                                 .Extract({"host", "content-length"});
+ * if (host) Connect(host->value);
+ * @endcode
+ *
+ * @important The text must outlive the tokenizer and the pairs returned
+ */
+class StrKeyValues final {
+ public:
+  /// Forward iterator over the pairs of the text
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = StrKeyValue;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const StrKeyValue*;
+    using reference = const StrKeyValue&;
+
+    constexpr Iterator() noexcept = default;
+
+    auto operator*() const noexcept -> reference { return m_current; }
+    auto operator->() const noexcept -> pointer { return &m_current; }
+
+    auto operator++() noexcept -> Iterator& {
+      if (!m_tokenizer->Next(m_next, m_current)) m_next = kEnd;
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> Iterator {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    friend auto operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        -> bool {
+      return lhs.m_next == rhs.m_next;
+    }
+
+    friend auto operator!=(const Iterator& lhs, const Iterator& rhs) noexcept
+        -> bool {
+      return lhs.m_next != rhs.m_next;
+    }
+
+   private:
+    friend class StrKeyValues;
+
+    static constexpr std::size_t kEnd = std::string_view::npos;
+
+    explicit Iterator(const StrKeyValues* tokenizer) noexcept
+        : m_tokenizer(tokenizer), m_next(0) {
+      ++(*this);
+    }
+
+    const StrKeyValues* m_tokenizer = nullptr;
+    std::size_t m_next = kEnd; /*!< Index after the current pair */
+    StrKeyValue m_current;
+  };
+
+  /**
+   * @brief Construct a tokenizer of the pairs of \a text
+   *
+   * @param[in] text The text to tokenize (NOT copied)
+   * @param[in] format The syntax of the pairs
+   */
+  constexpr explicit StrKeyValues(
+      std::string_view text,
+      const StrKeyValueFormat& format = kStrAttributesFormat) noexcept
+      : m_text(text), m_format(format) {
+    m_key_stops.Insert(format.key_separator).Insert(format.pairs_separator);
+    m_quoted_stops.Insert(format.quote).Insert('\\');
+  }
+
+  auto begin() const noexcept -> Iterator { return Iterator{this}; }
+  auto end() const noexcept -> Iterator { return Iterator{}; }
+
+  /// @return The first pair whose key is \a key, if any
+  auto Find(std::string_view key) const noexcept
+      -> std::optional<StrKeyValue> {
+    for (const auto& kv : *this) {
+      if (KeyEquals(kv.key, key)) return kv;
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @return The first pair of each of the \a keys (in the same order), if any
+   *
+   * Only one pass is made over the text, stopping as soon as all keys are
+   * found.
+   */
+  template <std::size_t N>
+  auto Extract(const std::string_view (&keys)[N]) const noexcept
+      -> std::array<std::optional<StrKeyValue>, N> {
+    std::array<std::optional<StrKeyValue>, N> found;
+    std::size_t missing = N;
+
+    for (auto it = begin(); (missing > 0) && (it != end()); ++it) {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (!found[i].has_value() && KeyEquals(it->key, keys[i])) {
+          found[i] = *it;
+          --missing;
+        }
+      }
+    }
+
+    return found;
+  }
+
+ private:
+  static constexpr auto IsSpace(char c) noexcept -> bool {
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+  }
+
+  static constexpr auto Trim(std::string_view str) noexcept
+      -> std::string_view {
+    while (!str.empty() && IsSpace(str.front())) str.remove_prefix(1);
+    while (!str.empty() && IsSpace(str.back())) str.remove_suffix(1);
+    return str;
+  }
+
+  auto KeyEquals(std::string_view lhs, std::string_view rhs) const noexcept
+      -> bool {
+    return m_format.ignore_case ? AsciiIEquals(lhs, rhs) : (lhs == rhs);
+  }
+
+  /// @brief Tokenize the next non empty pair, starting at \a pos, into \a kv
+  /// @return false when there isn't any pairs left
+  auto Next(std::size_t& pos, StrKeyValue& kv) const noexcept -> bool {
+    while (pos < m_text.size()) {
+      const std::size_t key_end = std::min(m_key_stops.Find(m_text, pos),
+                                           m_text.size());
+      kv.key = Trim(m_text.substr(pos, key_end - pos));
+      kv.value = {};
+      kv.escaped = false;
+
+      pos = key_end;
+      if ((pos < m_text.size()) &&
+          (m_text[pos] == m_format.key_separator)) {
+        NextValue(++pos, kv);
+      }
+
+      if (pos < m_text.size()) ++pos;  // pairs_separator
+      if (!kv.key.empty() || !kv.value.empty()) return true;
+    }
+    return false;
+  }
+
+  /// @brief Tokenize the value starting at \a pos, up to the next
+  ///        pairs_separator (set \a pos to it)
+  auto NextValue(std::size_t& pos, StrKeyValue& kv) const noexcept -> void {
+    while ((pos < m_text.size()) && IsSpace(m_text[pos])) ++pos;
+
+    const bool quoted = (m_format.quote != '\0') && (pos < m_text.size()) &&
+                        (m_text[pos] == m_format.quote);
+    if (quoted) {
+      const std::size_t first = ++pos;
+      for (pos = m_quoted_stops.Find(m_text, pos);
+           (pos < m_text.size()) && (m_text[pos] == '\\');
+           pos = m_quoted_stops.Find(m_text, pos + 2)) {
+        kv.escaped = true;
+        if ((pos + 2) >= m_text.size()) {
+          pos = m_text.size();
+          break;
+        }
+      }
+
+      pos = std::min(pos, m_text.size());
+      kv.value = m_text.substr(first, pos - first);
+    }
+
+    const std::size_t last =
+        std::min(m_text.find(m_format.pairs_separator, pos), m_text.size());
+    if (!quoted) kv.value = Trim(m_text.substr(pos, last - pos));
+    pos = last;
+  }
+
+  std::string_view m_text;
+  StrKeyValueFormat m_format;
+  CharSet m_key_stops;    /*!< key_separator/pairs_separator */
+  CharSet m_quoted_stops; /*!< quote/'\\' */
+};
+
+}  // namespace atb
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <exception>  // std::exception_ptr
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>  // std::exchange, std::forward
+#include <vector>
+
+#include "atb-cpp/matchers.hpp"
+#include "atb-cpp/scope_exit.hpp"
+#include "atb-cpp/simd.hpp"
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define ATB_LINE_SCANNER_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define ATB_LINE_SCANNER_MMAP 0
+#include <fstream>
+#include <iterator>  // std::istreambuf_iterator
+#endif
+
+namespace atb {
+
+/**
+ * @brief Read-only view of a whole file, memory mapped
+ *
+ * The content is exposed as a single std::string_view, without copying it:
+ * pages are loaded by the kernel on access (the mapping is advised as
+ * sequential).
+ *
+ * @code{.cpp}
+ * MappedFile file("/var/log/syslog");
+ * StrForEachMatchingLine(file.View(), StrContains("error"),
+ *                        [](std::string_view line) { Print(line); });
+ * @endcode
+ *
+ * @note Without mmap() (non POSIX platforms), the file is read into memory
+ *
+ * @important Views returned are only valid while the MappedFile lives
+ */
+class MappedFile final {
+ public:
+  /**
+   * @brief Map the whole file at \a path
+   *
+   * @throw std::system_error When the file can't be opened/mapped
+   */
+  explicit MappedFile(const std::string& path) {
+#if ATB_LINE_SCANNER_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) Throw("open", path);
+
+    struct stat infos = {};
+    if (::fstat(fd, &infos) != 0) {
+      const int error = errno;
+      ::close(fd);
+      Throw("fstat", path, error);
+    }
+
+    m_size = static_cast<std::size_t>(infos.st_size);
+    if (m_size > 0) {
+      void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        Throw("mmap", path, error);
+      }
+
+      ::madvise(data, m_size, MADV_SEQUENTIAL);
+      m_data = static_cast<const char*>(data);
+    }
+
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) Throw("open", path, ENOENT);
+
+    m_content.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    m_data = m_content.data();
+    m_size = m_content.size();
+#endif
+  }
+
+  /// Not copyable
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  /**
+   * @brief Movable
+   *
+   * @important With mmap(), views previously returned remain valid. Without
+   *            it, they may not (small contents are stored inline by
+   *            std::string)
+   */
+  MappedFile(MappedFile&& other) noexcept
+      : m_content(std::move(other.m_content)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)) {
+#if !ATB_LINE_SCANNER_MMAP
+    m_data = m_content.data();
+#endif
+  }
+
+  auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+      Unmap();
+      m_content = std::move(other.m_content);
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+#if !ATB_LINE_SCANNER_MMAP
+      m_data = m_content.data();
+#endif
+    }
+    return *this;
+  }
+
+  ~MappedFile() noexcept { Unmap(); }
+
+  /// @return The whole file content
+  auto View() const noexcept -> std::string_view { return {m_data, m_size}; }
+
+  /// @return The size of the file, in bytes
+  auto Size() const noexcept -> std::size_t { return m_size; }
+
+  /// @return true when the file is empty
+  auto Empty() const noexcept -> bool { return m_size == 0; }
+
+ private:
+  [[noreturn]] static auto Throw(const char* what, const std::string& path,
+                                 int error = errno) -> void {
+    throw std::system_error(error, std::generic_category(),
+                            std::string{what} + "(" + path + ")");
+  }
+
+  auto Unmap() noexcept -> void {
+#if ATB_LINE_SCANNER_MMAP
+    if (m_data != nullptr) {
+      ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  std::string m_content; /*!< Content read (when mmap() isn't available) */
+  const char* m_data = nullptr; /*!< First byte of the file */
+  std::size_t m_size = 0;       /*!< Size of the file */
+};
+
+/**
+ * @brief Scalar implementation of StrForEachLine()
+ */
+template <class F>
+auto StrForEachLineScalar(std::string_view text, F&& f) -> void {
+  std::size_t start = 0;
+  for (std::size_t end = text.find('\n'); end != std::string_view::npos;
+       end = text.find('\n', start)) {
+    f(text.substr(start, end - start));
+    start = end + 1;
+  }
+
+  if (start < text.size()) f(text.substr(start));
+}
+
+/**
+ * @brief Call \a f with each line of \a text, as a std::string_view into
+ *        \a text (without the '\n')
+ *
+ * The last line is reported even without a trailing '\n', unless it is empty.
+ *
+ * @note Newlines are searched 16/32 bytes at once (SSE2/AVX2): each block
+ *       gives a bit mask of its '\n', hence short lines don't pay a call to
+ *       memchr() each
+ *
+ * @param[in] text The text to split into lines
+ * @param[in] f Callable with a std::string_view (the line)
+ */
+template <class F>
+auto StrForEachLine(std::string_view text, F&& f) -> void;
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+/// @return The index after the last '\n' reported
+template <class F>
+ATB_SIMD_TARGET("sse2")
+auto StrForEachLineSse2(std::string_view text, F& f) -> std::size_t {
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  std::size_t start = 0;
+  std::size_t i = 0;
+  for (; (i + 16) <= text.size(); i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+    auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const std::size_t end = i + simd::CountTrailingZeros(mask);
+      f(text.substr(start, end - start));
+      start = end + 1;
+    }
+  }
+
+  return start;
+}
+
+/// @return The index after the last '\n' reported
+template <class F>
+ATB_SIMD_TARGET("avx2")
+auto StrForEachLineAvx2(std::string_view text, F& f) -> std::size_t {
+  const __m256i newline = _mm256_set1_epi8('\n');
+
+  std::size_t start = 0;
+  std::size_t i = 0;
+  for (; (i + 32) <= text.size(); i += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const std::size_t end = i + simd::CountTrailingZeros(mask);
+      f(text.substr(start, end - start));
+      start = end + 1;
+    }
+  }
+
+  return start;
+}
+
+#endif  // ATB_SIMD_X86
+
+}  // namespace details
+
+template <class F>
+auto StrForEachLine(std::string_view text, F&& f) -> void {
+  std::size_t start = 0;
+
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      start = details::StrForEachLineAvx2(text, f);
+      break;
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      start = details::StrForEachLineSse2(text, f);
+      break;
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+
+  // The remaining (unaligned) tail
+  StrForEachLineScalar(text.substr(start), f);
+}
+
+/**
+ * @brief Call \a f with each line of \a text matching \a matcher
+ *
+ * @code{.cpp}
+ * MappedFile file("app.log");
+ * std::size_t errors = StrForEachMatchingLine(
+ *     file.View(), StrContainsAnyOf({"ERROR", "FATAL"}),
+ *     [](std::string_view line) { Print(line); });
+ * @endcode
+ *
+ * @param[in] text The text to split into lines
+ * @param[in] matcher Any ::IsMatching compatible matcher, called with each
+ *                    line (std::string_view)
+ * @param[in] f Callable with a std::string_view (the matching line)
+ *
+ * @return The number of lines matching
+ */
+template <class Matcher, class F>
+auto StrForEachMatchingLine(std::string_view text, const Matcher& matcher,
+                            F&& f) -> std::size_t {
+  std::size_t count = 0;
+  StrForEachLine(text, [&](std::string_view line) {
+    if (::IsMatching(matcher, line)) {
+      f(line);
+      ++count;
+    }
+  });
+  return count;
+}
+
+/**
+ * @return \a text split into (at most) \a count chunks of similar sizes, each
+ *         one ending right after a '\n' (or at the end of \a text)
+ */
+inline auto StrLinesChunks(std::string_view text, std::size_t count)
+    -> std::vector<std::string_view> {
+  std::vector<std::string_view> chunks;
+  if (count == 0) count = 1;
+
+  const std::size_t chunk_size = (text.size() / count) + 1;
+  std::size_t start = 0;
+  while (start < text.size()) {
+    std::size_t end = text.size();
+    if ((text.size() - start) > chunk_size) {
+      end = text.find('\n', start + chunk_size - 1);
+      end = (end == std::string_view::npos) ? text.size() : (end + 1);
+    }
+
+    chunks.push_back(text.substr(start, end - start));
+    start = end;
+  }
+
+  return chunks;
+}
+
+/// Order in which matching lines are reported, when scanning in parallel
+enum class LinesOrder : std::uint8_t {
+  kOrdered,   /*!< Same order as in the text */
+  kUnordered, /*!< As soon as found (lower latency, less memory) */
+};
+
+/**
+ * @brief Same as StrForEachMatchingLine(), but scanning \a text using
+ *        \a threads_count threads, each one handling a newline aligned chunk
+ *
+ * - kOrdered: the first chunk is reported as it is scanned (by the calling
+ *   thread), the others collect their matching lines (views, no copies) and
+ *   are reported in order once done;
+ * - kUnordered: lines are reported as soon as they are found, from any of the
+ *   threads.
+ *
+ * In both cases, \a f is NEVER called concurrently.
+ *
+ * @param[in] text The text to split into lines
+ * @param[in] matcher Any ::IsMatching compatible matcher, called concurrently
+ *                    from all threads (MUST be thread safe)
+ * @param[in] f Callable with a std::string_view (the matching line)
+ * @param[in] threads_count The number of threads used (including the calling
+ *                          one)
+ * @param[in] order Order in which lines are given to \a f
+ *
+ * @return The number of lines matching
+ *
+ * @throw Any exception thrown by \a matcher or \a f (rethrown from the
+ *        calling thread, once all threads are done)
+ */
+template <class Matcher, class F>
+auto StrForEachMatchingLineParallel(std::string_view text,
+                                    const Matcher& matcher, F&& f,
+                                    std::size_t threads_count,
+                                    LinesOrder order = LinesOrder::kOrdered)
+    -> std::size_t {
+  const auto chunks = StrLinesChunks(text, threads_count);
+  if (chunks.size() <= 1) return StrForEachMatchingLine(text, matcher, f);
+
+  struct ChunkResult {
+    std::vector<std::string_view> lines; /*!< kOrdered only */
+    std::size_t count = 0;
+    std::exception_ptr error;
+  };
+  std::vector<ChunkResult> results(chunks.size());
+  std::mutex f_mutex;
+
+  const auto scan = [&](std::size_t i) noexcept {
+    auto& result = results[i];
+    try {
+      if ((order == LinesOrder::kOrdered) && (i != 0)) {
+        result.count = StrForEachMatchingLine(
+            chunks[i], matcher,
+            [&](std::string_view line) { result.lines.push_back(line); });
+      } else {
+        result.count = StrForEachMatchingLine(
+            chunks[i], matcher, [&](std::string_view line) {
+              std::lock_guard lock{f_mutex};
+              f(line);
+            });
+      }
+    } catch (...) {
+      result.error = std::current_exception();
+    }
+  };
+
+  // Threads already started are joined even when starting another one fails
+  std::vector<std::thread> threads;
+  ScopeExit join_threads{[&threads]() noexcept {
+    for (auto& thread : threads) thread.join();
+  }};
+  threads.reserve(chunks.size() - 1);
+  for (std::size_t i = 1; i < chunks.size(); ++i) threads.emplace_back(scan, i);
+  scan(0);
+  join_threads.Execute();
+
+  std::size_t count = 0;
+  for (auto& result : results) {
+    if (result.error) std::rethrow_exception(result.error);
+    for (auto line : result.lines) f(line);
+    count += result.count;
+  }
+  return count;
+}
+
+}  // namespace atb
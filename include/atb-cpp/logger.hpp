@@ -0,0 +1,348 @@
+#pragma once
+
+#if __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
+
+#include <algorithm>  // std::min
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <cstdint>
+#include <initializer_list>
+#include <memory>  // std::unique_ptr
+#include <stdexcept>  // std::invalid_argument
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "atb-cpp/format.hpp"
+#include "atb-cpp/string.hpp"
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace atb {
+
+/// What AsyncLogger producers do when the ring of records is full
+enum class LogOverflow : std::uint8_t {
+  kDrop,   /*!< Drop the record */
+  kBlock,  /*!< Wait (spinning/yielding) until a record is written */
+  kSample, /*!< Once 3/4 full, keep 1 record every sample_rate, drop others */
+};
+
+/// Options of an AsyncLogger
+struct LogOptions {
+  std::size_t capacity = 4096;   /*!< Records in the ring (power of 2) */
+  std::size_t record_size = 256; /*!< Longer records are truncated */
+  LogOverflow overflow = LogOverflow::kDrop;
+  std::size_t sample_rate = 8; /*!< 1 record kept every N (kSample) */
+  std::chrono::microseconds idle_sleep{100}; /*!< Writer sleep when idle */
+};
+
+namespace details {
+
+/// @return The buffer records are formatted into, pre-allocated per thread
+inline auto LogThreadBuffer() -> std::string& {
+  thread_local std::string buffer = [] {
+    std::string str;
+    str.reserve(4096);
+    return str;
+  }();
+  buffer.clear();
+  return buffer;
+}
+
+}  // namespace details
+
+/**
+ * @brief Asynchronous writer of log lines into a file descriptor
+ *
+ * Producers never make any syscall nor allocation (once their thread buffer
+ * is allocated):
+ * - Records are formatted (see Format()) into a pre-allocated per thread
+ *   buffer;
+ * - Then copied into a pre-allocated slot of a bounded lock-free ring (a
+ *   multi producers queue based on per slot sequence numbers).
+ *
+ * A background thread writes the records, in order, by batches of up to
+ * kBatchSize using a single `writev()` per batch, pointing at the slots
+ * directly (no intermediate copy).
+ *
+ * When the ring is full, the LogOverflow policy decides if records are
+ * dropped (counted by DroppedCount()) or if the producer waits.
+ *
+ * @code{.cpp}
+ * AsyncLogger logger{STDERR_FILENO};
+ *
+ * // On the request threads
+ * logger.Log(ATB_FMT("req={} status={} took={}us"), id, status, us);
+ * logger.Write({"event=", name, "\n"});
+ * @endcode
+ *
+ * @important The file descriptor is NOT owned: it must stay open until the
+ *            logger is destroyed
+ *
+ * @note Records longer than LogOptions::record_size are truncated (lines
+ *       written by Log() still end with '\n')
+ */
+class AsyncLogger final {
+ public:
+  /// Maximum number of records written by a single writev()
+  static constexpr std::size_t kBatchSize = 64;
+
+  /**
+   * @brief Construct a logger writing into \a fd, and start its writer thread
+   *
+   * @param[in] fd The file descriptor written into (NOT owned)
+   * @param[in] options Sizes of the ring and overflow policy
+   *
+   * @throw std::invalid_argument When the capacity isn't a power of 2, or the
+   *                              record size/sample rate is 0
+   */
+  explicit AsyncLogger(int fd, const LogOptions& options = {})
+      : m_fd(fd),
+        m_mask(options.capacity - 1),
+        m_record_size(options.record_size),
+        m_overflow(options.overflow),
+        m_sample_rate(options.sample_rate),
+        m_high_watermark(options.capacity - (options.capacity / 4)),
+        m_idle_sleep(options.idle_sleep) {
+    if ((options.capacity < 2) || ((options.capacity & m_mask) != 0)) {
+      throw std::invalid_argument(
+          "AsyncLogger: the capacity must be a power of 2");
+    }
+    if ((m_record_size == 0) || (m_sample_rate == 0)) {
+      throw std::invalid_argument(
+          "AsyncLogger: the record size and sample rate must not be 0");
+    }
+
+    m_slots = std::make_unique<Slot[]>(options.capacity);
+    for (std::size_t i = 0; i < options.capacity; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_data = std::make_unique<char[]>(options.capacity * m_record_size);
+
+    m_writer = std::thread([this] { Run(); });
+  }
+
+  /// Not copyable/movable (the writer thread references the logger)
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger(AsyncLogger&&) = delete;
+  auto operator=(const AsyncLogger&) -> AsyncLogger& = delete;
+  auto operator=(AsyncLogger&&) -> AsyncLogger& = delete;
+
+  /// Write all records logged, then stop the writer thread
+  ~AsyncLogger() noexcept {
+    m_stop.store(true, std::memory_order_release);
+    m_writer.join();
+  }
+
+  /**
+   * @brief Log a line: \a fmt, with its placeholders replaced by \a args (see
+   *        Format()), followed by '\n'
+   *
+   * @return true when the record is queued, false when dropped
+   */
+  template <class Fmt, class... Args>
+  auto Log(Fmt fmt, const Args&... args) -> bool {
+    std::string& record = details::LogThreadBuffer();
+    FormatAppend(fmt, record, args...);
+    record.push_back('\n');
+    return Push({record}, true);
+  }
+
+  /**
+   * @brief Log the concatenation of \a strings, as is (no '\n' added)
+   *
+   * @return true when the record is queued, false when dropped
+   */
+  auto Write(std::initializer_list<std::string_view> strings) noexcept
+      -> bool {
+    return Push(strings, false);
+  }
+
+  /// @brief Wait until all records logged before this call are written
+  auto Flush() const noexcept -> void {
+    const std::size_t target = m_head.load(std::memory_order_acquire);
+    while (m_written.load(std::memory_order_acquire) < target) {
+      std::this_thread::sleep_for(m_idle_sleep);
+    }
+  }
+
+  /// @return The number of records dropped (see LogOverflow)
+  auto DroppedCount() const noexcept -> std::size_t {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  /// @return The number of records lost because writev() failed
+  auto ErrorsCount() const noexcept -> std::size_t {
+    return m_errors.load(std::memory_order_relaxed);
+  }
+
+  /// @return The number of records the ring can hold
+  auto Capacity() const noexcept -> std::size_t { return m_mask + 1; }
+
+ private:
+  /// A record of the ring. Its sequence number is:
+  /// - pos when free, for the producer claiming the position pos;
+  /// - pos + 1 when the record at pos is ready to be written;
+  /// - pos + capacity once written (free for the next lap).
+  struct Slot {
+    std::atomic<std::size_t> sequence{0};
+    std::size_t size = 0;
+  };
+
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  auto Drop() noexcept -> bool {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// @brief Copy the concatenation of \a strings into a slot of the ring
+  /// @param[in] line The record must end with '\n', even when truncated
+  auto Push(std::initializer_list<std::string_view> strings,
+            bool line) noexcept -> bool {
+    // Written first: the head loaded after it can't be behind it
+    const std::size_t written = m_written.load(std::memory_order_acquire);
+    std::size_t pos = m_head.load(std::memory_order_relaxed);
+
+    if ((m_overflow == LogOverflow::kSample) &&
+        ((pos - written) >= m_high_watermark) &&
+        ((m_sampled.fetch_add(1, std::memory_order_relaxed) % m_sample_rate) !=
+         0)) {
+      return Drop();
+    }
+
+    Slot* slot = nullptr;
+    for (;;) {
+      slot = &m_slots[pos & m_mask];
+      const std::size_t sequence =
+          slot->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // Full: the slot still holds the record of the previous lap
+        if (m_overflow != LogOverflow::kBlock) return Drop();
+        std::this_thread::yield();
+        pos = m_head.load(std::memory_order_relaxed);
+      } else {
+        // Claimed by another producer
+        pos = m_head.load(std::memory_order_relaxed);
+      }
+    }
+
+    char* first = &m_data[(pos & m_mask) * m_record_size];
+    char* last = StrCopy(strings, first, m_record_size, true);
+    if (line && (last == (first + m_record_size)) && (last[-1] != '\n')) {
+      last[-1] = '\n';
+    }
+
+    slot->size = static_cast<std::size_t>(last - first);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Write the records of \a iov, handling partial writes
+  auto WriteAll(iovec* iov, std::size_t count) noexcept -> void {
+    while (count > 0) {
+      const ssize_t written = ::writev(m_fd, iov, static_cast<int>(count));
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN) {
+          std::this_thread::sleep_for(m_idle_sleep);
+          continue;
+        }
+        m_errors.fetch_add(count, std::memory_order_relaxed);
+        return;
+      }
+
+      auto remaining = static_cast<std::size_t>(written);
+      while ((count > 0) && (remaining >= iov->iov_len)) {
+        remaining -= iov->iov_len;
+        ++iov;
+        --count;
+      }
+      if (count > 0) {
+        iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+        iov->iov_len -= remaining;
+      }
+    }
+  }
+
+  /// Writer thread: write the records ready, by batches, until stopped
+  auto Run() noexcept -> void {
+    std::vector<iovec> iov(kBatchSize);
+    std::size_t tail = 0;
+    std::size_t idle = 0;
+
+    for (;;) {
+      std::size_t count = 0;
+      for (; count < kBatchSize; ++count) {
+        const std::size_t index = (tail + count) & m_mask;
+        if (m_slots[index].sequence.load(std::memory_order_acquire) !=
+            (tail + count + 1)) {
+          break;
+        }
+        iov[count].iov_base = &m_data[index * m_record_size];
+        iov[count].iov_len = m_slots[index].size;
+      }
+
+      if (count == 0) {
+        // Stop once every record claimed is written
+        if (m_stop.load(std::memory_order_acquire) &&
+            (m_head.load(std::memory_order_acquire) == tail)) {
+          break;
+        }
+
+        // Spin a bit (records often come in bursts), then sleep
+        if (++idle < 64) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(m_idle_sleep);
+        }
+        continue;
+      }
+
+      idle = 0;
+      WriteAll(iov.data(), count);
+      for (std::size_t i = 0; i < count; ++i, ++tail) {
+        m_slots[tail & m_mask].sequence.store(tail + Capacity(),
+                                              std::memory_order_release);
+      }
+      m_written.store(tail, std::memory_order_release);
+    }
+  }
+
+  int m_fd;
+  std::size_t m_mask;           /*!< Capacity - 1 */
+  std::size_t m_record_size;
+  LogOverflow m_overflow;
+  std::size_t m_sample_rate;
+  std::size_t m_high_watermark; /*!< Records queued before sampling */
+  std::chrono::microseconds m_idle_sleep;
+
+  std::unique_ptr<Slot[]> m_slots;
+  std::unique_ptr<char[]> m_data; /*!< Record i at i * m_record_size */
+
+  /// Next position claimed by producers
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_head{0};
+  /// Records written (or failed) by the writer thread
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_written{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> m_dropped{0};
+  std::atomic<std::size_t> m_sampled{0}; /*!< Records seen while sampling */
+  std::atomic<std::size_t> m_errors{0};
+  std::atomic<bool> m_stop{false};
+
+  std::thread m_writer;
+};
+
+}  // namespace atb
+
+#endif  // __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <charconv>  // std::from_chars
+#include <cstddef>   // std::size_t
+#include <cstdint>
+#include <cstring>  // std::memcpy
+#include <iterator>  // std::begin/end, std::distance
+#include <limits>    // std::numeric_limits
+#include <optional>
+#include <string_view>
+#include <system_error>  // std::errc
+#include <type_traits>
+#include <vector>
+
+// The SWAR fast path loads 8 digits at once into an integer, assuming a
+// little endian layout
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define ATB_NUMBER_SWAR 1
+#else
+#define ATB_NUMBER_SWAR 0
+#endif
+
+namespace atb {
+
+namespace details {
+
+/// @return true when all 8 bytes of \a chunk are ASCII digits
+constexpr auto SwarAllDigits(std::uint64_t chunk) noexcept -> bool {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0u) |
+          (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) ==
+         0x3333333333333333u;
+}
+
+/**
+ * @return The value of the 8 ASCII digits of \a chunk (first digit in the
+ *         lowest byte)
+ * @pre SwarAllDigits(chunk)
+ */
+constexpr auto SwarParse8Digits(std::uint64_t chunk) noexcept -> std::uint64_t {
+  chunk -= 0x3030303030303030u;
+  chunk = (chunk * 10) + (chunk >> 8);  // Pairs of digits, in 16 bits lanes
+  return (((chunk & 0x000000FF000000FFu) * (100 + (1000000ull << 32))) +
+          (((chunk >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32)))) >>
+         32;
+}
+
+/**
+ * @return The value of \a digits (between 8 and 16 ASCII digits), parsed 8
+ *         digits at once. std::nullopt if any char isn't a digit.
+ */
+inline auto SwarParseDigits(std::string_view digits) noexcept
+    -> std::optional<std::uint64_t> {
+  const std::size_t head = digits.size() - 8;
+
+  std::uint64_t high = 0;
+  std::memcpy(&high, digits.data(), 8);
+  std::uint64_t low = 0;
+  std::memcpy(&low, digits.data() + head, 8);
+
+  // Only keep the first 'head' digits of the first chunk, left padded with
+  // '0' (the chunks overlap when there are less than 16 digits)
+  if (head == 0) {
+    high = 0x3030303030303030u;
+  } else if (head < 8) {
+    const unsigned shift = static_cast<unsigned>(8 - head) * 8u;
+    high = (high << shift) | (0x3030303030303030u >> (64u - shift));
+  }
+
+  if (!SwarAllDigits(high) || !SwarAllDigits(low)) return std::nullopt;
+  return (SwarParse8Digits(high) * 100000000u) + SwarParse8Digits(low);
+}
+
+/// @return \a value converted to T (without warning when T is U)
+template <class T, class U>
+constexpr auto NarrowTo(U value) noexcept -> T {
+  if constexpr (std::is_same_v<T, U>) {
+    return value;
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+/**
+ * @return The integer T whose absolute value is \a magnitude. std::nullopt if
+ *         it doesn't fit into T.
+ * @pre magnitude < 2^63
+ */
+template <class T>
+constexpr auto IntegerFromMagnitude(std::uint64_t magnitude,
+                                    bool negative) noexcept
+    -> std::optional<T> {
+  if (!negative) {
+    if (magnitude > NarrowTo<std::uint64_t>(std::numeric_limits<T>::max())) {
+      return std::nullopt;
+    }
+    return NarrowTo<T>(magnitude);
+  }
+
+  const auto value = -static_cast<std::int64_t>(magnitude);
+  if (value < NarrowTo<std::int64_t>(std::numeric_limits<T>::min())) {
+    return std::nullopt;
+  }
+  return NarrowTo<T>(value);
+}
+
+}  // namespace details
+
+/**
+ * @brief Convert \a str into a number of type \p T
+ *
+ * Contrary to std::stoi & co, it doesn't need a std::string, doesn't throw and
+ * doesn't depend on the locale. It is built on std::from_chars, hence uses the
+ * same format (no leading spaces nor '+', no base prefix), but the WHOLE
+ * string must be consumed.
+ *
+ * Integers of 8 to 16 digits (ids, timestamps, ...) are parsed using a SWAR
+ * fast path, converting 8 digits at once with a few 64 bits multiplications.
+ *
+ * @code{.cpp}
+ * assert(StrToNumber<int>("-42") == -42);
+ * assert(StrToNumber<double>("1.5e3") == 1500.0);
+ * assert(!StrToNumber<int>("42 "));
+ * assert(!StrToNumber<std::uint8_t>("256"));  // Out of range
+ * @endcode
+ *
+ * @tparam T Any integer (but bool) or floating point type
+ *
+ * @return The number represented by \a str. std::nullopt when \a str isn't a
+ *         valid number or when it is out of T's range.
+ */
+template <class T>
+auto StrToNumber(std::string_view str) noexcept -> std::optional<T> {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "StrToNumber only converts integers and floating points");
+
+#if ATB_NUMBER_SWAR
+  if constexpr (std::is_integral_v<T>) {
+    const bool negative =
+        std::is_signed_v<T> && !str.empty() && (str.front() == '-');
+    const std::string_view digits = str.substr(negative ? 1 : 0);
+
+    if ((digits.size() >= 8) && (digits.size() <= 16)) {
+      const auto magnitude = details::SwarParseDigits(digits);
+      if (!magnitude) return std::nullopt;
+      return details::IntegerFromMagnitude<T>(*magnitude, negative);
+    }
+  }
+#endif
+
+  T value = {};
+  const char* const last = str.data() + str.size();
+  const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+  if ((ec != std::errc{}) || (ptr != last)) return std::nullopt;
+  return value;
+}
+
+/**
+ * @brief Convert all \a tokens into numbers of type \p T, written
+ *        contiguously into \a d_first
+ *
+ * @code{.cpp}
+ * std::vector<std::string_view> column = {"1", "22", "333"};
+ * std::array<int, 3> values;
+ * assert(StrToNumbers(column, values.data()) == values.data() + 3);
+ * @endcode
+ *
+ * @param[in] tokens Range of string-like tokens (i.e. the fields of a column
+ *                   obtained from a split)
+ * @param[in] d_first The destination array, big enough to hold all tokens
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid token
+ *
+ * @return One past the last number written when successfull. std::nullopt
+ *         when a token isn't a valid number (tokens before it are written).
+ */
+template <class T, class Range>
+auto StrToNumbers(const Range& tokens, T* d_first,
+                  std::size_t* const d_where = nullptr) noexcept
+    -> std::optional<T*> {
+  std::size_t i = 0;
+  for (const auto& token : tokens) {
+    const auto value = StrToNumber<T>(std::string_view{token});
+    if (!value) {
+      if (d_where != nullptr) *d_where = i;
+      return std::nullopt;
+    }
+
+    *d_first++ = *value;
+    ++i;
+  }
+
+  return d_first;
+}
+
+/**
+ * @brief Append all \a tokens, converted into numbers of type \p T, at the end
+ *        of \a d_values (doing only one resize)
+ *
+ * @param[in] tokens Range of string-like tokens
+ * @param[inout] d_values Destination vector we wish to append into
+ * @param[inout] d_where Optionally a pointer to an index that will be set to
+ *                       the index of the first invalid token
+ *
+ * @return The number of values added when successfull. std::nullopt when a
+ *         token isn't a valid number (\a d_values is left untouched).
+ */
+template <class T, class Range>
+auto StrToNumbers(const Range& tokens, std::vector<T>& d_values,
+                  std::size_t* const d_where = nullptr)
+    -> std::optional<std::size_t> {
+  const std::size_t old_size = d_values.size();
+  const auto added = static_cast<std::size_t>(
+      std::distance(std::begin(tokens), std::end(tokens)));
+  d_values.resize(old_size + added);
+
+  if (!StrToNumbers(tokens, d_values.data() + old_size, d_where)) {
+    d_values.resize(old_size);
+    return std::nullopt;
+  }
+
+  return added;
+}
+
+}  // namespace atb
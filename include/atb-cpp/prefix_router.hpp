@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>  // std::forward, std::move
+#include <vector>
+
+namespace atb {
+
+/**
+ * @brief Longest prefix matching router, based on a compressed radix trie
+ *
+ * Associates values to string prefixes and returns, for a given input, the
+ * value of the LONGEST prefix matching it (like IP or HTTP path routing). It
+ * replaces a chain of StrStartsWith matchers, for which the first-match order
+ * of StrSwitch can't express 'the longest wins', and only walks the input
+ * once.
+ *
+ * The trie is compressed (each edge holds a whole string label, nodes only
+ * exist where prefixes diverge or end), and stored in a contiguous vector of
+ * nodes. Each node keeps the first bytes of its children labels contiguously,
+ * hence selecting the next edge is a small linear scan.
+ *
+ * @code{.cpp}
+ * StrPrefixRouter<int> router;
+ * router.Insert("/api", 1).Insert("/api/v2", 2).Insert("/static", 3);
+ *
+ * std::size_t size = 0;
+ * assert(*router.LongestMatch("/api/v2/items", &size) == 2);
+ * assert(size == 7);
+ * assert(*router.LongestMatch("/api/v1/items") == 1);
+ * assert(router.LongestMatch("/home") == nullptr);
+ * @endcode
+ *
+ * @note Prefixes are copied into the router (they don't need to outlive it)
+ *
+ * @tparam R Type of the values associated to each prefix
+ */
+template <class R>
+class StrPrefixRouter final {
+ public:
+  /// Default ctor (no prefixes)
+  StrPrefixRouter() : m_nodes(1) {}
+
+  /**
+   * @brief Associate \a value to \a prefix (replacing the previous value, if
+   *        the prefix was already present)
+   */
+  template <class T>
+  auto Insert(std::string_view prefix, T&& value) -> StrPrefixRouter& {
+    std::uint32_t node = 0;
+
+    while (!prefix.empty()) {
+      const auto child = ChildOf(node, prefix.front());
+
+      if (child == kNone) {
+        // New leaf holding the remaining of the prefix
+        const auto leaf = NewNode(std::string{prefix});
+        AddChild(node, leaf);
+        node = leaf;
+        break;
+      }
+
+      const std::string_view label = m_nodes[child].label;
+      const std::size_t common = CommonPrefixSize(label, prefix);
+
+      if (common < label.size()) {
+        // Split the edge: node -> middle (label[0, common)) -> child
+        // (label is copied first: NewNode may reallocate the nodes)
+        const auto middle = NewNode(std::string{label.substr(0, common)});
+        ReplaceChild(node, child, middle);
+        m_nodes[child].label.erase(0, common);
+        AddChild(middle, child);
+      }
+
+      node = ChildOf(node, prefix.front());
+      prefix.remove_prefix(common);
+    }
+
+    if (m_nodes[node].value == kNone) {
+      m_nodes[node].value = static_cast<std::uint32_t>(m_values.size());
+      m_values.emplace_back(std::forward<T>(value));
+    } else {
+      m_values[m_nodes[node].value] = R(std::forward<T>(value));
+    }
+
+    return *this;
+  }
+
+  /**
+   * @return A pointer to the value associated to the LONGEST prefix of \a str
+   *         inserted in the router. nullptr when none are matching.
+   *
+   * @param[in] str The string we wish to route
+   * @param[inout] d_size Optionally a pointer to an index that will be set to
+   *                      the size of the prefix found
+   */
+  auto LongestMatch(std::string_view str,
+                    std::size_t* const d_size = nullptr) const noexcept
+      -> const R* {
+    std::uint32_t best = m_nodes[0].value;
+    std::size_t best_size = 0;
+
+    std::uint32_t node = 0;
+    std::size_t depth = 0;
+
+    while (depth < str.size()) {
+      node = ChildOf(node, str[depth]);
+      if (node == kNone) break;
+
+      const std::string_view label = m_nodes[node].label;
+      if (str.substr(depth, label.size()) != label) break;
+
+      depth += label.size();
+      if (m_nodes[node].value != kNone) {
+        best = m_nodes[node].value;
+        best_size = depth;
+      }
+    }
+
+    if (best == kNone) return nullptr;
+    if (d_size != nullptr) *d_size = best_size;
+    return &m_values[best];
+  }
+
+  /**
+   * @brief Mandatory matcher interface (see matchers.hpp)
+   *
+   * @return true whenever at least one prefix matches \a str
+   */
+  auto IsMatching(std::string_view str) const noexcept -> bool {
+    return LongestMatch(str) != nullptr;
+  }
+
+  /// @return The number of prefixes stored
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+ private:
+  static constexpr std::uint32_t kNone = static_cast<std::uint32_t>(-1);
+
+  struct Node {
+    std::string label;                   /*!< Label of the edge to this node */
+    std::string first_bytes;             /*!< First byte of each child label */
+    std::vector<std::uint32_t> children; /*!< Children nodes */
+    std::uint32_t value = kNone;         /*!< Index of the value (if any) */
+  };
+
+  static auto CommonPrefixSize(std::string_view a, std::string_view b) noexcept
+      -> std::size_t {
+    std::size_t i = 0;
+    while ((i < a.size()) && (i < b.size()) && (a[i] == b[i])) ++i;
+    return i;
+  }
+
+  auto ChildOf(std::uint32_t node, char c) const noexcept -> std::uint32_t {
+    const auto& n = m_nodes[node];
+    const auto i = n.first_bytes.find(c);
+    return (i == std::string::npos) ? kNone : n.children[i];
+  }
+
+  auto NewNode(std::string label) -> std::uint32_t {
+    m_nodes.emplace_back();
+    m_nodes.back().label = std::move(label);
+    return static_cast<std::uint32_t>(m_nodes.size() - 1);
+  }
+
+  auto AddChild(std::uint32_t node, std::uint32_t child) -> void {
+    m_nodes[node].first_bytes.push_back(m_nodes[child].label.front());
+    m_nodes[node].children.push_back(child);
+  }
+
+  auto ReplaceChild(std::uint32_t node, std::uint32_t old_child,
+                    std::uint32_t new_child) -> void {
+    for (auto& c : m_nodes[node].children) {
+      if (c == old_child) c = new_child;
+    }
+  }
+
+  std::vector<Node> m_nodes; /*!< Nodes, the root being the first one */
+  std::vector<R> m_values;   /*!< Values associated to each prefix */
+};
+
+}  // namespace atb
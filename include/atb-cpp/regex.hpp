@@ -0,0 +1,722 @@
+#pragma once
+
+#include <algorithm>  // std::sort
+#include <array>
+#include <bitset>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <limits>  // std::numeric_limits
+#include <map>
+#include <stdexcept>  // std::invalid_argument, std::length_error
+#include <string>
+#include <string_view>
+#include <utility>  // std::move
+#include <vector>
+
+namespace atb {
+
+namespace details {
+
+/// Set of bytes matched by a regex atom
+using RegexBytes = std::bitset<256>;
+
+/// @return The RegexBytes containing all bytes in [\a first, \a last]
+inline auto RegexRange(unsigned char first, unsigned char last) noexcept
+    -> RegexBytes {
+  RegexBytes bytes;
+  for (unsigned c = first; c <= last; ++c) bytes.set(c);
+  return bytes;
+}
+
+/**
+ * @brief Recursive descent parser building the syntax tree of a regex
+ *
+ * Grammar:
+ * @code
+ * alternate := concat ('|' concat)*
+ * concat    := repeat*
+ * repeat    := atom ('*' | '+' | '?' | '{m}' | '{m,}' | '{m,n}')*
+ * atom      := '(' alternate ')' | '(?:' alternate ')' | '[' class ']' | '.'
+ *            | '\' escape | byte
+ * @endcode
+ */
+class RegexParser final {
+ public:
+  /// Unbounded repetition
+  static constexpr std::size_t kUnbounded =
+      std::numeric_limits<std::size_t>::max();
+
+  /// Biggest repetition bound accepted ({m,n})
+  static constexpr std::size_t kMaxRepeat = 1000;
+
+  /// Node of the syntax tree
+  struct Node {
+    enum class Kind : std::uint8_t {
+      kEmpty,     /*!< Matches the empty string */
+      kBytes,     /*!< Matches a single byte of bytes */
+      kConcat,    /*!< Matches all children, in order */
+      kAlternate, /*!< Matches one of the children */
+      kRepeat,    /*!< Matches the child [min, max] times */
+    };
+
+    Kind kind = Kind::kEmpty;
+    RegexBytes bytes;
+    std::vector<std::size_t> children; /*!< Indices of the children nodes */
+    std::size_t min = 0;
+    std::size_t max = 0;
+  };
+
+  /// @throw std::invalid_argument When \a pattern isn't a valid regex
+  explicit RegexParser(std::string_view pattern) : m_pattern(pattern) {
+    m_root = ParseAlternate();
+    if (!AtEnd()) Fail("unbalanced ')'");
+  }
+
+  /// @return The index of the root node
+  auto Root() const noexcept -> std::size_t { return m_root; }
+
+  /// @return All nodes of the tree
+  auto Nodes() const noexcept -> const std::vector<Node>& { return m_nodes; }
+
+ private:
+  [[noreturn]] auto Fail(std::string_view what) const -> void {
+    throw std::invalid_argument("Regex: " + std::string(what) + " at " +
+                                std::to_string(m_pos) + " in '" +
+                                std::string(m_pattern) + "'");
+  }
+
+  auto AtEnd() const noexcept -> bool { return m_pos >= m_pattern.size(); }
+  auto Peek() const noexcept -> char { return m_pattern[m_pos]; }
+
+  auto Next() -> char {
+    if (AtEnd()) Fail("unexpected end of pattern");
+    return m_pattern[m_pos++];
+  }
+
+  auto Add(Node node) -> std::size_t {
+    m_nodes.push_back(std::move(node));
+    return m_nodes.size() - 1;
+  }
+
+  auto AddBytes(const RegexBytes& bytes) -> std::size_t {
+    Node node;
+    node.kind = Node::Kind::kBytes;
+    node.bytes = bytes;
+    return Add(std::move(node));
+  }
+
+  auto ParseAlternate() -> std::size_t {
+    std::vector<std::size_t> branches = {ParseConcat()};
+    while (!AtEnd() && (Peek() == '|')) {
+      ++m_pos;
+      branches.push_back(ParseConcat());
+    }
+    if (branches.size() == 1) return branches.front();
+
+    Node node;
+    node.kind = Node::Kind::kAlternate;
+    node.children = std::move(branches);
+    return Add(std::move(node));
+  }
+
+  auto ParseConcat() -> std::size_t {
+    std::vector<std::size_t> items;
+    while (!AtEnd() && (Peek() != '|') && (Peek() != ')')) {
+      items.push_back(ParseRepeat());
+    }
+    if (items.size() == 1) return items.front();
+
+    Node node;
+    node.kind = items.empty() ? Node::Kind::kEmpty : Node::Kind::kConcat;
+    node.children = std::move(items);
+    return Add(std::move(node));
+  }
+
+  auto ParseRepeat() -> std::size_t {
+    std::size_t atom = ParseAtom();
+    while (!AtEnd()) {
+      Node node;
+      node.kind = Node::Kind::kRepeat;
+      switch (Peek()) {
+        case '*':
+          node.min = 0;
+          node.max = kUnbounded;
+          break;
+        case '+':
+          node.min = 1;
+          node.max = kUnbounded;
+          break;
+        case '?':
+          node.min = 0;
+          node.max = 1;
+          break;
+        case '{':
+          ParseBounds(node.min, node.max);
+          break;
+        default:
+          return atom;
+      }
+      ++m_pos;
+      node.children = {atom};
+      atom = Add(std::move(node));
+    }
+    return atom;
+  }
+
+  /// Parse '{m}', '{m,}' or '{m,n}', leaving m_pos on the '}'
+  auto ParseBounds(std::size_t& min, std::size_t& max) -> void {
+    const auto number = [this]() -> std::size_t {
+      std::size_t value = 0;
+      const std::size_t first = ++m_pos;
+      while (!AtEnd() && (Peek() >= '0') && (Peek() <= '9')) {
+        value = (value * 10) + static_cast<std::size_t>(Peek() - '0');
+        if (value > kMaxRepeat) Fail("repetition too big");
+        ++m_pos;
+      }
+      if (m_pos == first) Fail("invalid repetition");
+      return value;
+    };
+
+    min = number();
+    max = min;
+    if (!AtEnd() && (Peek() == ',')) {
+      if (((m_pos + 1) < m_pattern.size()) && (m_pattern[m_pos + 1] == '}')) {
+        ++m_pos;
+        max = kUnbounded;
+      } else {
+        max = number();
+      }
+    }
+    if (AtEnd() || (Peek() != '}')) Fail("invalid repetition");
+    if (min > max) Fail("invalid repetition bounds");
+  }
+
+  auto ParseAtom() -> std::size_t {
+    const char c = Next();
+    switch (c) {
+      case '(': {
+        if (m_pattern.substr(m_pos, 2) == "?:") m_pos += 2;
+        const std::size_t inner = ParseAlternate();
+        if (AtEnd() || (Next() != ')')) Fail("missing ')'");
+        return inner;
+      }
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+        --m_pos;
+        Fail("nothing to repeat");
+      case '^':
+      case '$':
+        --m_pos;
+        Fail("anchors are not supported");
+      case '.':
+        return AddBytes(RegexBytes{}.set());
+      case '[':
+        return AddBytes(ParseClass());
+      case '\\':
+        return AddBytes(ParseEscape());
+      default: {
+        RegexBytes bytes;
+        bytes.set(static_cast<unsigned char>(c));
+        return AddBytes(bytes);
+      }
+    }
+  }
+
+  /// @return The bytes of the escape sequence following a '\'
+  auto ParseEscape() -> RegexBytes {
+    const char c = Next();
+    const auto digits = RegexRange('0', '9');
+    const auto word = digits | RegexRange('a', 'z') | RegexRange('A', 'Z') |
+                      RegexRange('_', '_');
+    RegexBytes spaces;
+    for (char s : {' ', '\t', '\n', '\r', '\f', '\v'}) {
+      spaces.set(static_cast<unsigned char>(s));
+    }
+
+    RegexBytes bytes;
+    switch (c) {
+      case 'd':
+        return digits;
+      case 'D':
+        return ~digits;
+      case 'w':
+        return word;
+      case 'W':
+        return ~word;
+      case 's':
+        return spaces;
+      case 'S':
+        return ~spaces;
+      case 'n':
+        return bytes.set('\n');
+      case 't':
+        return bytes.set('\t');
+      case 'r':
+        return bytes.set('\r');
+      case 'f':
+        return bytes.set('\f');
+      case 'v':
+        return bytes.set('\v');
+      default:
+        if (word.test(static_cast<unsigned char>(c))) {
+          --m_pos;
+          Fail("unknown escape");
+        }
+        return bytes.set(static_cast<unsigned char>(c));
+    }
+  }
+
+  /// @return The bytes of the class following a '['
+  auto ParseClass() -> RegexBytes {
+    const bool negated = !AtEnd() && (Peek() == '^');
+    if (negated) ++m_pos;
+
+    RegexBytes bytes;
+    for (bool first = true;; first = false) {
+      char c = Next();
+      if ((c == ']') && !first) break;
+
+      if (c == '\\') {
+        const RegexBytes escaped = ParseEscape();
+        if (escaped.count() != 1) {
+          bytes |= escaped;  // \d, \w, ...
+          continue;
+        }
+        for (unsigned b = 0; b < 256; ++b) {
+          if (escaped.test(b)) c = static_cast<char>(b);
+        }
+      }
+
+      // Range, unless the '-' is the last char of the class
+      if (((m_pos + 1) < m_pattern.size()) && (Peek() == '-') &&
+          (m_pattern[m_pos + 1] != ']')) {
+        ++m_pos;
+        char last = Next();
+        if (last == '\\') {
+          const RegexBytes escaped = ParseEscape();
+          if (escaped.count() != 1) Fail("invalid range");
+          for (unsigned b = 0; b < 256; ++b) {
+            if (escaped.test(b)) last = static_cast<char>(b);
+          }
+        }
+
+        const auto from = static_cast<unsigned char>(c);
+        const auto to = static_cast<unsigned char>(last);
+        if (from > to) Fail("invalid range");
+        bytes |= RegexRange(from, to);
+      } else {
+        bytes.set(static_cast<unsigned char>(c));
+      }
+    }
+
+    return negated ? ~bytes : bytes;
+  }
+
+  std::string_view m_pattern;
+  std::size_t m_pos = 0;
+  std::vector<Node> m_nodes;
+  std::size_t m_root = 0;
+};
+
+/// Thompson NFA of a regex (each state has at most one byte transition)
+struct RegexNfa {
+  /// Biggest number of states accepted
+  static constexpr std::size_t kMaxStates = 1 << 20;
+
+  struct State {
+    std::vector<std::size_t> epsilons; /*!< Epsilon transitions */
+    std::size_t bytes = kNone;         /*!< Index of the bytes transition */
+    std::size_t next = 0;              /*!< Target of the bytes transition */
+  };
+
+  static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+  std::vector<State> states;
+  std::vector<RegexBytes> bytes;
+  std::size_t start = 0;
+  std::size_t accept = 0;
+
+  /// @throw std::length_error When the NFA is too big
+  explicit RegexNfa(const RegexParser& parser) {
+    const auto [first, last] = Compile(parser.Nodes(), parser.Root());
+    start = first;
+    accept = last;
+  }
+
+  auto AddState() -> std::size_t {
+    if (states.size() >= kMaxStates) {
+      throw std::length_error("Regex: pattern too big");
+    }
+    states.emplace_back();
+    return states.size() - 1;
+  }
+
+  auto AddEpsilon(std::size_t from, std::size_t to) -> void {
+    states[from].epsilons.push_back(to);
+  }
+
+  /// @return The {start, end} states of \a node
+  auto Compile(const std::vector<RegexParser::Node>& nodes, std::size_t node)
+      -> std::pair<std::size_t, std::size_t> {
+    using Kind = RegexParser::Node::Kind;
+    const auto& n = nodes[node];
+
+    switch (n.kind) {
+      case Kind::kEmpty: {
+        const std::size_t state = AddState();
+        return {state, state};
+      }
+      case Kind::kBytes: {
+        const std::size_t first = AddState();
+        const std::size_t last = AddState();
+        states[first].bytes = bytes.size();
+        states[first].next = last;
+        bytes.push_back(n.bytes);
+        return {first, last};
+      }
+      case Kind::kConcat: {
+        auto [first, last] = Compile(nodes, n.children.front());
+        for (std::size_t i = 1; i < n.children.size(); ++i) {
+          const auto [child_first, child_last] = Compile(nodes, n.children[i]);
+          AddEpsilon(last, child_first);
+          last = child_last;
+        }
+        return {first, last};
+      }
+      case Kind::kAlternate: {
+        const std::size_t first = AddState();
+        const std::size_t last = AddState();
+        for (const std::size_t child : n.children) {
+          const auto [child_first, child_last] = Compile(nodes, child);
+          AddEpsilon(first, child_first);
+          AddEpsilon(child_last, last);
+        }
+        return {first, last};
+      }
+      case Kind::kRepeat: {
+        const std::size_t first = AddState();
+        std::size_t last = first;
+        for (std::size_t i = 0; i < n.min; ++i) {
+          const auto [child_first, child_last] =
+              Compile(nodes, n.children.front());
+          AddEpsilon(last, child_first);
+          last = child_last;
+        }
+
+        if (n.max == RegexParser::kUnbounded) {
+          const std::size_t loop = AddState();
+          const auto [child_first, child_last] =
+              Compile(nodes, n.children.front());
+          AddEpsilon(last, loop);
+          AddEpsilon(loop, child_first);
+          AddEpsilon(child_last, loop);
+          return {first, loop};
+        }
+
+        // Optional repetitions: each one can skip to the end
+        std::vector<std::size_t> exits;
+        for (std::size_t i = n.min; i < n.max; ++i) {
+          const auto [child_first, child_last] =
+              Compile(nodes, n.children.front());
+          exits.push_back(last);
+          AddEpsilon(last, child_first);
+          last = child_last;
+        }
+        const std::size_t end = AddState();
+        AddEpsilon(last, end);
+        for (const std::size_t exit : exits) AddEpsilon(exit, end);
+        return {first, end};
+      }
+    }
+    return {0, 0};
+  }
+};
+
+}  // namespace details
+
+/**
+ * @brief Small regex subset, compiled into a minimized DFA
+ *
+ * Supported syntax (byte oriented):
+ * - Literal bytes, '.' (any byte, '\\n' included);
+ * - Classes: '[abc]', '[a-z]', '[^a-z]', with the escapes below inside;
+ * - Escapes: '\\d', '\\D', '\\w', '\\W', '\\s', '\\S', '\\n', '\\t', '\\r',
+ *   '\\f', '\\v' and any escaped punctuation (i.e. '\\.');
+ * - Groups '(...)' (or '(?:...)', both are non capturing) and alternation '|';
+ * - Repetitions: '*', '+', '?', '{m}', '{m,}' and '{m,n}' (n <= 1000).
+ *
+ * There are neither captures, backreferences, lookarounds nor anchors: the
+ * matching is always anchored (kFullMatch) or unanchored (kSearch) depending on
+ * the Mode used.
+ *
+ * The pattern is compiled once:
+ * 1. Into a Thompson NFA;
+ * 2. The 256 bytes are split into classes of bytes that are never
+ *    distinguished by the pattern (i.e. all letters for "\\w+@\\w+");
+ * 3. The NFA is turned into a DFA (subset construction), over those classes;
+ * 4. The DFA is minimized (Moore's partition refinement) into a dense
+ *    transition table.
+ *
+ * Matching is then a single table lookup per byte: linear time, without any
+ * backtracking nor allocation. It can be used directly as a matcher (i.e.
+ * with StrSwitch, AnyOf, AnyMatcher, ...):
+ *
+ * @code{.cpp}
+ * const Regex version(R"(v\d+(\.\d+){0,2}(-rc\d+)?)");
+ * assert(::IsMatching(version, "v1.22.3-rc1"));
+ * assert(!::IsMatching(version, "v1.22.3.4"));
+ *
+ * const Regex error("error|fail(ed|ure)", Regex::Mode::kSearch);
+ * assert(::IsMatching(error, "request failed: timeout"));
+ * @endcode
+ *
+ * @note The pattern doesn't need to outlive the Regex
+ */
+class Regex final {
+ public:
+  /// How matching is anchored
+  enum class Mode : std::uint8_t {
+    kFullMatch, /*!< The WHOLE string must match */
+    kSearch,    /*!< The pattern can match anywhere in the string */
+  };
+
+  /// Biggest number of DFA states accepted
+  static constexpr std::size_t kMaxStates = 1 << 14;
+
+  /**
+   * @brief Compile \a pattern into a DFA
+   *
+   * @throw std::invalid_argument When \a pattern isn't a valid regex
+   * @throw std::length_error When the pattern is too big (more than
+   *        kMaxStates DFA states)
+   */
+  explicit Regex(std::string_view pattern, Mode mode = Mode::kFullMatch)
+      : m_mode(mode) {
+    const details::RegexParser parser(pattern);
+    details::RegexNfa nfa(parser);
+
+    if (m_mode == Mode::kSearch) {
+      // Unanchored: loop on any byte before the pattern
+      const std::size_t loop = nfa.AddState();
+      nfa.AddEpsilon(loop, nfa.start);
+      nfa.states[loop].bytes = nfa.bytes.size();
+      nfa.states[loop].next = loop;
+      nfa.bytes.push_back(details::RegexBytes{}.set());
+      nfa.start = loop;
+    }
+
+    Minimize(BuildDfa(nfa, BuildClasses(nfa)));
+  }
+
+  /// @return true when \a str matches the pattern (according to the Mode)
+  auto IsMatching(std::string_view str) const noexcept -> bool {
+    std::size_t state = m_start;
+    if (m_mode == Mode::kSearch) {
+      if (m_accepting[state] != 0) return true;
+      for (const char c : str) {
+        state = Next(state, c);
+        if (m_accepting[state] != 0) return true;
+      }
+      return false;
+    }
+
+    for (const char c : str) {
+      state = Next(state, c);
+      if (state == m_dead) return false;
+    }
+    return m_accepting[state] != 0;
+  }
+
+  /// @return The Mode used for matching
+  auto GetMode() const noexcept -> Mode { return m_mode; }
+
+  /// @return The number of states of the minimized DFA
+  auto StatesCount() const noexcept -> std::size_t {
+    return m_accepting.size();
+  }
+
+  /// @return The number of classes of bytes
+  auto ClassesCount() const noexcept -> std::size_t { return m_classes_count; }
+
+ private:
+  using StateId = std::uint16_t;
+  static_assert(kMaxStates <= std::numeric_limits<StateId>::max());
+
+  /// Unminimized DFA
+  struct Dfa {
+    std::vector<StateId> transitions;
+    std::vector<std::uint8_t> accepting;
+    StateId start = 0;
+  };
+
+  auto Next(std::size_t state, char c) const noexcept -> std::size_t {
+    return m_transitions[(state * m_classes_count) +
+                         m_classes[static_cast<std::uint8_t>(c)]];
+  }
+
+  /**
+   * @brief Split the bytes into classes never distinguished by \a nfa
+   * @return One byte of each class
+   */
+  auto BuildClasses(const details::RegexNfa& nfa) -> std::vector<unsigned> {
+    m_classes.fill(0);
+    m_classes_count = 1;
+
+    // Refine the partition with each set of bytes: (class, in set) -> class
+    for (const auto& bytes : nfa.bytes) {
+      std::vector<std::size_t> refined(m_classes_count * 2, kNoClass);
+      std::size_t count = 0;
+      for (unsigned b = 0; b < 256; ++b) {
+        auto& id = refined[(m_classes[b] * 2u) + (bytes.test(b) ? 1u : 0u)];
+        if (id == kNoClass) id = count++;
+        m_classes[b] = static_cast<std::uint8_t>(id);
+      }
+      m_classes_count = count;
+    }
+
+    std::vector<unsigned> representatives(m_classes_count, 0);
+    for (unsigned b = 0; b < 256; ++b) representatives[m_classes[b]] = b;
+    return representatives;
+  }
+
+  /// Subset construction over the classes of \a representatives (state 0
+  /// being the dead state)
+  auto BuildDfa(const details::RegexNfa& nfa,
+                const std::vector<unsigned>& representatives) const -> Dfa {
+    Dfa dfa;
+    std::map<std::vector<std::size_t>, StateId> ids;
+    std::vector<std::vector<std::size_t>> subsets;
+    std::vector<std::uint8_t> visited(nfa.states.size(), 0);
+
+    const auto add = [&](std::vector<std::size_t> subset) -> StateId {
+      // Epsilon closure
+      std::vector<std::size_t> stack = subset;
+      for (const std::size_t s : subset) visited[s] = 1;
+      while (!stack.empty()) {
+        const std::size_t s = stack.back();
+        stack.pop_back();
+        for (const std::size_t next : nfa.states[s].epsilons) {
+          if (visited[next] == 0) {
+            visited[next] = 1;
+            subset.push_back(next);
+            stack.push_back(next);
+          }
+        }
+      }
+      for (const std::size_t s : subset) visited[s] = 0;
+      std::sort(subset.begin(), subset.end());
+
+      const auto [it, inserted] =
+          ids.try_emplace(subset, static_cast<StateId>(subsets.size()));
+      if (inserted) {
+        if (subsets.size() >= kMaxStates) {
+          throw std::length_error("Regex: too many DFA states");
+        }
+        subsets.push_back(std::move(subset));
+      }
+      return it->second;
+    };
+
+    add({});
+    dfa.start = add({nfa.start});
+
+    for (std::size_t i = 0; i < subsets.size(); ++i) {
+      for (std::size_t c = 0; c < m_classes_count; ++c) {
+        std::vector<std::size_t> moved;
+        for (const std::size_t s : subsets[i]) {
+          const auto& state = nfa.states[s];
+          if ((state.bytes != details::RegexNfa::kNone) &&
+              nfa.bytes[state.bytes].test(representatives[c])) {
+            moved.push_back(state.next);
+          }
+        }
+        // Not a reference: add() may grow subsets
+        dfa.transitions.push_back(add(std::move(moved)));
+      }
+    }
+
+    dfa.accepting.resize(subsets.size(), 0);
+    for (std::size_t i = 0; i < subsets.size(); ++i) {
+      for (const std::size_t s : subsets[i]) {
+        if (s == nfa.accept) dfa.accepting[i] = 1;
+      }
+    }
+    return dfa;
+  }
+
+  /// Moore's partition refinement of \a dfa into the final tables
+  auto Minimize(const Dfa& dfa) -> void {
+    const std::size_t count = dfa.accepting.size();
+    std::vector<std::size_t> group(dfa.accepting.begin(),
+                                   dfa.accepting.end());
+    std::size_t groups_count = 0;
+
+    for (;;) {
+      // States stay in the same group when they have the same group and
+      // transitions to the same groups
+      std::map<std::vector<std::size_t>, std::size_t> signatures;
+      std::vector<std::size_t> refined(count);
+      for (std::size_t s = 0; s < count; ++s) {
+        std::vector<std::size_t> signature = {group[s]};
+        for (std::size_t c = 0; c < m_classes_count; ++c) {
+          signature.push_back(
+              group[dfa.transitions[(s * m_classes_count) + c]]);
+        }
+        refined[s] = signatures.try_emplace(std::move(signature),
+                                            signatures.size())
+                         .first->second;
+      }
+
+      group = std::move(refined);
+      if (signatures.size() == groups_count) break;
+      groups_count = signatures.size();
+    }
+
+    m_transitions.assign(groups_count * m_classes_count, 0);
+    m_accepting.assign(groups_count, 0);
+    for (std::size_t s = 0; s < count; ++s) {
+      m_accepting[group[s]] = dfa.accepting[s];
+      for (std::size_t c = 0; c < m_classes_count; ++c) {
+        m_transitions[(group[s] * m_classes_count) + c] = static_cast<StateId>(
+            group[dfa.transitions[(s * m_classes_count) + c]]);
+      }
+    }
+    m_start = static_cast<StateId>(group[dfa.start]);
+    m_dead = static_cast<StateId>(group[0]);
+  }
+
+  static constexpr std::size_t kNoClass =
+      std::numeric_limits<std::size_t>::max();
+
+  Mode m_mode;
+  std::array<std::uint8_t, 256> m_classes = {}; /*!< Byte -> class */
+  std::size_t m_classes_count = 0;
+  std::vector<StateId> m_transitions; /*!< [state * classes + class] */
+  std::vector<std::uint8_t> m_accepting;
+  StateId m_start = 0;
+  StateId m_dead = 0;
+};
+
+/**
+ * @return A Regex matcher, true whenever the WHOLE given str matches
+ *         \a pattern (see Regex for the syntax supported)
+ *
+ * @throw std::invalid_argument When \a pattern isn't a valid regex
+ */
+inline auto StrRegex(std::string_view pattern) -> Regex {
+  return Regex(pattern, Regex::Mode::kFullMatch);
+}
+
+/**
+ * @return A Regex matcher, true whenever the given str contains a match of
+ *         \a pattern (see Regex for the syntax supported)
+ *
+ * @throw std::invalid_argument When \a pattern isn't a valid regex
+ */
+inline auto StrContainsRegex(std::string_view pattern) -> Regex {
+  return Regex(pattern, Regex::Mode::kSearch);
+}
+
+}  // namespace atb
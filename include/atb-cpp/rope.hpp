@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>  // std::copy_n, std::min
+#include <cstddef>    // std::size_t
+#include <initializer_list>
+#include <limits>  // std::numeric_limits
+#include <memory>  // std::unique_ptr
+#include <mutex>
+#include <optional>
+#include <stdexcept>  // std::length_error
+#include <string>
+#include <string_view>
+#include <utility>  // std::move, std::exchange
+#include <vector>
+
+namespace atb {
+
+/**
+ * @brief Pool of fixed size char blocks, recycled between StrRope instances
+ *
+ * Blocks released are kept and handed back by the next Acquire(), hence
+ * building reports over and over doesn't hit the allocator once the pool is
+ * warm.
+ *
+ * @note Thread safe: a single pool can be shared by ropes living on different
+ *       threads
+ */
+class StrBlockPool final {
+ public:
+  /// Default size of the blocks
+  static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+  /// Construct an empty pool, giving blocks of \a block_size bytes
+  explicit StrBlockPool(std::size_t block_size = kDefaultBlockSize)
+      : m_block_size(block_size > 0 ? block_size : kDefaultBlockSize) {}
+
+  /// Not copyable/movable (ropes reference it)
+  StrBlockPool(const StrBlockPool&) = delete;
+  StrBlockPool(StrBlockPool&&) = delete;
+  auto operator=(const StrBlockPool&) -> StrBlockPool& = delete;
+  auto operator=(StrBlockPool&&) -> StrBlockPool& = delete;
+
+  ~StrBlockPool() noexcept = default;
+
+  /// @return The size of the blocks
+  auto BlockSize() const noexcept -> std::size_t { return m_block_size; }
+
+  /// @return A block of BlockSize() bytes (recycled when possible)
+  auto Acquire() -> std::unique_ptr<char[]> {
+    {
+      std::lock_guard lock{m_mutex};
+      if (!m_free.empty()) {
+        auto block = std::move(m_free.back());
+        m_free.pop_back();
+        return block;
+      }
+    }
+    return std::unique_ptr<char[]>(new char[m_block_size]);
+  }
+
+  /// Give back a \a block previously acquired
+  auto Release(std::unique_ptr<char[]> block) -> void {
+    std::lock_guard lock{m_mutex};
+    m_free.push_back(std::move(block));
+  }
+
+  /// @return The number of blocks available for recycling
+  auto FreeCount() const -> std::size_t {
+    std::lock_guard lock{m_mutex};
+    return m_free.size();
+  }
+
+ private:
+  const std::size_t m_block_size;
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<char[]>> m_free;
+};
+
+/**
+ * @brief Chunked string builder, for (very) large outputs
+ *
+ * Contrary to StrAppend on a std::string, appending never moves the bytes
+ * already written: they are copied into fixed size blocks and a new block is
+ * added when the last one is full. The result is exposed as a sequence of
+ * string_view chunks (i.e. to be given to `writev()`), or can be flattened
+ * into a single std::string with only one allocation.
+ *
+ * @code{.cpp}
+ * StrBlockPool pool;
+ * StrRope report(pool);
+ *
+ * for (const auto& row : rows) report.Append({row.name, ";", row.value, "\n"});
+ *
+ * std::vector<iovec> iov;
+ * report.ForEachChunk([&](std::string_view chunk) {
+ *   iov.push_back({const_cast<char*>(chunk.data()), chunk.size()});
+ * });
+ * writev(fd, iov.data(), static_cast<int>(iov.size()));
+ * @endcode
+ *
+ * @note When built from a StrBlockPool, blocks are acquired from it and given
+ *       back when the rope is cleared/destroyed (the pool MUST outlive it)
+ */
+class StrRope final {
+ public:
+  /// Default size of the blocks (when not using a pool)
+  static constexpr std::size_t kDefaultBlockSize =
+      StrBlockPool::kDefaultBlockSize;
+
+  /// Construct an empty rope, allocating its own blocks of \a block_size bytes
+  explicit StrRope(std::size_t block_size = kDefaultBlockSize) noexcept
+      : m_block_size(block_size > 0 ? block_size : kDefaultBlockSize) {}
+
+  /// Construct an empty rope, acquiring its blocks from \a pool
+  explicit StrRope(StrBlockPool& pool) noexcept
+      : m_pool(&pool), m_block_size(pool.BlockSize()) {}
+
+  /// Not copyable
+  StrRope(const StrRope&) = delete;
+  auto operator=(const StrRope&) -> StrRope& = delete;
+
+  /// Movable (chunks previously returned remain valid)
+  StrRope(StrRope&& other) noexcept
+      : m_pool(other.m_pool),
+        m_block_size(other.m_block_size),
+        m_blocks(std::move(other.m_blocks)),
+        m_size(std::exchange(other.m_size, 0)) {}
+
+  auto operator=(StrRope&& other) noexcept -> StrRope& {
+    if (this != &other) {
+      Clear();
+      m_pool = other.m_pool;
+      m_block_size = other.m_block_size;
+      m_blocks = std::move(other.m_blocks);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  ~StrRope() noexcept { Clear(); }
+
+  /**
+   * @brief Append the list of \a strings at the end of the rope
+   *
+   * @important \a strings MUST NOT contain a ref to the rope chunks
+   */
+  auto Append(std::initializer_list<std::string_view> strings) -> StrRope& {
+    for (auto str : strings) Append(str);
+    return *this;
+  }
+
+  /// Append \a str at the end of the rope
+  auto Append(std::string_view str) -> StrRope& {
+    while (!str.empty()) {
+      if (m_blocks.empty() || (m_blocks.back().size == m_block_size)) {
+        m_blocks.push_back(Block{NewBlock(), 0});
+      }
+
+      auto& block = m_blocks.back();
+      const std::size_t n = std::min(str.size(), m_block_size - block.size);
+      std::copy_n(str.data(), n, block.data.get() + block.size);
+      block.size += n;
+      m_size += n;
+      str.remove_prefix(n);
+    }
+    return *this;
+  }
+
+  /// @return The total number of bytes appended
+  auto Size() const noexcept -> std::size_t { return m_size; }
+
+  /// @return true when nothing has been appended
+  auto Empty() const noexcept -> bool { return m_size == 0; }
+
+  /// @return The size of the blocks used
+  auto BlockSize() const noexcept -> std::size_t { return m_block_size; }
+
+  /// @return The number of chunks (i.e. blocks used)
+  auto ChunksCount() const noexcept -> std::size_t { return m_blocks.size(); }
+
+  /**
+   * @return The chunk \a i (views remain valid until the rope is cleared)
+   * @pre i < ChunksCount()
+   */
+  auto Chunk(std::size_t i) const noexcept -> std::string_view {
+    return {m_blocks[i].data.get(), m_blocks[i].size};
+  }
+
+  /**
+   * @brief Call \a f with each chunk (std::string_view), in order
+   */
+  template <class F>
+  auto ForEachChunk(F&& f) const -> void {
+    for (std::size_t i = 0; i < m_blocks.size(); ++i) f(Chunk(i));
+  }
+
+  /**
+   * @brief Append the whole content of the rope into \a d_str, by doing only
+   *        one resize
+   *
+   * @return The number of bytes added to \a d_str when successfull. Otherwise
+   *         std::nullopt (nothing added) if the operation would overflows.
+   */
+  auto FlattenInto(std::string& d_str) const -> std::optional<std::size_t> {
+    const std::size_t old_size = d_str.size();
+
+    // std::size_t or std::string mem overflows
+    if ((old_size > (std::numeric_limits<std::size_t>::max() - m_size)) ||
+        ((old_size + m_size) > d_str.max_size())) {
+      return std::nullopt;
+    }
+
+    d_str.resize(old_size + m_size);
+
+    char* d_first = d_str.data() + old_size;
+    ForEachChunk([&](std::string_view chunk) {
+      d_first = std::copy_n(chunk.data(), chunk.size(), d_first);
+    });
+
+    return m_size;
+  }
+
+  /**
+   * @return The whole content of the rope into a single string
+   *
+   * @throw std::length_error When the content doesn't fit into a std::string
+   */
+  auto Flatten() const -> std::string {
+    std::string str;
+    if (!FlattenInto(str)) {
+      throw std::length_error("StrRope: Too big to be flattened");
+    }
+    return str;
+  }
+
+  /**
+   * @brief Remove all content (blocks are given back to the pool, if any)
+   */
+  auto Clear() noexcept -> void {
+    if (m_pool != nullptr) {
+      for (auto& block : m_blocks) {
+        try {
+          m_pool->Release(std::move(block.data));
+        } catch (...) {
+          // Failing to recycle a block only frees it
+        }
+      }
+    }
+    m_blocks.clear();
+    m_size = 0;
+  }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size; /*!< Bytes used */
+  };
+
+  auto NewBlock() -> std::unique_ptr<char[]> {
+    if (m_pool != nullptr) return m_pool->Acquire();
+    return std::unique_ptr<char[]>(new char[m_block_size]);
+  }
+
+  StrBlockPool* m_pool = nullptr; /*!< Pool used to get blocks (optional) */
+  std::size_t m_block_size;       /*!< Size of each block */
+  std::vector<Block> m_blocks;    /*!< Blocks, by appending order */
+  std::size_t m_size = 0;         /*!< Total number of bytes appended */
+};
+
+}  // namespace atb
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <cstring>  // std::memcmp
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+/**
+ * @brief Precompiled single pattern substring searcher
+ *
+ * Everything that only depends on the pattern is computed once, when
+ * constructing the searcher, instead of on each search:
+ * - Single chars are searched using memchr() (through std::string_view);
+ * - Short patterns (up to kMaxFilteredSize bytes) are searched using a SIMD
+ *   first/last byte filter (SSE2/AVX2): the first and last bytes of the
+ *   pattern are compared against 16/32 consecutive windows at once, and only
+ *   the candidates passing both tests are fully compared;
+ * - Longer patterns (or when SIMD isn't available) use the
+ *   Boyer-Moore-Horspool algorithm, with one bad char shift table for each
+ *   search direction.
+ *
+ * @code{.cpp}
+ * constexpr StrSearcher searcher("foo");
+ * assert(searcher.Find("a foo b foo") == 2);
+ * assert(searcher.RFind("a foo b foo") == 8);
+ * @endcode
+ *
+ * @important The pattern is stored as a string_view, the underlying
+ *            string-like referenced NEEDS to outlive the searcher lifetime.
+ */
+class StrSearcher final {
+ public:
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  /// Patterns longer than this don't use the SIMD filter
+  static constexpr std::size_t kMaxFilteredSize = 32;
+
+  /// Default ctor (empty pattern, always found)
+  constexpr StrSearcher() noexcept = default;
+
+  /// Construct a searcher looking for \a pattern
+  constexpr explicit StrSearcher(std::string_view pattern) noexcept
+      : m_pattern(pattern) {
+    const std::size_t m = m_pattern.size();
+
+    // Shifts are capped to 255: a smaller shift is always safe
+    const auto shift = [](std::size_t s) constexpr noexcept {
+      return static_cast<std::uint8_t>(s < 255 ? s : 255);
+    };
+
+    for (auto& s : m_shift) s = shift(m);
+    for (auto& s : m_rshift) s = shift(m);
+
+    if (m == 0) return;
+
+    // Forward: distance from the last occurrence of c (excluding the last
+    // char) to the end of the pattern
+    for (std::size_t j = 0; (j + 1) < m; ++j) {
+      m_shift[static_cast<std::uint8_t>(m_pattern[j])] = shift(m - 1 - j);
+    }
+
+    // Backward: distance from the first occurrence of c (excluding the first
+    // char) to the beginning of the pattern
+    for (std::size_t j = m - 1; j > 0; --j) {
+      m_rshift[static_cast<std::uint8_t>(m_pattern[j])] = shift(j);
+    }
+  }
+
+  /// @return The pattern we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_pattern;
+  }
+
+  /**
+   * @return The index of the FIRST occurrence of the pattern in \a str,
+   *         starting at \a pos. npos if not found.
+   *
+   * @note Same as std::string_view::find
+   */
+  auto Find(std::string_view str, std::size_t pos = 0) const noexcept
+      -> std::size_t;
+
+  /**
+   * @return The index of the LAST occurrence of the pattern in \a str,
+   *         starting at or before \a pos. npos if not found.
+   *
+   * @note Same as std::string_view::rfind
+   */
+  auto RFind(std::string_view str, std::size_t pos = npos) const noexcept
+      -> std::size_t;
+
+  /**
+   * @brief Scalar (Boyer-Moore-Horspool) implementation of Find()
+   */
+  constexpr auto FindScalar(std::string_view str, std::size_t pos = 0) const
+      noexcept -> std::size_t {
+    const std::size_t m = m_pattern.size();
+    if ((pos > str.size()) || (m > (str.size() - pos))) return npos;
+    if (m == 0) return pos;
+
+    const char last = m_pattern[m - 1];
+    for (std::size_t i = pos; (i + m) <= str.size();) {
+      const char c = str[i + m - 1];
+      if ((c == last) &&
+          (str.substr(i, m - 1) == m_pattern.substr(0, m - 1))) {
+        return i;
+      }
+      i += m_shift[static_cast<std::uint8_t>(c)];
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Scalar (Boyer-Moore-Horspool) implementation of RFind()
+   */
+  constexpr auto RFindScalar(std::string_view str,
+                             std::size_t pos = npos) const noexcept
+      -> std::size_t {
+    const std::size_t m = m_pattern.size();
+    if (m > str.size()) return npos;
+
+    std::size_t i = (str.size() - m);
+    if (pos < i) i = pos;
+    if (m == 0) return i;
+
+    const char first = m_pattern[0];
+    while (true) {
+      const char c = str[i];
+      if ((c == first) && (str.substr(i + 1, m - 1) == m_pattern.substr(1))) {
+        return i;
+      }
+
+      const std::size_t s = m_rshift[static_cast<std::uint8_t>(c)];
+      if (i < s) break;
+      i -= s;
+    }
+    return npos;
+  }
+
+ private:
+  std::string_view m_pattern;
+  std::array<std::uint8_t, 256> m_shift = {};
+  std::array<std::uint8_t, 256> m_rshift = {};
+};
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+/// @return true when the pattern middle bytes (all but first/last) match
+inline auto SearcherMiddleEquals(const char* candidate,
+                                 std::string_view pattern) noexcept -> bool {
+  return (pattern.size() <= 2) ||
+         (std::memcmp(candidate + 1, pattern.data() + 1, pattern.size() - 2) ==
+          0);
+}
+
+/// @pre 0 < pattern.size() <= (str.size() - pos)
+ATB_SIMD_TARGET("sse2")
+inline auto SearcherFindSse2(std::string_view pattern, std::string_view str,
+                             std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m128i first = _mm_set1_epi8(pattern.front());
+  const __m128i last = _mm_set1_epi8(pattern.back());
+
+  for (; (pos + m - 1 + 16) <= str.size(); pos += 16) {
+    const char* data = str.data() + pos;
+    const __m128i block_first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i block_last =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + m - 1));
+
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const auto bit = simd::CountTrailingZeros(mask);
+      if (SearcherMiddleEquals(data + bit, pattern)) return pos + bit;
+    }
+  }
+
+  return str.find(pattern, pos);
+}
+
+/// @pre 0 < pattern.size() <= (str.size() - pos)
+ATB_SIMD_TARGET("avx2")
+inline auto SearcherFindAvx2(std::string_view pattern, std::string_view str,
+                             std::size_t pos) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m256i first = _mm256_set1_epi8(pattern.front());
+  const __m256i last = _mm256_set1_epi8(pattern.back());
+
+  for (; (pos + m - 1 + 32) <= str.size(); pos += 32) {
+    const char* data = str.data() + pos;
+    const __m256i block_first =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i block_last =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + m - 1));
+
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first),
+            _mm256_cmpeq_epi8(last, block_last))));
+
+    for (; mask != 0; mask &= (mask - 1)) {
+      const auto bit = simd::CountTrailingZeros(mask);
+      if (SearcherMiddleEquals(data + bit, pattern)) return pos + bit;
+    }
+  }
+
+  return str.find(pattern, pos);
+}
+
+/// @param[in] end One past the last candidate index to look at
+/// @pre 0 < pattern.size() && (end + pattern.size() - 1) <= str.size()
+ATB_SIMD_TARGET("sse2")
+inline auto SearcherRFindSse2(std::string_view pattern, std::string_view str,
+                              std::size_t end) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m128i first = _mm_set1_epi8(pattern.front());
+  const __m128i last = _mm_set1_epi8(pattern.back());
+
+  for (; end >= 16; end -= 16) {
+    const char* data = str.data() + end - 16;
+    const __m128i block_first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i block_last =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + m - 1));
+
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+
+    while (mask != 0) {
+      const auto bit = simd::HighestBitSet(mask);
+      if (SearcherMiddleEquals(data + bit, pattern)) return end - 16 + bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return (end == 0) ? StrSearcher::npos : str.rfind(pattern, end - 1);
+}
+
+/// @param[in] end One past the last candidate index to look at
+/// @pre 0 < pattern.size() && (end + pattern.size() - 1) <= str.size()
+ATB_SIMD_TARGET("avx2")
+inline auto SearcherRFindAvx2(std::string_view pattern, std::string_view str,
+                              std::size_t end) noexcept -> std::size_t {
+  const std::size_t m = pattern.size();
+  const __m256i first = _mm256_set1_epi8(pattern.front());
+  const __m256i last = _mm256_set1_epi8(pattern.back());
+
+  for (; end >= 32; end -= 32) {
+    const char* data = str.data() + end - 32;
+    const __m256i block_first =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i block_last =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + m - 1));
+
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, block_first),
+            _mm256_cmpeq_epi8(last, block_last))));
+
+    while (mask != 0) {
+      const auto bit = simd::HighestBitSet(mask);
+      if (SearcherMiddleEquals(data + bit, pattern)) return end - 32 + bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return (end == 0) ? StrSearcher::npos : str.rfind(pattern, end - 1);
+}
+
+#endif  // ATB_SIMD_X86
+
+}  // namespace details
+
+inline auto StrSearcher::Find(std::string_view str, std::size_t pos) const
+    noexcept -> std::size_t {
+  const std::size_t m = m_pattern.size();
+  if ((pos > str.size()) || (m > (str.size() - pos))) return npos;
+  if (m == 0) return pos;
+
+  // memchr() based search is hard to beat for single chars
+  if (m == 1) return str.find(m_pattern.front(), pos);
+
+#if ATB_SIMD_X86
+  if (m <= kMaxFilteredSize) {
+    switch (simd::DetectedIsa()) {
+      case simd::Isa::kAvx2:
+        return details::SearcherFindAvx2(m_pattern, str, pos);
+      case simd::Isa::kSsse3:
+      case simd::Isa::kSse2:
+        return details::SearcherFindSse2(m_pattern, str, pos);
+      case simd::Isa::kScalar:
+        break;
+    }
+  }
+#endif
+
+  return FindScalar(str, pos);
+}
+
+inline auto StrSearcher::RFind(std::string_view str, std::size_t pos) const
+    noexcept -> std::size_t {
+  const std::size_t m = m_pattern.size();
+  if (m > str.size()) return npos;
+  if (m == 0) return (pos < str.size()) ? pos : str.size();
+
+#if ATB_SIMD_X86
+  if (m <= kMaxFilteredSize) {
+    const std::size_t last_candidate = str.size() - m;
+    const std::size_t end = ((pos < last_candidate) ? pos : last_candidate) + 1;
+
+    switch (simd::DetectedIsa()) {
+      case simd::Isa::kAvx2:
+        return details::SearcherRFindAvx2(m_pattern, str, end);
+      case simd::Isa::kSsse3:
+      case simd::Isa::kSse2:
+        return details::SearcherRFindSse2(m_pattern, str, end);
+      case simd::Isa::kScalar:
+        break;
+    }
+  }
+#endif
+
+  return RFindScalar(str, pos);
+}
+
+}  // namespace atb
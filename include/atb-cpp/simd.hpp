@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+// Vectorized kernels are only available with GCC/Clang on x86. They are
+// compiled using per-function target attributes (no global -m flags needed)
+// and selected at runtime using DetectedIsa().
+//
+// Define ATB_CPP_DISABLE_SIMD in order to only use the scalar fallbacks.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__)) && !defined(ATB_CPP_DISABLE_SIMD)
+#define ATB_SIMD_X86 1
+#include <immintrin.h>
+#define ATB_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ATB_SIMD_X86 0
+#define ATB_SIMD_TARGET(isa)
+#endif
+
+namespace atb::simd {
+
+/// Instruction sets for which kernels may be provided, ordered by capability
+enum class Isa : std::uint8_t {
+  kScalar = 0,
+  kSse2,
+  kSsse3,
+  kAvx2,
+};
+
+/**
+ * @return The best instruction set supported by the running CPU (detected
+ *         once, on the first call)
+ */
+inline auto DetectedIsa() noexcept -> Isa {
+#if ATB_SIMD_X86
+  static const Isa isa = []() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Isa::kAvx2;
+    if (__builtin_cpu_supports("ssse3")) return Isa::kSsse3;
+    if (__builtin_cpu_supports("sse2")) return Isa::kSse2;
+    return Isa::kScalar;
+  }();
+  return isa;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+/**
+ * @return The index of the lowest bit set in \a mask
+ * @pre mask != 0
+ */
+constexpr auto CountTrailingZeros(std::uint32_t mask) noexcept -> unsigned {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+  unsigned n = 0;
+  for (; (mask & 1u) == 0; mask >>= 1) ++n;
+  return n;
+#endif
+}
+
+/**
+ * @return The index of the highest bit set in \a mask
+ * @pre mask != 0
+ */
+constexpr auto HighestBitSet(std::uint32_t mask) noexcept -> unsigned {
+#if defined(__GNUC__) || defined(__clang__)
+  return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#else
+  unsigned n = 0;
+  for (; mask > 1u; mask >>= 1) ++n;
+  return n;
+#endif
+}
+
+}  // namespace atb::simd
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <stdexcept>  // std::invalid_argument
+#include <string_view>
+#include <utility>  // std::pair
+
+namespace atb {
+
+namespace details {
+
+/// @return The smallest power of 2 >= n
+constexpr auto BitCeil(std::size_t n) noexcept -> std::size_t {
+  std::size_t p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+/// @return \a h with its bits mixed (fmix64 finalizer of MurmurHash3)
+constexpr auto StaticStrMix(std::uint64_t h) noexcept -> std::uint64_t {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+/// @return A 64 bits hash (FNV-1a + fmix64 finalizer) of \a str
+constexpr auto StaticStrHash(std::string_view str) noexcept -> std::uint64_t {
+  std::uint64_t h = 0xcbf29ce484222325ull;
+  for (auto c : str) {
+    h ^= static_cast<std::uint8_t>(c);
+    h *= 0x100000001b3ull;
+  }
+  return StaticStrMix(h);
+}
+
+/**
+ * @return The slot used by hash \a h, given the displacement \a d
+ *
+ * @note The displacement is mixed with the whole hash: keys with different
+ *       hashes get independent slots for each displacement (i.e. they can't
+ *       collide for all of them)
+ */
+constexpr auto StaticStrSlot(std::uint64_t h, std::uint32_t d,
+                             std::uint64_t table_size) noexcept
+    -> std::uint64_t {
+  return StaticStrMix(h ^ (d * 0x9e3779b97f4a7c15ull)) & (table_size - 1);
+}
+
+}  // namespace details
+
+/**
+ * @brief Switch over a set of string literals known at compile time, using a
+ *        perfect hash table built at compile time
+ *
+ * Contrary to StrSwitch, which evaluates each `.Case()` linearly, the lookup
+ * is done in O(1): the input is hashed once, the hash gives the only slot
+ * that may contain it, and a single final comparison is done.
+ *
+ * The perfect hash uses the 'hash and displace' scheme: the keys are split
+ * into buckets (using their hash) and, starting with the biggest bucket, a
+ * displacement is searched for each bucket such that all its keys fall into
+ * free slots. The lookup therefore costs 1 hash, 1 displacement lookup and 1
+ * comparison.
+ *
+ * @code{.cpp}
+ * static constexpr auto kVerbs = MakeStaticStrSwitch<int>({
+ *     {"GET", 0},
+ *     {"PUT", 1},
+ *     {"POST", 2},
+ * });
+ *
+ * static_assert(*kVerbs.Find("PUT") == 1);
+ * static_assert(kVerbs.FindOr("PATCH", -1) == -1);
+ * @endcode
+ *
+ * @note Building it as `constexpr` guarantees the table is computed at compile
+ *       time. Duplicated keys results in a compilation error in that case (an
+ *       std::invalid_argument exception is thrown otherwise).
+ *
+ * @tparam R Type of the values (must be a default constructible literal type
+ *           in order to be used in constant expressions)
+ * @tparam N Number of cases
+ */
+template <class R, std::size_t N>
+class StaticStrSwitch final {
+  static_assert(N > 0, "StaticStrSwitch needs at least one case");
+
+ public:
+  /// A single case of the switch
+  using Case = std::pair<std::string_view, R>;
+
+  /// Number of slots of the hash table
+  static constexpr std::size_t kTableSize = details::BitCeil(2 * N);
+
+  /// Number of buckets (i.e. displacements stored)
+  static constexpr std::size_t kBucketsCount = (N + 1) / 2;
+
+  /**
+   * @brief Build the perfect hash table from the list of \a cases
+   *
+   * @throw std::invalid_argument When cases contain duplicated keys (or
+   *        distinct keys with the same 64 bits hash)
+   */
+  constexpr explicit StaticStrSwitch(const Case (&cases)[N]) {
+    std::array<std::uint64_t, N> hashes = {};
+    std::array<std::size_t, kBucketsCount> sizes = {};
+    std::size_t biggest = 0;
+
+    for (std::size_t i = 0; i < N; ++i) {
+      hashes[i] = details::StaticStrHash(cases[i].first);
+      auto& size = sizes[hashes[i] % kBucketsCount];
+      if (++size > biggest) biggest = size;
+    }
+
+    // Place the biggest buckets first, while the table is mostly empty
+    for (std::size_t size = biggest; size > 0; --size) {
+      for (std::size_t b = 0; b < kBucketsCount; ++b) {
+        if (sizes[b] == size) PlaceBucket(b, cases, hashes);
+      }
+    }
+  }
+
+  /**
+   * @return A pointer to the value associated to \a str. nullptr when \a str
+   *         doesn't match any case.
+   */
+  constexpr auto Find(std::string_view str) const noexcept -> const R* {
+    const auto h = details::StaticStrHash(str);
+    const auto& slot = m_slots[details::StaticStrSlot(
+        h, m_displacements[h % kBucketsCount], kTableSize)];
+    return (slot.used && (slot.key == str)) ? &slot.value : nullptr;
+  }
+
+  /**
+   * @return The value associated to \a str, or \a default_value when \a str
+   *         doesn't match any case.
+   */
+  template <class T>
+  constexpr auto FindOr(std::string_view str, T&& default_value) const -> R {
+    if (const auto value = Find(str); value != nullptr) return *value;
+    return R(std::forward<T>(default_value));
+  }
+
+  /**
+   * @brief Mandatory matcher interface (see matchers.hpp)
+   *
+   * @return true whenever \a str is equal to one of the cases
+   */
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Find(str) != nullptr;
+  }
+
+  /// @return The number of cases
+  static constexpr auto Size() noexcept -> std::size_t { return N; }
+
+ private:
+  struct Slot {
+    std::string_view key = {};
+    R value = {};
+    bool used = false;
+  };
+
+  constexpr auto PlaceBucket(std::size_t bucket, const Case (&cases)[N],
+                             const std::array<std::uint64_t, N>& hashes)
+      -> void {
+    // Only identical keys can't be separated (they have the same hash)
+    for (std::size_t i = 0; i < N; ++i) {
+      if ((hashes[i] % kBucketsCount) != bucket) continue;
+      for (std::size_t j = i + 1; j < N; ++j) {
+        if ((hashes[j] == hashes[i]) && (cases[j].first == cases[i].first)) {
+          throw std::invalid_argument("StaticStrSwitch: duplicated keys");
+        }
+      }
+    }
+
+    // Each displacement gives independent slots: with a table at most half
+    // full, failing that many times is (astronomically) unlikely
+    constexpr auto kMaxDisplacement =
+        static_cast<std::uint32_t>(16 * kTableSize);
+
+    for (std::uint32_t d = 0; d < kMaxDisplacement; ++d) {
+      std::array<std::uint64_t, N> taken = {};
+      std::size_t count = 0;
+      bool ok = true;
+
+      for (std::size_t i = 0; ok && (i < N); ++i) {
+        if ((hashes[i] % kBucketsCount) != bucket) continue;
+
+        const auto slot = details::StaticStrSlot(hashes[i], d, kTableSize);
+        ok = !m_slots[slot].used;
+        for (std::size_t t = 0; ok && (t < count); ++t) {
+          ok = (taken[t] != slot);
+        }
+        taken[count++] = slot;
+      }
+
+      if (ok) {
+        m_displacements[bucket] = d;
+        std::size_t t = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+          if ((hashes[i] % kBucketsCount) != bucket) continue;
+
+          auto& slot = m_slots[taken[t++]];
+          slot.key = cases[i].first;
+          slot.value = cases[i].second;
+          slot.used = true;
+        }
+        return;
+      }
+    }
+
+    throw std::invalid_argument(
+        "StaticStrSwitch: no displacement found (64 bits hash collision)");
+  }
+
+  std::array<Slot, kTableSize> m_slots = {};
+  std::array<std::uint32_t, kBucketsCount> m_displacements = {};
+};
+
+/**
+ * @brief Helper used to build a StaticStrSwitch, deducing its size
+ *
+ * @code{.cpp}
+ * static constexpr auto kSwitch = MakeStaticStrSwitch<int>({
+ *     {"foo", 0},
+ *     {"bar", 1},
+ * });
+ * @endcode
+ */
+template <class R, std::size_t N>
+constexpr auto MakeStaticStrSwitch(
+    const std::pair<std::string_view, R> (&cases)[N]) -> StaticStrSwitch<R, N> {
+  return StaticStrSwitch<R, N>(cases);
+}
+
+}  // namespace atb
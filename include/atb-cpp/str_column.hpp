@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::max
+#include <array>
+#include <charconv>  // std::to_chars
+#include <cstddef>   // std::size_t
+#include <cstdint>
+#include <iterator>  // std::data, std::size
+#include <limits>    // std::numeric_limits
+#include <stdexcept>  // std::invalid_argument
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>  // std::declval
+#include <vector>
+
+#include "atb-cpp/format.hpp"  // StrPiece
+#include "atb-cpp/scope_exit.hpp"
+
+namespace atb {
+
+/**
+ * @brief Arrow like column of strings: all rows are stored contiguously into
+ *        a single buffer, row i being `data[offsets[i], offsets[i + 1])`
+ */
+struct StrColumn {
+  std::string data;                    /*!< All rows, concatenated */
+  std::vector<std::size_t> offsets{0}; /*!< Size() + 1 offsets into data */
+
+  /// @return The number of rows
+  auto Size() const noexcept -> std::size_t { return offsets.size() - 1; }
+
+  /// @return true when there isn't any rows
+  auto Empty() const noexcept -> bool { return Size() == 0; }
+
+  /// @return The row \a i
+  auto operator[](std::size_t i) const noexcept -> std::string_view {
+    return {data.data() + offsets[i], offsets[i + 1] - offsets[i]};
+  }
+};
+
+namespace details {
+
+/// Powers of 10: kStrPow10[i] == 10^i
+constexpr std::array<std::uint64_t, 20> kStrPow10 = [] {
+  std::array<std::uint64_t, 20> pow10 = {};
+  pow10[0] = 1;
+  for (std::size_t i = 1; i < pow10.size(); ++i) pow10[i] = pow10[i - 1] * 10;
+  return pow10;
+}();
+
+/**
+ * @return The number of chars of the decimal representation of \a value
+ *
+ * @note Computed without formatting \a value: the number of digits is
+ *       approximated from its number of bits, then corrected using a single
+ *       comparison with a power of 10
+ */
+template <class T>
+constexpr auto StrIntegerSize(T value) noexcept -> std::size_t {
+  std::uint64_t magnitude = 0;
+  std::size_t size = 0;
+  if constexpr (std::is_signed_v<T>) {
+    const std::int64_t wide = value;
+    magnitude = static_cast<std::uint64_t>(wide);
+    magnitude = (wide < 0) ? (0 - magnitude) : magnitude;
+    size += static_cast<std::size_t>(wide < 0);
+  } else {
+    magnitude = value;
+  }
+
+  // Same number of digits (powers of 10 are even), but never 0
+  magnitude |= 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+  const auto bits = static_cast<std::size_t>(64 - __builtin_clzll(magnitude));
+  const std::size_t digits = (bits * 1233) >> 12;  // floor(bits * log10(2))
+  return size + digits +
+         static_cast<std::size_t>(magnitude >= kStrPow10[digits]);
+#else
+  for (std::size_t i = 1; i < kStrPow10.size(); ++i) {
+    size += static_cast<std::size_t>(magnitude >= kStrPow10[i]);
+  }
+  return size + 1;
+#endif
+}
+
+/// true when T is a value of a column: a string, a char, a bool or a number
+template <class T>
+constexpr bool kIsStrColumnValue =
+    std::is_convertible_v<std::add_lvalue_reference_t<const T>,
+                          std::string_view> ||
+    std::is_arithmetic_v<T>;
+
+template <class T>
+constexpr bool kIsStrColumnInteger =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char>;
+
+template <class C, class = void>
+struct StrColumnRangeValue {
+  using type = void;
+};
+
+template <class C>
+struct StrColumnRangeValue<
+    C, std::void_t<decltype(std::data(std::declval<const C&>())),
+                   decltype(std::size(std::declval<const C&>()))>> {
+  using type = std::remove_cv_t<std::remove_reference_t<decltype(
+      *std::data(std::declval<const C&>()))>>;
+};
+
+/// true when C is a contiguous range of values (and not a value itself)
+template <class C>
+constexpr bool kIsStrColumnRange =
+    !kIsStrColumnValue<C> &&
+    kIsStrColumnValue<typename StrColumnRangeValue<C>::type>;
+
+/// @return The value of \a column at \a row (the column itself if it's a
+///         value, repeated on each row)
+template <class C>
+constexpr auto StrColumnAt(const C& column, std::size_t row) noexcept
+    -> decltype(auto) {
+  if constexpr (kIsStrColumnRange<C>) {
+    return std::data(column)[row];
+  } else {
+    static_cast<void>(row);
+    return column;
+  }
+}
+
+template <class T>
+auto StrColumnValueSize(const T& value) noexcept -> std::size_t {
+  if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    return std::string_view{value}.size();
+  } else if constexpr (kIsStrColumnInteger<T>) {
+    return StrIntegerSize(value);
+  } else {
+    return StrPiece{value}.Size();
+  }
+}
+
+/// @return One past the last char of \a value written into \a d_first
+template <class T>
+auto StrColumnValueWrite(const T& value, char* d_first) noexcept -> char* {
+  if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    const std::string_view str{value};
+    return std::copy_n(str.data(), str.size(), d_first);
+  } else if constexpr (kIsStrColumnInteger<T>) {
+    return std::to_chars(d_first, d_first + StrIntegerSize(value), value).ptr;
+  } else {
+    const StrPiece piece{value};
+    return std::copy_n(piece.View().data(), piece.Size(), d_first);
+  }
+}
+
+/// @brief Add the size of the rows [first, last) of \a column to \a d_sizes
+template <class C>
+auto StrColumnAddSizes(const C& column, std::size_t first, std::size_t last,
+                       std::size_t* d_sizes) noexcept -> void {
+  for (std::size_t row = first; row < last; ++row) {
+    d_sizes[row - first] += StrColumnValueSize(StrColumnAt(column, row));
+  }
+}
+
+/// @return The number of rows of the \a columns ranges
+/// @throw std::invalid_argument When the ranges have different sizes
+template <class... Columns>
+auto StrColumnsRows(const Columns&... columns) -> std::size_t {
+  constexpr std::size_t kUnknown = std::numeric_limits<std::size_t>::max();
+  std::size_t rows = kUnknown;
+
+  const auto check = [&rows](const auto& column) {
+    using C = std::decay_t<decltype(column)>;
+    if constexpr (kIsStrColumnRange<C>) {
+      const std::size_t size = std::size(column);
+      if ((rows != kUnknown) && (rows != size)) {
+        throw std::invalid_argument(
+            "StrCatColumns: the columns have different sizes");
+      }
+      rows = size;
+    }
+  };
+  (check(columns), ...);
+
+  return rows;
+}
+
+}  // namespace details
+
+/// Minimum number of rows handled by each thread of StrCatColumnsParallel()
+constexpr std::size_t kStrColumnsRowsPerThread = 4096;
+
+/**
+ * @brief Same as StrCatColumns(), using up to \a threads_count threads, each
+ *        one handling a range of rows
+ *
+ * @param[in] threads_count The maximum number of threads used (including the
+ *                          calling one). At least kStrColumnsRowsPerThread
+ *                          rows are given to each thread.
+ * @param[in] columns Columns concatenated (see StrCatColumns())
+ *
+ * @throw std::invalid_argument When the ranges have different sizes
+ */
+template <class... Columns>
+auto StrCatColumnsParallel(std::size_t threads_count,
+                           const Columns&... columns) -> StrColumn {
+  static_assert(((details::kIsStrColumnValue<Columns> ||
+                  details::kIsStrColumnRange<Columns>) && ...),
+                "StrCatColumns: columns must be strings, chars, bools, numbers "
+                "or contiguous ranges of them");
+  static_assert((details::kIsStrColumnRange<Columns> || ...),
+                "StrCatColumns: at least one column must be a range");
+
+  const std::size_t rows = details::StrColumnsRows(columns...);
+  const std::size_t ranges = std::max<std::size_t>(
+      1, std::min(threads_count, rows / kStrColumnsRowsPerThread));
+
+  StrColumn column;
+  column.offsets.assign(rows + 1, 0);
+
+  // Each range of rows is handled by a thread (the calling one handles the
+  // first one, and the ones whose thread couldn't be started)
+  const auto first_row = [rows, ranges](std::size_t range) {
+    return (rows / ranges) * range + std::min(range, rows % ranges);
+  };
+  const auto for_each_range = [&ranges](const auto& f) {
+    std::vector<std::thread> threads;
+    ScopeExit join_threads{[&threads]() noexcept {
+      for (auto& thread : threads) thread.join();
+    }};
+
+    std::size_t started = 1;
+    try {
+      threads.reserve(ranges - 1);
+      for (; started < ranges; ++started) threads.emplace_back(f, started);
+    } catch (...) {
+      // std::system_error/std::bad_alloc: too many threads
+    }
+
+    f(0);
+    for (std::size_t i = started; i < ranges; ++i) f(i);
+  };
+
+  // 1st pass, column by column: sizes of the rows (offsets[row + 1]), then
+  // their sum relative to the start of the range
+  std::vector<std::size_t> bases(ranges + 1, 0);
+  for_each_range([&](std::size_t range) noexcept {
+    const std::size_t first = first_row(range);
+    const std::size_t last = first_row(range + 1);
+    std::size_t* sizes = column.offsets.data() + first + 1;
+
+    (details::StrColumnAddSizes(columns, first, last, sizes), ...);
+    for (std::size_t i = 1; i < (last - first); ++i) sizes[i] += sizes[i - 1];
+    bases[range + 1] = (last > first) ? sizes[last - first - 1] : 0;
+  });
+
+  for (std::size_t i = 1; i <= ranges; ++i) bases[i] += bases[i - 1];
+  column.data.resize(bases.back());
+
+  // 2nd pass, row by row: offsets made absolute, and rows written
+  for_each_range([&](std::size_t range) noexcept {
+    const std::size_t first = first_row(range);
+    const std::size_t last = first_row(range + 1);
+
+    char* d_first = column.data.data() + bases[range];
+    for (std::size_t row = first; row < last; ++row) {
+      ((d_first = details::StrColumnValueWrite(
+            details::StrColumnAt(columns, row), d_first)),
+       ...);
+      column.offsets[row + 1] += bases[range];
+    }
+  });
+
+  return column;
+}
+
+/**
+ * @brief Concatenate, row by row, the values of \a columns into a StrColumn
+ *        (i.e. building the lines of a CSV export) using a single allocation
+ *
+ * Each column is either:
+ * - A contiguous range (std::vector, std::array, C array, ...) of strings,
+ *   chars, bools or numbers, one value per row;
+ * - A single string, char, bool or number, repeated on each row (i.e. a
+ *   separator). std::string are values, NOT ranges of chars.
+ *
+ * Rows are built in 2 passes:
+ * - The sizes of the rows are computed column by column (integers sizes are
+ *   computed without formatting them, from their number of bits and a single
+ *   comparison with a power of 10: not vectorized, 64 bits compares need
+ *   AVX-512/SSE4.2);
+ * - Then each row is written at its offset into the buffer, allocated once.
+ *
+ * @code{.cpp}
+ * const std::vector<std::string_view> names = {"foo", "bar"};
+ * const std::vector<int> ids = {1, 42};
+ *
+ * const StrColumn csv = StrCatColumns(names, ',', ids, '\n');
+ * assert(csv.data == "foo,1\nbar,42\n");
+ * assert(csv[1] == "bar,42\n");
+ * @endcode
+ *
+ * @note Floating points, chars and bools are formatted using StrPiece (twice:
+ *       once per pass)
+ *
+ * @throw std::invalid_argument When the ranges have different sizes
+ */
+template <class... Columns>
+auto StrCatColumns(const Columns&... columns) -> StrColumn {
+  return StrCatColumnsParallel(1, columns...);
+}
+
+}  // namespace atb
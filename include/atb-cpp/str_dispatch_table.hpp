@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <functional>  // std::hash
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>  // std::forward
+#include <vector>
+
+#include "atb-cpp/matchers.hpp"
+
+namespace atb {
+
+/**
+ * @brief Reusable string switch, built once from (matcher, value) cases and
+ *        queried many times
+ *
+ * It offers the same semantic as StrSwitch (the value of the FIRST case
+ * matching is returned) but, contrary to StrSwitch, the cases are stored and
+ * can be built at runtime (from a config file, ...) once and for all.
+ *
+ * In order to speed up the lookups, the cases are partitioned:
+ * - Exact literals (any case whose 'matcher' is convertible to a
+ *   std::string_view) are stored into a hash index;
+ * - All the other matchers are kept, in order, as AnyMatcher.
+ *
+ * A lookup first probes the literal index, then only evaluates the generic
+ * matchers defined BEFORE the literal found (if any), preserving the
+ * first-match-wins semantic.
+ *
+ * @code{.cpp}
+ * StrDispatchTable<int> table;
+ * table.Case("foo", 1)
+ *      .Case(StrStartsWith("ba"), 2)
+ *      .Case("bar", 3);  // Never reached: shadowed by StrStartsWith("ba")
+ *
+ * assert(table.FindOr("foo", -1) == 1);
+ * assert(table.FindOr("bar", -1) == 2);
+ * assert(table.FindOr("baz", -1) == 2);
+ * assert(table.FindOr("toto", -1) == -1);
+ * @endcode
+ *
+ * @note Lookups (Find/FindOr/IsMatching) don't allocate and are safe to call
+ *       concurrently (as long as the matchers themselves are, i.e. do not use
+ *       the d_where out-parameters). Adding cases is NOT thread safe.
+ *
+ * @note Literals are copied into the table (they don't need to outlive it)
+ *
+ * @tparam R Type of the value returned by the table
+ */
+template <class R>
+class StrDispatchTable final {
+ public:
+  /// Default ctor (no cases)
+  StrDispatchTable() = default;
+
+  /**
+   * @brief Add a new case to the table
+   *
+   * @param[in] m Either a string-like literal (exact match) or any matcher
+   *              accepting a std::string_view (see matchers.hpp)
+   * @param[in] value The value returned when \a m is the first case matching
+   */
+  template <class Matcher, class T>
+  auto Case(Matcher&& m, T&& value) -> StrDispatchTable& {
+    const std::size_t order = m_values.size();
+    m_values.emplace_back(std::forward<T>(value));
+
+    if constexpr (std::is_constructible_v<std::string_view,
+                                          std::decay_t<Matcher>>) {
+      InsertLiteral(std::string_view{std::forward<Matcher>(m)}, order);
+    } else {
+      m_matchers.push_back(Generic{
+          AnyMatcher<std::string_view>{std::forward<Matcher>(m)},
+          order,
+      });
+    }
+
+    return *this;
+  }
+
+  /**
+   * @return A pointer to the value of the FIRST case matching \a str. nullptr
+   *         when none are matching.
+   */
+  auto Find(std::string_view str) const -> const R* {
+    const std::size_t literal = FindLiteral(str);
+
+    for (const auto& generic : m_matchers) {
+      if (generic.order > literal) break;
+      if (::IsMatching(generic.matcher, str)) return &m_values[generic.order];
+    }
+
+    return (literal != npos) ? &m_values[literal] : nullptr;
+  }
+
+  /**
+   * @return The value of the FIRST case matching \a str, or \a default_value
+   *         when none are matching
+   */
+  template <class T>
+  auto FindOr(std::string_view str, T&& default_value) const -> R {
+    if (const auto value = Find(str); value != nullptr) return *value;
+    return R(std::forward<T>(default_value));
+  }
+
+  /**
+   * @brief Mandatory matcher interface (see matchers.hpp)
+   *
+   * @return true whenever one of the cases matches \a str
+   */
+  auto IsMatching(std::string_view str) const -> bool {
+    return Find(str) != nullptr;
+  }
+
+  /// @return The number of cases
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+  /// @return The number of cases that are not exact literals
+  auto GenericCount() const noexcept -> std::size_t {
+    return m_matchers.size();
+  }
+
+ private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct Literal {
+    std::string key;
+    std::size_t order = npos;
+  };
+
+  struct Generic {
+    AnyMatcher<std::string_view> matcher;
+    std::size_t order;
+  };
+
+  auto FindLiteral(std::string_view str) const noexcept -> std::size_t {
+    if (m_literals.empty()) return npos;
+
+    const std::size_t mask = m_literals.size() - 1;
+    for (std::size_t i = std::hash<std::string_view>{}(str) & mask;;
+         i = (i + 1) & mask) {
+      const auto& slot = m_literals[i];
+      if (slot.order == npos) return npos;
+      if (slot.key == str) return slot.order;
+    }
+  }
+
+  auto InsertLiteral(std::string_view key, std::size_t order) -> void {
+    // Keep the load factor <= 1/2
+    if (2 * (m_literals_count + 1) > m_literals.size()) {
+      std::vector<Literal> old(m_literals.empty() ? 8 : 2 * m_literals.size());
+      old.swap(m_literals);
+      for (auto& slot : old) {
+        if (slot.order != npos) Emplace(std::move(slot.key), slot.order);
+      }
+    }
+
+    // Keep the first case for duplicated literals
+    if (FindLiteral(key) == npos) {
+      Emplace(std::string{key}, order);
+      ++m_literals_count;
+    }
+  }
+
+  auto Emplace(std::string key, std::size_t order) -> void {
+    const std::size_t mask = m_literals.size() - 1;
+    std::size_t i = std::hash<std::string_view>{}(key) & mask;
+    while (m_literals[i].order != npos) i = (i + 1) & mask;
+    m_literals[i] = Literal{std::move(key), order};
+  }
+
+  std::vector<R> m_values;            /*!< Values, by case order */
+  std::vector<Literal> m_literals;    /*!< Open addressing hash table */
+  std::size_t m_literals_count = 0;   /*!< Number of literals stored */
+  std::vector<Generic> m_matchers;    /*!< Generic matchers, by case order */
+};
+
+}  // namespace atb
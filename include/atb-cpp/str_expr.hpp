@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>  // std::copy_n
+#include <cstddef>    // std::size_t
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>  // std::move, std::forward
+
+#include "atb-cpp/format.hpp"  // StrPiece
+#include "atb-cpp/tuple.hpp"
+
+namespace atb {
+
+template <class... Pieces>
+class StrExpr;
+
+namespace details {
+
+template <class T>
+struct IsStrExpr : std::false_type {};
+
+template <class... Pieces>
+struct IsStrExpr<StrExpr<Pieces...>> : std::true_type {};
+
+/// true when T can be a piece of a StrExpr: strings, chars, bools, numbers
+template <class T, class D = std::decay_t<T>>
+constexpr bool kIsStrExprPiece =
+    !IsStrExpr<D>::value &&
+    (std::is_convertible_v<const D&, std::string_view> ||
+     std::is_arithmetic_v<D>);
+
+/**
+ * @return The piece stored by a StrExpr for \a value:
+ * - std::string rvalues are moved (owned by the expression);
+ * - StrPiece are copied (they may hold their chars inline);
+ * - Other strings are viewed (std::string_view);
+ * - Chars, bools and numbers are formatted into a StrPiece.
+ */
+template <class T>
+auto MakeStrExprPiece(T&& value) {
+  using D = std::decay_t<T>;
+  if constexpr (std::is_same_v<D, std::string> &&
+                !std::is_lvalue_reference_v<T>) {
+    return std::string{std::move(value)};
+  } else if constexpr (std::is_same_v<D, StrPiece>) {
+    return StrPiece{value};
+  } else if constexpr (std::is_convertible_v<const D&, std::string_view>) {
+    return std::string_view{value};
+  } else {
+    return StrPiece{value};
+  }
+}
+
+template <class... Pieces>
+auto MakeStrExpr(std::tuple<Pieces...>&& pieces) -> StrExpr<Pieces...> {
+  return StrExpr<Pieces...>{std::move(pieces)};
+}
+
+}  // namespace details
+
+/**
+ * @brief Lazy concatenation of strings, chars, bools and numbers
+ *
+ * Concatenating with `operator+` only builds a new std::tuple of pieces (the
+ * type of the expression grows at compile time). Nothing is written until the
+ * expression is materialized, using a single exact allocation: converted to a
+ * std::string, appended to one (AppendTo()) or copied into a buffer
+ * (CopyTo()).
+ *
+ * Expressions can be returned by helper functions and concatenated with each
+ * other without allocating at every level:
+ *
+ * @code{.cpp}
+ * auto Endpoint(std::string_view host, int port) {
+ *   return StrLazyCat(host, ':', port);
+ * }
+ *
+ * auto Url(std::string_view host, int port, std::string_view path) {
+ *   return "http://" + Endpoint(host, port) + path;
+ * }
+ *
+ * std::string url = Url("localhost", 8080, "/index.html");  // 1 allocation
+ * @endcode
+ *
+ * @important Strings are only viewed (except std::string rvalues, moved into
+ *            the expression): they must outlive the expression
+ *
+ * @tparam Pieces... std::string_view, std::string or StrPiece
+ */
+template <class... Pieces>
+class StrExpr final {
+ public:
+  /// Default ctor: empty expression
+  StrExpr() = default;
+
+  explicit StrExpr(std::tuple<Pieces...> pieces) noexcept(
+      std::is_nothrow_move_constructible_v<std::tuple<Pieces...>>)
+      : m_pieces(std::move(pieces)) {}
+
+  /// @return The pieces of the expression
+  auto AsTuple() const& noexcept -> const std::tuple<Pieces...>& {
+    return m_pieces;
+  }
+  auto AsTuple() && noexcept -> std::tuple<Pieces...>&& {
+    return std::move(m_pieces);
+  }
+
+  /// @return The size of the materialized string
+  auto Size() const noexcept -> std::size_t {
+    return tpl::Reduce(
+        std::size_t{0},
+        [](std::size_t size, const auto& piece) {
+          return size + std::string_view{piece}.size();
+        },
+        m_pieces);
+  }
+
+  /**
+   * @brief Copy the expression into the buffer \a d_first of \a d_size chars
+   *
+   * @return One past the last char written. std::nullopt when the buffer is
+   *         too small (nothing is written)
+   */
+  auto CopyTo(char* d_first, std::size_t d_size) const noexcept
+      -> std::optional<char*> {
+    if (Size() > d_size) return std::nullopt;
+    return CopyToUnsafe(d_first);
+  }
+
+  /**
+   * @brief Append the expression to \a d_str, with a single resize
+   *
+   * @important The expression must NOT view \a d_str
+   *
+   * @return The number of chars appended
+   */
+  auto AppendTo(std::string& d_str) const -> std::size_t {
+    const std::size_t size = Size();
+    const std::size_t old_size = d_str.size();
+    d_str.resize(old_size + size);
+    CopyToUnsafe(d_str.data() + old_size);
+    return size;
+  }
+
+  /// @return The materialized string
+  auto ToString() const -> std::string {
+    std::string str;
+    AppendTo(str);
+    return str;
+  }
+
+  operator std::string() const { return ToString(); }
+
+  // Concatenations ////////////////////////////////////////////////////////
+
+  template <class T, std::enable_if_t<details::kIsStrExprPiece<T>, bool> = true>
+  friend auto operator+(const StrExpr& lhs, T&& rhs) {
+    return details::MakeStrExpr(std::tuple_cat(
+        lhs.m_pieces,
+        std::make_tuple(details::MakeStrExprPiece(std::forward<T>(rhs)))));
+  }
+
+  template <class T, std::enable_if_t<details::kIsStrExprPiece<T>, bool> = true>
+  friend auto operator+(StrExpr&& lhs, T&& rhs) {
+    return details::MakeStrExpr(std::tuple_cat(
+        std::move(lhs.m_pieces),
+        std::make_tuple(details::MakeStrExprPiece(std::forward<T>(rhs)))));
+  }
+
+  template <class T, std::enable_if_t<details::kIsStrExprPiece<T>, bool> = true>
+  friend auto operator+(T&& lhs, const StrExpr& rhs) {
+    return details::MakeStrExpr(std::tuple_cat(
+        std::make_tuple(details::MakeStrExprPiece(std::forward<T>(lhs))),
+        rhs.m_pieces));
+  }
+
+  template <class T, std::enable_if_t<details::kIsStrExprPiece<T>, bool> = true>
+  friend auto operator+(T&& lhs, StrExpr&& rhs) {
+    return details::MakeStrExpr(std::tuple_cat(
+        std::make_tuple(details::MakeStrExprPiece(std::forward<T>(lhs))),
+        std::move(rhs.m_pieces)));
+  }
+
+ private:
+  auto CopyToUnsafe(char* d_first) const noexcept -> char* {
+    tpl::Visit(
+        [&d_first](const auto& piece) {
+          const std::string_view str{piece};
+          d_first = std::copy_n(str.data(), str.size(), d_first);
+        },
+        m_pieces);
+    return d_first;
+  }
+
+  std::tuple<Pieces...> m_pieces;
+};
+
+/// @return The concatenation of the expressions \a lhs and \a rhs
+template <class Lhs, class Rhs,
+          std::enable_if_t<details::IsStrExpr<std::decay_t<Lhs>>::value &&
+                               details::IsStrExpr<std::decay_t<Rhs>>::value,
+                           bool> = true>
+auto operator+(Lhs&& lhs, Rhs&& rhs) {
+  return details::MakeStrExpr(std::tuple_cat(std::forward<Lhs>(lhs).AsTuple(),
+                                             std::forward<Rhs>(rhs).AsTuple()));
+}
+
+/**
+ * @return A StrExpr of all \a pieces (strings, chars, bools or numbers)
+ *
+ * @note Same as StrCat(), but lazy (see StrExpr)
+ */
+template <class... T,
+          std::enable_if_t<(details::kIsStrExprPiece<T> && ...), bool> = true>
+auto StrLazyCat(T&&... pieces) {
+  return details::MakeStrExpr(
+      std::make_tuple(details::MakeStrExprPiece(std::forward<T>(pieces))...));
+}
+
+}  // namespace atb
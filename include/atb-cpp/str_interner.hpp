@@ -0,0 +1,361 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <functional>  // std::hash
+#include <memory>      // std::unique_ptr
+#include <mutex>
+#include <new>  // placement new
+#include <optional>
+#include <stdexcept>  // std::length_error
+#include <string_view>
+#include <utility>  // std::pair, std::move
+#include <vector>
+
+#include "atb-cpp/arena.hpp"
+
+namespace atb {
+
+/// Identifier of a string interned into a StrInterner
+using StrId = std::uint32_t;
+
+/**
+ * @brief Handle to a string interned into a StrInterner
+ *
+ * Since each string is stored only once by its interner, two handles coming
+ * from the SAME interner are equal if, and only if, their ids are equal:
+ * comparisons are O(1), whatever the size of the strings.
+ *
+ * @code{.cpp}
+ * StrInterner interner;
+ * const auto cpu = interner.Intern("cpu.usage");
+ *
+ * assert(cpu == interner.Intern("cpu.usage"));  // Compare ids only
+ * assert(::IsMatching(Eq(cpu), interner.Intern("cpu.usage")));
+ *
+ * int metric = StrSwitch<int>(cpu.View())
+ *                  .Case(cpu, 0)  // O(1) when the input is interned
+ *                  .Case(StrStartsWith("mem."), 1)
+ *                  .Default(-1);
+ * @endcode
+ *
+ * @important Handles are only valid as long as their interner is alive
+ */
+class InternedStr final {
+ public:
+  /// Id of default constructed (invalid) handles
+  static constexpr StrId kInvalidId = static_cast<StrId>(-1);
+
+  /// Default ctor: invalid handle
+  constexpr InternedStr() noexcept = default;
+
+  /// @return The id of the string (unique within its interner)
+  constexpr auto Id() const noexcept -> StrId { return m_id; }
+
+  /// @return A view to the string interned (stable for the interner lifetime)
+  constexpr auto View() const noexcept -> std::string_view { return m_view; }
+
+  /// @return true when the handle refers to an interned string
+  constexpr auto IsValid() const noexcept -> bool {
+    return m_id != kInvalidId;
+  }
+
+  /**
+   * @brief Matcher interface (see matchers.hpp): true whenever \a str is the
+   *        same string as this one
+   *
+   * @note When \a str is a view on the interned string itself (obtained
+   *       through View()), this is a O(1) pointer comparison
+   */
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return ((str.data() == m_view.data()) && (str.size() == m_view.size())) ||
+           (str == m_view);
+  }
+
+  /// @brief Matcher interface (see matchers.hpp): compare ids only
+  constexpr auto IsMatching(const InternedStr& other) const noexcept -> bool {
+    return m_id == other.m_id;
+  }
+
+  friend constexpr auto operator==(const InternedStr& lhs,
+                                   const InternedStr& rhs) noexcept -> bool {
+    return lhs.m_id == rhs.m_id;
+  }
+
+  friend constexpr auto operator!=(const InternedStr& lhs,
+                                   const InternedStr& rhs) noexcept -> bool {
+    return lhs.m_id != rhs.m_id;
+  }
+
+  /// Order by id (i.e. by interning order, NOT lexicographically)
+  friend constexpr auto operator<(const InternedStr& lhs,
+                                  const InternedStr& rhs) noexcept -> bool {
+    return lhs.m_id < rhs.m_id;
+  }
+
+ private:
+  friend class StrInterner;
+
+  constexpr InternedStr(StrId id, std::string_view view) noexcept
+      : m_id(id), m_view(view) {}
+
+  StrId m_id = kInvalidId;
+  std::string_view m_view;
+};
+
+/**
+ * @brief Thread safe string interning pool
+ *
+ * Each distinct string is copied once into a monotonic arena and associated
+ * to a small integer id (ids are dense, starting at 0, by insertion order).
+ * The handles returned (InternedStr) are stable for the interner lifetime and
+ * compare in O(1).
+ *
+ * Concurrency:
+ * - Lookups (Find(), Get() and the lookup part of Intern()) are lock free: the
+ *   hash tables are published through atomic pointers and never modified in
+ *   place once visible (growing a table publishes a new one, the old one is
+ *   kept alive until destruction);
+ * - Insertions are serialized per shard: strings are spread over kShardsCount
+ *   shards (using their hash), each having its own mutex, hash table and
+ *   arena. Concurrent insertions of different strings rarely contend.
+ *
+ * @code{.cpp}
+ * StrInterner interner;
+ *
+ * const InternedStr foo = interner.Intern("foo");
+ * assert(foo.Id() == 0);
+ * assert(foo.View() == "foo");
+ * assert(interner.Intern(std::string{"foo"}) == foo);
+ * assert(interner.Find("foo") == foo);
+ * assert(!interner.Find("bar").has_value());
+ * assert(interner.Get(foo.Id()) == foo);
+ * @endcode
+ *
+ * @note Strings are never removed (the memory is released on destruction)
+ */
+class StrInterner final {
+ public:
+  /// Number of shards (insertion locks)
+  static constexpr std::size_t kShardsCount = 16;
+
+  /**
+   * @brief Construct an empty interner
+   *
+   * @param[in] block_size Size of the blocks allocated by each shard arena
+   */
+  explicit StrInterner(
+      std::size_t block_size = MonotonicArena::kDefaultBlockSize) {
+    for (auto& shard : m_shards) shard.arena = MonotonicArena(block_size);
+  }
+
+  /// Not copyable/movable (handles point into it)
+  StrInterner(const StrInterner&) = delete;
+  StrInterner(StrInterner&&) = delete;
+  auto operator=(const StrInterner&) -> StrInterner& = delete;
+  auto operator=(StrInterner&&) -> StrInterner& = delete;
+
+  ~StrInterner() noexcept {
+    for (auto& segment : m_segments) delete[] segment.load();
+  }
+
+  /**
+   * @return The handle of \a str, interning it when seen for the first time
+   *
+   * @throw std::length_error When all ids are exhausted
+   */
+  auto Intern(std::string_view str) -> InternedStr {
+    const std::size_t hash = std::hash<std::string_view>{}(str);
+    Shard& shard = ShardOf(hash);
+
+    if (const auto entry = Lookup(shard, hash, str); entry != nullptr) {
+      return InternedStr{entry->id, entry->view};
+    }
+
+    std::lock_guard lock{shard.mutex};
+
+    // An other thread may have inserted it in between
+    if (const auto entry = Lookup(shard, hash, str); entry != nullptr) {
+      return InternedStr{entry->id, entry->view};
+    }
+
+    return Insert(shard, hash, str);
+  }
+
+  /**
+   * @return The handle of \a str, if already interned (never inserts)
+   *
+   * @note Strings being interned concurrently may not be found
+   */
+  auto Find(std::string_view str) const noexcept -> std::optional<InternedStr> {
+    const std::size_t hash = std::hash<std::string_view>{}(str);
+    if (const auto entry = Lookup(ShardOf(hash), hash, str); entry != nullptr) {
+      return InternedStr{entry->id, entry->view};
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @return The handle of the string whose id is \a id
+   *
+   * @pre \a id has been returned by this interner
+   */
+  auto Get(StrId id) const noexcept -> InternedStr {
+    const auto [segment, offset] = SegmentOf(id);
+    const Entry* entry =
+        m_segments[segment].load(std::memory_order_acquire)[offset].load(
+            std::memory_order_acquire);
+    return InternedStr{entry->id, entry->view};
+  }
+
+  /// @return The number of strings interned
+  auto Size() const noexcept -> std::size_t {
+    return m_next_id.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Entry {
+    std::size_t hash;
+    StrId id;
+    std::string_view view;
+  };
+
+  using Slot = std::atomic<const Entry*>;
+
+  struct Table {
+    explicit Table(std::size_t size) : mask(size - 1), slots(new Slot[size]()) {}
+
+    std::size_t mask;              /*!< Size - 1 (size is a power of 2) */
+    std::unique_ptr<Slot[]> slots; /*!< Open addressing slots */
+  };
+
+  struct alignas(64) Shard {
+    std::mutex mutex;                           /*!< Insertion lock */
+    std::atomic<const Table*> table{nullptr};   /*!< Current table */
+    std::vector<std::unique_ptr<Table>> tables; /*!< Current + retired ones */
+    std::size_t count = 0;                      /*!< Entries stored */
+    MonotonicArena arena;                       /*!< Entries and strings */
+  };
+
+  // Ids directory: segment s holds (kFirstSegmentSize << s) entries, hence
+  // segments never move once allocated
+  static constexpr unsigned kFirstSegmentBits = 10;
+  static constexpr std::size_t kFirstSegmentSize = std::size_t{1}
+                                                   << kFirstSegmentBits;
+  static constexpr std::size_t kSegmentsCount = 32 - kFirstSegmentBits + 1;
+
+  static auto SegmentOf(StrId id) noexcept
+      -> std::pair<unsigned, std::uint64_t> {
+    const std::uint64_t v = std::uint64_t{id} + kFirstSegmentSize;
+    unsigned high = 0;
+    for (auto u = v; u > 1u; u >>= 1) ++high;
+    return {high - kFirstSegmentBits, v - (std::uint64_t{1} << high)};
+  }
+
+  auto ShardOf(std::size_t hash) noexcept -> Shard& {
+    return m_shards[hash % kShardsCount];
+  }
+
+  auto ShardOf(std::size_t hash) const noexcept -> const Shard& {
+    return m_shards[hash % kShardsCount];
+  }
+
+  static auto Lookup(const Shard& shard, std::size_t hash,
+                     std::string_view str) noexcept -> const Entry* {
+    const Table* table = shard.table.load(std::memory_order_acquire);
+    if (table == nullptr) return nullptr;
+
+    for (std::size_t i = (hash / kShardsCount) & table->mask;;
+         i = (i + 1) & table->mask) {
+      const Entry* entry = table->slots[i].load(std::memory_order_acquire);
+      if (entry == nullptr) return nullptr;
+      if ((entry->hash == hash) && (entry->view == str)) return entry;
+    }
+  }
+
+  static auto Emplace(const Table& table, const Entry* entry) noexcept
+      -> void {
+    std::size_t i = (entry->hash / kShardsCount) & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1) & table.mask;
+    }
+    table.slots[i].store(entry, std::memory_order_release);
+  }
+
+  /// @pre shard.mutex is locked and str isn't part of the shard
+  auto Insert(Shard& shard, std::size_t hash, std::string_view str)
+      -> InternedStr {
+    // Keep the load factor <= 1/2: publish a bigger table, the old one may
+    // still be used by readers
+    const Table* table = shard.table.load(std::memory_order_relaxed);
+    if ((table == nullptr) || (2 * (shard.count + 1) > (table->mask + 1))) {
+      auto grown = std::make_unique<Table>(
+          (table == nullptr) ? 16 : 2 * (table->mask + 1));
+      if (table != nullptr) {
+        for (std::size_t i = 0; i <= table->mask; ++i) {
+          const Entry* entry = table->slots[i].load(std::memory_order_relaxed);
+          if (entry != nullptr) Emplace(*grown, entry);
+        }
+      }
+
+      shard.tables.push_back(std::move(grown));
+      table = shard.tables.back().get();
+      shard.table.store(table, std::memory_order_release);
+    }
+
+    const StrId id = NewId();
+    auto* entry = new (shard.arena.Allocate(sizeof(Entry), alignof(Entry)))
+        Entry{hash, id, shard.arena.Copy(str)};
+
+    // Ids must be resolvable (Get()) before the entry can be found
+    DirectorySlot(id).store(entry, std::memory_order_release);
+    Emplace(*table, entry);
+    ++shard.count;
+
+    return InternedStr{id, entry->view};
+  }
+
+  auto NewId() -> StrId {
+    StrId id = m_next_id.load(std::memory_order_relaxed);
+    do {
+      if (id == InternedStr::kInvalidId) {
+        throw std::length_error("StrInterner: ids exhausted");
+      }
+    } while (!m_next_id.compare_exchange_weak(id, id + 1,
+                                              std::memory_order_acq_rel));
+    return id;
+  }
+
+  auto DirectorySlot(StrId id) -> Slot& {
+    const auto [segment, offset] = SegmentOf(id);
+
+    Slot* slots = m_segments[segment].load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      std::lock_guard lock{m_segments_mutex};
+      slots = m_segments[segment].load(std::memory_order_relaxed);
+      if (slots == nullptr) {
+        slots = new Slot[kFirstSegmentSize << segment]();
+        m_segments[segment].store(slots, std::memory_order_release);
+      }
+    }
+
+    return slots[offset];
+  }
+
+  std::array<Shard, kShardsCount> m_shards; /*!< Sharded hash tables */
+  std::array<std::atomic<Slot*>, kSegmentsCount> m_segments = {}; /*!< Ids */
+  std::mutex m_segments_mutex;     /*!< Segments allocation lock */
+  std::atomic<StrId> m_next_id{0}; /*!< Next id given */
+};
+
+}  // namespace atb
+
+/// Hash of an InternedStr (its id), i.e. to be used as key of unordered maps
+template <>
+struct std::hash<atb::InternedStr> {
+  auto operator()(const atb::InternedStr& str) const noexcept -> std::size_t {
+    return std::hash<atb::StrId>{}(str.Id());
+  }
+};
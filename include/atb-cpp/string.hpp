@@ -1,14 +1,23 @@
 #pragma once
 
-#include <algorithm>  // std::copy_n
+#include <algorithm>  // std::copy, std::copy_n
+#include <array>
 #include <cstddef>    // std::size_t
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>  // std::begin/end
 #include <limits>  // std::numeric_limits
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>  // std::pair
+#include <vector>
 
+#include "atb-cpp/aho_corasick.hpp"
+#include "atb-cpp/ascii.hpp"
+#include "atb-cpp/char_set.hpp"
 #include "atb-cpp/matchers.hpp"
+#include "atb-cpp/searcher.hpp"
 
 namespace atb {
 
@@ -181,6 +190,268 @@ inline auto StrCat(std::initializer_list<std::string_view> strings)
   return std::nullopt;
 }
 
+// STRINGS REPLACE /////////////////////////////////////////////////////////////
+
+/**
+ * @brief Precompiled set of replacements, applied in a single scan
+ *
+ * The patterns to replace are compiled once, using the same searchers as the
+ * matchers: a StrSearcher (see searcher.hpp) for a single pattern, an
+ * AhoCorasick automaton (see aho_corasick.hpp) for several ones (only started
+ * on bytes found by a CharSet of the patterns first bytes, which is enough
+ * when all patterns are single bytes). The input is then scanned only once
+ * for all patterns, from left to right:
+ * - At a given location, the LONGEST pattern wins (the first one declared for
+ *   duplicated patterns);
+ * - Replacements never overlap and are never re-scanned.
+ *
+ * Replacing is done in 2 passes: the first one only computes the final size,
+ * the second copies the segments into a string allocated exactly once.
+ *
+ * @code{.cpp}
+ * const StrReplacer escape({{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}});
+ * assert(escape.Replace("a < b & c").value() == "a &lt; b &amp; c");
+ * @endcode
+ *
+ * @important The replacements are stored as string_view, the underlying
+ *            string-like referenced NEEDS to outlive the replacer lifetime.
+ *
+ * @note Empty patterns are ignored
+ */
+class StrReplacer final {
+ public:
+  /// A single replacement: {from, to}
+  using Replacement = std::pair<std::string_view, std::string_view>;
+
+  /// Construct a replacer from a range of Replacement
+  template <class Range>
+  explicit StrReplacer(const Range& replacements) {
+    Build(std::begin(replacements), std::end(replacements));
+  }
+
+  /// Construct a replacer from a list of \a replacements
+  explicit StrReplacer(std::initializer_list<Replacement> replacements) {
+    Build(replacements.begin(), replacements.end());
+  }
+
+  /// @return true when at least one replacement is longer than its pattern
+  auto Grows() const noexcept -> bool { return m_grows; }
+
+  /// @return The number of replacements done on \a str
+  auto Count(std::string_view str) const noexcept -> std::size_t {
+    std::size_t count = 0;
+    ForEachMatch(str, [&count](std::size_t, std::size_t) noexcept { ++count; });
+    return count;
+  }
+
+  /**
+   * @return The size of \a str once replaced. std::nullopt if it would
+   *         overflow.
+   */
+  auto ReplacedSize(std::string_view str) const noexcept
+      -> std::optional<std::size_t> {
+    std::size_t removed = 0;
+    std::size_t added = 0;
+    ForEachMatch(str, [&](std::size_t, std::size_t r) noexcept {
+      removed += m_replacements[r].first.size();
+      added += m_replacements[r].second.size();
+    });
+
+    const std::size_t kept = str.size() - removed;
+    if (kept > std::numeric_limits<std::size_t>::max() - added) {
+      return std::nullopt;
+    }
+    return kept + added;
+  }
+
+  /**
+   * @return A copy of \a str with all patterns replaced. std::nullopt if the
+   *         result would overflow.
+   */
+  auto Replace(std::string_view str) const -> std::optional<std::string> {
+    std::string d_str;
+    if (!ReplaceInto(str, d_str)) return std::nullopt;
+    return d_str;
+  }
+
+  /**
+   * @brief Replace all patterns of \a d_str, in place
+   *
+   * When no replacement grows (see Grows()), this is done without any
+   * allocation by compacting \a d_str. Otherwise, it is replaced into a new
+   * string (allocated once) swapped with \a d_str.
+   *
+   * @important The replacements MUST NOT contain a ref to \a d_str
+   *
+   * @return The number of replacements done. std::nullopt if the operation
+   *         would overflow (\a d_str is untouched in that case).
+   */
+  auto ReplaceInPlace(std::string& d_str) const -> std::optional<std::size_t> {
+    if (m_grows) {
+      std::string replaced;
+      const auto count = ReplaceInto(d_str, replaced);
+      if (count) d_str.swap(replaced);
+      return count;
+    }
+
+    // Matches are always found ahead of what is written, and replacements are
+    // never longer than their pattern: the output never overwrites bytes that
+    // are still to be scanned
+    char* const data = d_str.data();
+    std::size_t read = 0;
+    std::size_t write = 0;
+    std::size_t count = 0;
+
+    ForEachMatch(d_str, [&](std::size_t position, std::size_t r) noexcept {
+      const auto& [from, to] = m_replacements[r];
+      if (write != read) std::copy(data + read, data + position, data + write);
+      write += (position - read);
+      write = static_cast<std::size_t>(
+          std::copy_n(to.data(), to.size(), data + write) - data);
+      read = position + from.size();
+      ++count;
+    });
+
+    if (write != read) std::copy(data + read, data + d_str.size(), data + write);
+    d_str.resize(write + (d_str.size() - read));
+    return count;
+  }
+
+ private:
+  template <class It>
+  auto Build(It first, It last) -> void {
+    for (; first != last; ++first) {
+      const auto& [from, to] = *first;
+      if (from.empty()) continue;
+
+      m_replacements.emplace_back(from, to);
+      m_grows = m_grows || (to.size() > from.size());
+    }
+
+    if (m_replacements.size() == 1) {
+      m_searcher = StrSearcher{m_replacements.front().first};
+      return;
+    }
+
+    bool single_bytes = true;
+    for (std::size_t r = 0; r < m_replacements.size(); ++r) {
+      const std::string_view from = m_replacements[r].first;
+      single_bytes = single_bytes && (from.size() == 1);
+
+      const auto byte = static_cast<std::uint8_t>(from.front());
+      if (!m_first_bytes.Contains(from.front())) m_byte_replacement[byte] = r;
+      m_first_bytes.Insert(from.front());
+    }
+
+    // Patterns of a single byte only (i.e. escaping): the CharSet is enough
+    if (!single_bytes) {
+      std::vector<std::string_view> patterns;
+      for (const auto& replacement : m_replacements) {
+        patterns.push_back(replacement.first);
+      }
+      m_automaton.emplace(patterns.begin(), patterns.end());
+    }
+  }
+
+  /**
+   * @brief Invoke \a f(position, replacement index) for each pattern found in
+   *        \a str, from left to right, without overlaps
+   */
+  template <class F>
+  auto ForEachMatch(std::string_view str, F&& f) const noexcept -> void {
+    if (m_replacements.size() == 1) {
+      const std::size_t size = m_replacements.front().first.size();
+      for (std::size_t pos = m_searcher.Find(str); pos != StrSearcher::npos;
+           pos = m_searcher.Find(str, pos + size)) {
+        f(pos, 0);
+      }
+    } else if (!m_automaton) {
+      for (std::size_t pos = m_first_bytes.Find(str); pos != CharSet::npos;
+           pos = m_first_bytes.Find(str, pos + 1)) {
+        f(pos, m_byte_replacement[static_cast<std::uint8_t>(str[pos])]);
+      }
+    } else {
+      // Only start the automaton where a pattern may start
+      for (std::size_t pos = m_first_bytes.Find(str); pos != CharSet::npos;
+           pos = m_first_bytes.Find(str, pos)) {
+        const auto match = m_automaton->Find(str.substr(pos));
+        if (!match) break;
+
+        f(pos + match->position, match->pattern);
+        pos += match->position + match->size;
+      }
+    }
+  }
+
+  /**
+   * @brief Append the replaced \a str into \a d_str (a single resize)
+   * @return The number of replacements done
+   */
+  auto ReplaceInto(std::string_view str, std::string& d_str) const
+      -> std::optional<std::size_t> {
+    const auto size = ReplacedSize(str);
+    if (!size || (*size > (d_str.max_size() - d_str.size()))) {
+      return std::nullopt;
+    }
+
+    const std::size_t old_size = d_str.size();
+    d_str.resize(old_size + *size);
+
+    char* d_first = d_str.data() + old_size;
+    std::size_t read = 0;
+    std::size_t count = 0;
+
+    ForEachMatch(str, [&](std::size_t position, std::size_t r) noexcept {
+      const auto& [from, to] = m_replacements[r];
+      d_first = std::copy_n(str.data() + read, position - read, d_first);
+      d_first = std::copy_n(to.data(), to.size(), d_first);
+      read = position + from.size();
+      ++count;
+    });
+
+    std::copy_n(str.data() + read, str.size() - read, d_first);
+    return count;
+  }
+
+  std::vector<Replacement> m_replacements; /*!< Non empty patterns only */
+  StrSearcher m_searcher;                  /*!< Used with a single pattern */
+  std::optional<AhoCorasick> m_automaton;  /*!< Used with several patterns */
+  CharSet m_first_bytes; /*!< First bytes of the patterns (several only) */
+  std::array<std::size_t, 256> m_byte_replacement = {}; /*!< Per first byte */
+  bool m_grows = false;  /*!< One of the replacements is growing */
+};
+
+/**
+ * @return A copy of \a str where all \a replacements {from, to} are applied,
+ *         in a single scan (see StrReplacer). std::nullopt when the result
+ *         would overflow.
+ *
+ * @code{.cpp}
+ * assert(StrReplaceAll("foo bar", {{"foo", "bar"}, {"bar", "foo"}}).value() ==
+ *        "bar foo");
+ * @endcode
+ */
+inline auto StrReplaceAll(
+    std::string_view str,
+    std::initializer_list<StrReplacer::Replacement> replacements)
+    -> std::optional<std::string> {
+  return StrReplacer{replacements}.Replace(str);
+}
+
+/**
+ * @brief Apply all \a replacements {from, to} to \a d_str, in place, in a
+ *        single scan (see StrReplacer::ReplaceInPlace)
+ *
+ * @return The number of replacements done. std::nullopt when the result would
+ *         overflow.
+ */
+inline auto StrReplaceAllInPlace(
+    std::string& d_str,
+    std::initializer_list<StrReplacer::Replacement> replacements)
+    -> std::optional<std::size_t> {
+  return StrReplacer{replacements}.ReplaceInPlace(d_str);
+}
+
 // STRINGS MATCHERS ////////////////////////////////////////////////////////////
 
 /**
@@ -242,12 +513,16 @@ constexpr auto StrContainsImpl(std::size_t* const d_where, F&& contains,
  *
  * @note The search for the pattern is done from the beginning of the string and
  *        will hence give the location of the FIRST pattern encountered
+ *
+ * @note The pattern is compiled once into a StrSearcher (see searcher.hpp)
+ *       when creating the matcher
  */
 constexpr auto StrContains(std::string_view pattern,
                            std::size_t* const d_where = nullptr) noexcept {
-  return [=](std::string_view str) noexcept -> bool {
+  return [=, searcher = StrSearcher{pattern}](
+             std::string_view str) noexcept -> bool {
     return details::StrContainsImpl(
-        d_where, [](auto s, auto p) { return s.find(p); }, str, pattern);
+        d_where, [&searcher](auto s) { return searcher.Find(s); }, str);
   };
 }
 
@@ -264,12 +539,16 @@ constexpr auto StrContains(std::string_view pattern,
  *
  * @note The search for the pattern is done from the back of the string and
  *        will hence give the location of the LAST pattern encountered
+ *
+ * @note The pattern is compiled once into a StrSearcher (see searcher.hpp)
+ *       when creating the matcher
  */
 constexpr auto StrContainsR(std::string_view pattern,
                             std::size_t* const d_where = nullptr) noexcept {
-  return [=](std::string_view str) noexcept -> bool {
+  return [=, searcher = StrSearcher{pattern}](
+             std::string_view str) noexcept -> bool {
     return details::StrContainsImpl(
-        d_where, [](auto s, auto p) { return s.rfind(p); }, str, pattern);
+        d_where, [&searcher](auto s) { return searcher.RFind(s); }, str);
   };
 }
 
@@ -277,23 +556,21 @@ constexpr auto StrContainsR(std::string_view pattern,
  * @return true whenever the given \a str contains ONE of the char contained in
  *         \a pattern
  *
- * @important Since \a pattern is a string_view the underlying string-like
- *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
- *            give a rvalue of a std::string).
- *
  * @param[in] pattern The list of char to look for
  * @param[inout] d_where Optionally a pointer to an index that will be set to
  *                       the location of the char found
  *
  * @note The search for the chars is done from the beginning of the string and
  *       will hence give the location of the FIRST char encountered
+ *
+ * @note \a pattern is compiled once into a CharSet (see char_set.hpp) when
+ *       creating the matcher, hence it doesn't need to outlive it
  */
 constexpr auto StrContainsOneOf(std::string_view pattern,
                                 std::size_t* const d_where = nullptr) noexcept {
-  return [=](std::string_view str) noexcept -> bool {
+  return [=, set = CharSet{pattern}](std::string_view str) noexcept -> bool {
     return details::StrContainsImpl(
-        d_where, [](auto s, auto p) { return s.find_first_of(p); }, str,
-        pattern);
+        d_where, [&set](auto s) { return set.Find(s); }, str);
   };
 }
 
@@ -301,26 +578,433 @@ constexpr auto StrContainsOneOf(std::string_view pattern,
  * @return true whenever the given \a str contains ONE of the char contained in
  *         \a pattern
  *
- * @important Since \a pattern is a string_view the underlying string-like
- *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
- *            give a rvalue of a std::string).
- *
  * @param[in] pattern The list of char to look for
  * @param[inout] d_where Optionally a pointer to an index that will be set to
  *                       the location of the char found
  *
  * @note The search for the chars is done from the end of the string and
  *       will hence give the location of the LAST char encountered
+ *
+ * @note \a pattern is compiled once into a CharSet (see char_set.hpp) when
+ *       creating the matcher, hence it doesn't need to outlive it
  */
 constexpr auto StrContainsOneOfR(
     std::string_view pattern, std::size_t* const d_where = nullptr) noexcept {
+  return [=, set = CharSet{pattern}](std::string_view str) noexcept -> bool {
+    return details::StrContainsImpl(
+        d_where, [&set](auto s) { return set.RFind(s); }, str);
+  };
+}
+
+/**
+ * @return true whenever the given \a str contains ONE of the \a patterns
+ *
+ * All patterns are compiled once into a single AhoCorasick automaton (see
+ * aho_corasick.hpp) when creating the matcher, hence the input string is only
+ * scanned once, independently of the number of patterns.
+ *
+ * @code{.cpp}
+ * AhoCorasick::Match match;
+ * assert(::IsMatching(StrContainsAnyOf({"foo", "bar"}, &match), "a bar"));
+ * assert(match.pattern == 1);
+ * assert(match.position == 2);
+ * @endcode
+ *
+ * @param[in] patterns Range of string-like patterns to look for (i.e.
+ *                     std::vector<std::string>, ...)
+ * @param[inout] d_match Optionally a pointer to a Match that will be set to the
+ *                       pattern found (index, location and size)
+ *
+ * @note The search is done from the beginning of the string and will hence
+ *       give the FIRST pattern encountered (the longest one when several
+ *       patterns start at the same location)
+ *
+ * @note The patterns are copied inside the matcher (they don't need to outlive
+ *       it)
+ */
+template <class Range>
+auto StrContainsAnyOf(const Range& patterns,
+                      AhoCorasick::Match* const d_match = nullptr) {
+  return [=, ac = AhoCorasick{std::begin(patterns), std::end(patterns)}](
+             std::string_view str) -> bool {
+    if (d_match == nullptr) return ac.Contains(str);
+
+    const auto match = ac.Find(str);
+    if (match) *d_match = *match;
+    return match.has_value();
+  };
+}
+
+/**
+ * @brief Same as StrContainsAnyOf(patterns, d_match) with a list of \a
+ *        patterns (i.e. `StrContainsAnyOf({"foo", "bar"})`)
+ */
+inline auto StrContainsAnyOf(std::initializer_list<std::string_view> patterns,
+                             AhoCorasick::Match* const d_match = nullptr) {
+  return StrContainsAnyOf<std::initializer_list<std::string_view>>(patterns,
+                                                                   d_match);
+}
+
+// CASE INSENSITIVE STRINGS MATCHERS //////////////////////////////////////////
+//
+// Same as the matchers above, ignoring the ASCII case (see ascii.hpp). The case
+// is folded on the fly, hence those matchers never allocate.
+
+/**
+ * @return true whenever the given \a str is equal to \a expected, ignoring
+ *         ASCII case
+ *
+ * @important Since \a expected is a string_view the underlying string-like
+ *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
+ *            give a rvalue of a std::string).
+ */
+constexpr auto StrIEquals(std::string_view expected) noexcept {
+  return [=](std::string_view str) noexcept -> bool {
+    return AsciiIEquals(str, expected);
+  };
+}
+
+/**
+ * @return true whenever the given \a str starts by \a prefix, ignoring ASCII
+ *         case
+ *
+ * @important Since \a prefix is a string_view the underlying string-like
+ *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
+ *            give a rvalue of a std::string).
+ */
+constexpr auto StrIStartsWith(std::string_view prefix) noexcept {
+  return [=](std::string_view str) noexcept -> bool {
+    return AsciiIEquals(str.substr(0, prefix.size()), prefix);
+  };
+}
+
+/**
+ * @return true whenever the given \a str ends by \a suffix, ignoring ASCII
+ *         case
+ *
+ * @important Since \a suffix is a string_view the underlying string-like
+ *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
+ *            give a rvalue of a std::string).
+ */
+constexpr auto StrIEndsWith(std::string_view suffix) noexcept {
+  return [=](std::string_view str) noexcept -> bool {
+    return (str.size() >= suffix.size()) &&
+           AsciiIEquals(str.substr(str.size() - suffix.size()), suffix);
+  };
+}
+
+/**
+ * @brief Same as StrContains(pattern, d_where), ignoring ASCII case
+ *
+ * @important Since \a pattern is a string_view the underlying string-like
+ *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
+ *            give a rvalue of a std::string).
+ */
+constexpr auto StrIContains(std::string_view pattern,
+                            std::size_t* const d_where = nullptr) noexcept {
+  return [=](std::string_view str) noexcept -> bool {
+    return details::StrContainsImpl(
+        d_where, [&](auto s) { return AsciiIFind(s, pattern); }, str);
+  };
+}
+
+/**
+ * @brief Same as StrContainsR(pattern, d_where), ignoring ASCII case
+ *
+ * @important Since \a pattern is a string_view the underlying string-like
+ *            referenced NEEDS to outlive the matcher lifetime (i.e. do not
+ *            give a rvalue of a std::string).
+ */
+constexpr auto StrIContainsR(std::string_view pattern,
+                             std::size_t* const d_where = nullptr) noexcept {
   return [=](std::string_view str) noexcept -> bool {
     return details::StrContainsImpl(
-        d_where, [](auto s, auto p) { return s.find_last_of(p); }, str,
-        pattern);
+        d_where, [&](auto s) { return AsciiIRFind(s, pattern); }, str);
   };
 }
 
+namespace details {
+
+/// @return A CharSet containing both cases of all the chars of \a chars
+constexpr auto StrICharSet(std::string_view chars) noexcept -> CharSet {
+  CharSet set;
+  for (auto c : chars) set.Insert(AsciiToLower(c)).Insert(AsciiToUpper(c));
+  return set;
+}
+
+}  // namespace details
+
+/**
+ * @brief Same as StrContainsOneOf(pattern, d_where), ignoring ASCII case
+ *
+ * @note Both cases of each char are inserted into the CharSet when creating
+ *       the matcher, hence the search itself is identical
+ */
+constexpr auto StrIContainsOneOf(std::string_view pattern,
+                                 std::size_t* const d_where = nullptr) noexcept {
+  return [=, set = details::StrICharSet(pattern)](
+             std::string_view str) noexcept -> bool {
+    return details::StrContainsImpl(
+        d_where, [&set](auto s) { return set.Find(s); }, str);
+  };
+}
+
+/**
+ * @brief Same as StrContainsOneOfR(pattern, d_where), ignoring ASCII case
+ *
+ * @note Both cases of each char are inserted into the CharSet when creating
+ *       the matcher, hence the search itself is identical
+ */
+constexpr auto StrIContainsOneOfR(
+    std::string_view pattern, std::size_t* const d_where = nullptr) noexcept {
+  return [=, set = details::StrICharSet(pattern)](
+             std::string_view str) noexcept -> bool {
+    return details::StrContainsImpl(
+        d_where, [&set](auto s) { return set.RFind(s); }, str);
+  };
+}
+
+// GLOB MATCHER ////////////////////////////////////////////////////////////////
+
+namespace details {
+
+/**
+ * @brief A shell like glob pattern, compiled once into a list of pieces
+ *
+ * The pattern is split on '*' into pieces made of tokens (literal runs, '?'
+ * or a '[...]' class), each matching a fixed number of chars. Since '*'
+ * matches anything, the first (last) piece is matched at the beginning (end)
+ * of the string and each piece in between at its leftmost location after the
+ * previous one: no backtracking is ever needed. Pieces are located using
+ * their longest literal run, through a StrSearcher.
+ */
+class StrGlobPattern final {
+ public:
+  explicit StrGlobPattern(std::string_view pattern) {
+    m_pieces.emplace_back();
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+      const char c = pattern[i];
+      if (c == '*') {
+        EndPiece();
+        m_pieces.emplace_back();
+        m_pieces.back().first = m_tokens.size();
+      } else if (c == '?') {
+        AddToken(Token{{}, {}, true});
+      } else if (const std::size_t end = ClassEnd(pattern, i);
+                 (c == '[') && (end != std::string_view::npos)) {
+        AddToken(Token{{}, ParseClass(pattern.substr(i + 1, end - i - 1)),
+                       false});
+        i = end;
+      } else if ((c == '\\') && ((i + 1) < pattern.size())) {
+        AddLiteral(pattern.substr(++i, 1));
+      } else {
+        AddLiteral(pattern.substr(i, 1));
+      }
+    }
+    EndPiece();
+  }
+
+  /// @return true when the whole \a str matches the pattern
+  auto Match(std::string_view str) const noexcept -> bool {
+    const Piece& head = m_pieces.front();
+    if (m_pieces.size() == 1) {
+      return (str.size() == head.size) && MatchAt(head, str, 0);
+    }
+
+    const Piece& tail = m_pieces.back();
+    if ((head.size + tail.size) > str.size()) return false;
+    if (!MatchAt(head, str, 0)) return false;
+    if (!MatchAt(tail, str, str.size() - tail.size)) return false;
+
+    // Pieces in between can't overlap the head nor the tail
+    const std::string_view middle = str.substr(0, str.size() - tail.size);
+    std::size_t pos = head.size;
+    for (std::size_t p = 1; (p + 1) < m_pieces.size(); ++p) {
+      pos = Find(m_pieces[p], middle, pos);
+      if (pos == std::string_view::npos) return false;
+      pos += m_pieces[p].size;
+    }
+    return true;
+  }
+
+ private:
+  /// A literal run, any char ('?') or a class of chars
+  struct Token {
+    std::string_view literal; /*!< Literal run (empty when not a literal) */
+    CharSet set;              /*!< Chars of a class */
+    bool any;                 /*!< true for '?' */
+  };
+
+  /// Tokens in between 2 '*'
+  struct Piece {
+    std::size_t first = 0; /*!< Index of the first token */
+    std::size_t last = 0;  /*!< Index of one past the last token */
+    std::size_t size = 0;  /*!< Number of chars matched */
+    std::size_t anchor_offset = 0; /*!< Offset of the longest literal */
+    std::optional<StrSearcher> anchor; /*!< Searcher of the longest literal */
+  };
+
+  /// @return The index of the ']' closing the class starting at \a i (npos if
+  ///         not a class)
+  static auto ClassEnd(std::string_view pattern, std::size_t i) noexcept
+      -> std::size_t {
+    if (pattern[i] != '[') return std::string_view::npos;
+
+    std::size_t j = i + 1;
+    if ((j < pattern.size()) && ((pattern[j] == '!') || (pattern[j] == '^'))) {
+      ++j;
+    }
+    if ((j < pattern.size()) && (pattern[j] == ']')) ++j;  // Literal ']'
+    return pattern.find(']', j);
+  }
+
+  /// @return The CharSet of the class content \a chars (i.e. "!a-z_")
+  static auto ParseClass(std::string_view chars) noexcept -> CharSet {
+    const bool negated =
+        !chars.empty() && ((chars.front() == '!') || (chars.front() == '^'));
+    if (negated) chars.remove_prefix(1);
+
+    CharSet set;
+    for (std::size_t i = 0; i < chars.size(); ++i) {
+      if (((i + 2) < chars.size()) && (chars[i + 1] == '-')) {
+        const auto from = static_cast<std::uint8_t>(chars[i]);
+        const auto to = static_cast<std::uint8_t>(chars[i + 2]);
+        for (unsigned c = from; c <= to; ++c) {
+          set.Insert(static_cast<char>(static_cast<std::uint8_t>(c)));
+        }
+        i += 2;
+      } else {
+        set.Insert(chars[i]);
+      }
+    }
+
+    if (!negated) return set;
+
+    CharSet complement;
+    for (unsigned c = 0; c < 256; ++c) {
+      const auto ch = static_cast<char>(static_cast<std::uint8_t>(c));
+      if (!set.Contains(ch)) complement.Insert(ch);
+    }
+    return complement;
+  }
+
+  auto AddToken(Token token) -> void {
+    m_tokens.push_back(token);
+    m_pieces.back().size += 1;
+  }
+
+  /// Add a literal \a c (a view on the pattern), merged with the previous one
+  /// when contiguous
+  auto AddLiteral(std::string_view c) -> void {
+    Piece& piece = m_pieces.back();
+    if ((m_tokens.size() > piece.first) && !m_tokens.back().literal.empty() &&
+        ((m_tokens.back().literal.data() + m_tokens.back().literal.size()) ==
+         c.data())) {
+      auto& literal = m_tokens.back().literal;
+      literal = std::string_view(literal.data(), literal.size() + 1);
+    } else {
+      m_tokens.push_back(Token{c, {}, false});
+    }
+    piece.size += 1;
+  }
+
+  /// Close the current piece, selecting its anchor
+  auto EndPiece() -> void {
+    Piece& piece = m_pieces.back();
+    piece.last = m_tokens.size();
+
+    std::size_t offset = 0;
+    std::string_view longest;
+    for (std::size_t t = piece.first; t < piece.last; ++t) {
+      const auto& literal = m_tokens[t].literal;
+      if (literal.size() > longest.size()) {
+        longest = literal;
+        piece.anchor_offset = offset;
+      }
+      offset += literal.empty() ? 1 : literal.size();
+    }
+    if (!longest.empty()) piece.anchor.emplace(longest);
+  }
+
+  /// @return true when \a piece matches \a str at \a pos
+  /// @pre pos + piece.size <= str.size()
+  auto MatchAt(const Piece& piece, std::string_view str,
+               std::size_t pos) const noexcept -> bool {
+    for (std::size_t t = piece.first; t < piece.last; ++t) {
+      const Token& token = m_tokens[t];
+      if (!token.literal.empty()) {
+        if (str.compare(pos, token.literal.size(), token.literal) != 0) {
+          return false;
+        }
+        pos += token.literal.size();
+      } else {
+        if (!token.any && !token.set.Contains(str[pos])) return false;
+        ++pos;
+      }
+    }
+    return true;
+  }
+
+  /// @return The leftmost location of \a piece in \a str, from \a pos
+  auto Find(const Piece& piece, std::string_view str,
+            std::size_t pos) const noexcept -> std::size_t {
+    if (piece.anchor) {
+      for (std::size_t found =
+               piece.anchor->Find(str, pos + piece.anchor_offset);
+           found != StrSearcher::npos;
+           found = piece.anchor->Find(str, found + 1)) {
+        const std::size_t start = found - piece.anchor_offset;
+        if ((start + piece.size) > str.size()) break;
+        if (MatchAt(piece, str, start)) return start;
+      }
+    } else {
+      // Only '?' and classes: the piece is short, try each location
+      for (; (pos + piece.size) <= str.size(); ++pos) {
+        if (MatchAt(piece, str, pos)) return pos;
+      }
+    }
+    return std::string_view::npos;
+  }
+
+  std::vector<Token> m_tokens;
+  std::vector<Piece> m_pieces;
+};
+
+}  // namespace details
+
+/**
+ * @return true whenever the WHOLE given \a str matches the shell like glob
+ *         \a pattern
+ *
+ * Supported syntax:
+ * - '*' matches any sequence of chars (including '/' and the empty one);
+ * - '?' matches any single char;
+ * - '[abc]', '[a-z]' match one of the chars of the class, '[!a-z]' (or
+ *   '[^a-z]') one char NOT in the class. A ']' right after the opening '['
+ *   (or the negation) is part of the class;
+ * - '\\' escapes the next char (i.e. "\\*" matches a literal '*');
+ * - Anything else (including a '[' without its ']') matches itself.
+ *
+ * @code{.cpp}
+ * const auto sources = StrGlob("*_v?.[ch]pp");
+ * assert(::IsMatching(sources, "parser_v2.hpp"));
+ * assert(!::IsMatching(sources, "parser_v2.hpp.orig"));
+ * @endcode
+ *
+ * @important The literal parts are stored as string_view, the underlying
+ *            string-like referenced by \a pattern NEEDS to outlive the matcher
+ *            lifetime.
+ *
+ * @note The pattern is compiled once, when creating the matcher, into pieces
+ *       separated by '*'. Matching is done without any backtracking: each
+ *       piece is located once, using a StrSearcher on its longest literal.
+ */
+inline auto StrGlob(std::string_view pattern) {
+  return [glob = details::StrGlobPattern{pattern}](
+             std::string_view str) noexcept -> bool { return glob.Match(str); };
+}
+
 /**
  * @brief Switch construct for string like object
  *
@@ -0,0 +1,738 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>  // std::copy
+#include <cerrno>
+#include <chrono>
+#include <cstddef>  // std::size_t
+#include <cstdint>
+#include <cstring>  // std::memcpy, std::memset
+#include <functional>
+#include <limits>  // std::numeric_limits
+#include <memory>  // std::unique_ptr
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>  // std::forward, std::move
+#include <vector>
+
+#include "atb-cpp/line_scanner.hpp"
+#include "atb-cpp/matchers.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#endif
+
+// IORING_REGISTER_PROBE (Linux 5.6) came with IORING_OP_READ
+#if defined(IO_URING_OP_SUPPORTED) && defined(__NR_io_uring_register)
+#define ATB_TAIL_IO_URING 1
+#else
+#define ATB_TAIL_IO_URING 0
+#endif
+
+namespace atb {
+
+/// Mechanism used by StrTailReader to wait for, and read, new data
+enum class TailBackend : std::uint8_t {
+  kIoUring, /*!< Reads and inotify events completed through an io_uring */
+  kEpoll,   /*!< inotify events waited using epoll, files read with pread() */
+};
+
+/**
+ * @brief Tail many growing files (i.e. logs) from a single thread, running
+ *        matchers against each new line
+ *
+ * Files are watched using inotify. With the io_uring backend, one read per
+ * file (plus the inotify read) is kept in flight and completions are
+ * processed as they arrive; without it (kernel too old, io_uring disabled by
+ * seccomp, ...), the reader falls back to epoll + pread().
+ *
+ * Lines are given as std::string_view into a per file buffer, reused from one
+ * read to the next: no copy is made unless the handler makes one (i.e. only
+ * for the lines that matched).
+ *
+ * @code{.cpp}
+ * StrTailReader reader;
+ * reader.Watch("/var/log/syslog", StrContainsAnyOf({"error", "fatal"}),
+ *              [&](std::size_t, std::string_view line) {
+ *                alerts.emplace_back(line);  // Copy only what matched
+ *              });
+ *
+ * while (running) reader.Poll(std::chrono::milliseconds{100});
+ * @endcode
+ *
+ * @note Truncated files (i.e. `copytruncate` log rotation) are read again
+ *       from their beginning. Files rotated by renaming are NOT followed.
+ *
+ * @note This class is NOT thread safe (handlers are called from Poll())
+ */
+class StrTailReader final {
+ public:
+  /// Called with the id of the file (returned by Watch) and the line matching
+  using LineHandler = std::function<void(std::size_t, std::string_view)>;
+
+  /// Default size of the per file buffers (grown for longer lines)
+  static constexpr std::size_t kDefaultBufferSize = 64 * 1024;
+
+  /// Number of submission queue entries of the io_uring
+  static constexpr unsigned kRingEntries = 256;
+
+  /**
+   * @brief Construct a reader without files
+   *
+   * @param[in] backend The backend wished. kIoUring silently falls back to
+   *                    kEpoll when io_uring isn't available (or can't read
+   *                    files, before Linux 5.6).
+   * @param[in] buffer_size Initial size of the per file buffers
+   *
+   * @throw std::system_error When inotify/epoll can't be initialized
+   */
+  explicit StrTailReader(TailBackend backend = TailBackend::kIoUring,
+                         std::size_t buffer_size = kDefaultBufferSize)
+      : m_buffer_size(buffer_size > 0 ? buffer_size : kDefaultBufferSize) {
+#if ATB_TAIL_IO_URING
+    if ((backend == TailBackend::kIoUring) && SetupRing()) {
+      m_backend = TailBackend::kIoUring;
+      // Blocking: io_uring polls it internally instead of failing with EAGAIN
+      m_inotify = ::inotify_init1(IN_CLOEXEC);
+      if (m_inotify < 0) {
+        const int error = errno;
+        UnmapRing();
+        Throw("inotify_init1", {}, error);
+      }
+      QueueInotifyRead();
+      return;
+    }
+#else
+    static_cast<void>(backend);
+#endif
+
+    m_backend = TailBackend::kEpoll;
+    m_inotify = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (m_inotify < 0) Throw("inotify_init1");
+
+    if (const int error = SetupEpoll(); error != 0) {
+      ::close(m_inotify);
+      Throw("epoll", {}, error);
+    }
+  }
+
+  /// Not copyable/movable (buffers are referenced by in flight reads)
+  StrTailReader(const StrTailReader&) = delete;
+  StrTailReader(StrTailReader&&) = delete;
+  auto operator=(const StrTailReader&) -> StrTailReader& = delete;
+  auto operator=(StrTailReader&&) -> StrTailReader& = delete;
+
+  ~StrTailReader() noexcept {
+#if ATB_TAIL_IO_URING
+    if (m_backend == TailBackend::kIoUring) CancelAll();
+    UnmapRing();
+#endif
+    for (const auto& file : m_files) ::close(file->fd);
+    if (m_inotify >= 0) ::close(m_inotify);
+    if (m_epoll >= 0) ::close(m_epoll);
+  }
+
+  /// @return The backend actually used
+  auto Backend() const noexcept -> TailBackend { return m_backend; }
+
+  /// @return The number of files watched
+  auto FilesCount() const noexcept -> std::size_t { return m_files.size(); }
+
+  /**
+   * @brief Start tailing the file at \a path
+   *
+   * @param[in] path Path of the file to tail
+   * @param[in] matcher Any ::IsMatching compatible matcher, called with each
+   *                    new line (std::string_view)
+   * @param[in] on_match Called with each line matching (the view is only
+   *                     valid during the call)
+   * @param[in] from_start When true, the lines already present are read too
+   *                       (otherwise, only lines appended from now on)
+   *
+   * @return The id of the file, given to \a on_match
+   *
+   * @throw std::system_error When the file can't be opened/watched
+   */
+  template <class Matcher>
+  auto Watch(const std::string& path, Matcher&& matcher, LineHandler on_match,
+             bool from_start = false) -> std::size_t {
+    auto file = std::make_unique<File>();
+    file->matcher =
+        AnyMatcher<std::string_view>{std::forward<Matcher>(matcher)};
+    file->on_match = std::move(on_match);
+    file->buffer.resize(m_buffer_size);
+
+    file->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file->fd < 0) Throw("open", path);
+
+    struct stat infos = {};
+    if (::fstat(file->fd, &infos) != 0) {
+      const int error = errno;
+      ::close(file->fd);
+      Throw("fstat", path, error);
+    }
+    file->offset = from_start ? 0 : static_cast<std::uint64_t>(infos.st_size);
+
+    const int wd = ::inotify_add_watch(m_inotify, path.c_str(), IN_MODIFY);
+    if (wd < 0) {
+      const int error = errno;
+      ::close(file->fd);
+      Throw("inotify_add_watch", path, error);
+    }
+
+    const std::size_t id = m_files.size();
+    m_files.push_back(std::move(file));
+    m_watches[wd].push_back(id);
+
+#if ATB_TAIL_IO_URING
+    if (m_backend == TailBackend::kIoUring) QueueRead(id);
+#endif
+    return id;
+  }
+
+  /**
+   * @brief Read the data appended to the files, giving all new lines to their
+   *        matchers (and handlers)
+   *
+   * When no new line is available, waits up to \a timeout for one (forever
+   * when negative).
+   *
+   * @return The number of lines matching
+   *
+   * @throw std::system_error On io_uring/epoll failures
+   */
+  auto Poll(std::chrono::milliseconds timeout) -> std::size_t {
+#if ATB_TAIL_IO_URING
+    if (m_backend == TailBackend::kIoUring) return PollRing(timeout);
+#endif
+    return PollEpoll(timeout);
+  }
+
+ private:
+  struct File {
+    int fd = -1;
+    std::uint64_t offset = 0;  /*!< Offset of the next read */
+    std::vector<char> buffer;  /*!< Reused, holds the last partial line */
+    std::size_t used = 0;      /*!< Bytes of buffer holding data */
+    AnyMatcher<std::string_view> matcher;
+    LineHandler on_match;
+    bool reading = false;  /*!< A read is in flight (io_uring) */
+    bool modified = true;  /*!< Data may have been appended */
+  };
+
+  [[noreturn]] static auto Throw(const char* what, const std::string& path = {},
+                                 int error = errno) -> void {
+    std::string message{what};
+    if (!path.empty()) message += "(" + path + ")";
+    throw std::system_error(error, std::generic_category(), message);
+  }
+
+  /// @return The free space at the end of \a file buffer (grown when full)
+  static auto FreeSpace(File& file) -> std::size_t {
+    if (file.used == file.buffer.size()) {
+      // A single line doesn't fit into the buffer
+      file.buffer.resize(file.buffer.size() * 2);
+    }
+    return file.buffer.size() - file.used;
+  }
+
+  /**
+   * @brief Account for \a n bytes appended to \a file buffer, dispatching the
+   *        complete lines
+   *
+   * @return The number of lines matching
+   */
+  static auto Consume(std::size_t id, File& file, std::size_t n)
+      -> std::size_t {
+    const std::string_view previous{file.buffer.data(), file.used};
+    const std::string_view added{file.buffer.data() + file.used, n};
+    file.used += n;
+    file.offset += n;
+
+    const std::size_t last = added.rfind('\n');
+    if (last == std::string_view::npos) return 0;
+
+    // Only complete lines, the trailing partial line is kept
+    const std::size_t end = previous.size() + last + 1;
+    std::size_t count = 0;
+    StrForEachMatchingLine(std::string_view{file.buffer.data(), end},
+                           file.matcher, [&](std::string_view line) {
+                             file.on_match(id, line);
+                             ++count;
+                           });
+
+    std::copy(file.buffer.data() + end, file.buffer.data() + file.used,
+              file.buffer.data());
+    file.used -= end;
+    return count;
+  }
+
+  /**
+   * @brief Restart reading \a file from its beginning when truncated
+   * @pre No read of this file is in flight
+   */
+  static auto CheckTruncated(File& file) noexcept -> void {
+    struct stat infos = {};
+    if ((::fstat(file.fd, &infos) == 0) &&
+        (static_cast<std::uint64_t>(infos.st_size) < file.offset)) {
+      file.offset = 0;
+      file.used = 0;
+    }
+  }
+
+  /**
+   * @brief Flag all the files modified according to the inotify events
+   *        contained in \a events
+   */
+  auto OnInotifyEvents(const char* events, std::size_t size) -> void {
+    std::size_t i = 0;
+    while ((i + sizeof(inotify_event)) <= size) {
+      inotify_event event = {};
+      std::memcpy(&event, events + i, sizeof(inotify_event));
+      i += sizeof(inotify_event) + event.len;
+
+      const auto watch = m_watches.find(event.wd);
+      if (watch == m_watches.end()) continue;
+
+      for (const std::size_t id : watch->second) {
+        auto& file = *m_files[id];
+        file.modified = true;
+#if ATB_TAIL_IO_URING
+        if ((m_backend == TailBackend::kIoUring) && !file.reading) {
+          QueueRead(id);
+        }
+#endif
+      }
+    }
+  }
+
+  // EPOLL ////////////////////////////////////////////////////////////////////
+
+  /// @return The number of lines matching, read from all modified files
+  auto ReadModified() -> std::size_t {
+    std::size_t count = 0;
+    for (std::size_t id = 0; id < m_files.size(); ++id) {
+      auto& file = *m_files[id];
+      if (!file.modified) continue;
+      file.modified = false;
+      CheckTruncated(file);
+
+      while (true) {
+        const std::size_t space = FreeSpace(file);
+        const ssize_t n =
+            ::pread(file.fd, file.buffer.data() + file.used, space,
+                    static_cast<off_t>(file.offset));
+        if ((n < 0) && (errno == EINTR)) continue;
+        if (n <= 0) break;
+
+        count += Consume(id, file, static_cast<std::size_t>(n));
+        if (static_cast<std::size_t>(n) < space) break;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief Wait for the inotify events (m_inotify, made non blocking) using
+   *        epoll
+   * @return 0 on success, the errno otherwise
+   */
+  auto SetupEpoll() noexcept -> int {
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_inotify;
+    const int flags = ::fcntl(m_inotify, F_GETFL);
+    m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if ((flags < 0) || (m_epoll < 0) ||
+        (::fcntl(m_inotify, F_SETFL, flags | O_NONBLOCK) != 0) ||
+        (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_inotify, &event) != 0)) {
+      const int error = errno;
+      if (m_epoll >= 0) ::close(m_epoll);
+      m_epoll = -1;
+      return error;
+    }
+    return 0;
+  }
+
+  /// @return \a timeout as expected by poll()/epoll_wait() (-1: forever)
+  static auto TimeoutMs(std::chrono::milliseconds timeout) noexcept -> int {
+    return static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(
+        timeout.count(), -1, std::numeric_limits<int>::max()));
+  }
+
+  auto PollEpoll(std::chrono::milliseconds timeout) -> std::size_t {
+    std::size_t count = ReadModified();
+    if (count > 0) return count;
+
+    epoll_event event = {};
+    const int ready = ::epoll_wait(m_epoll, &event, 1, TimeoutMs(timeout));
+    if (ready < 0) {
+      if (errno == EINTR) return 0;
+      Throw("epoll_wait");
+    }
+
+    if (ready > 0) {
+      ssize_t n = 0;
+      while ((n = ::read(m_inotify, m_events, sizeof(m_events))) > 0) {
+        OnInotifyEvents(m_events, static_cast<std::size_t>(n));
+      }
+      count = ReadModified();
+    }
+    return count;
+  }
+
+#if ATB_TAIL_IO_URING
+
+  // IO_URING /////////////////////////////////////////////////////////////////
+
+  /// user_data of the inotify reads (files use their id)
+  static constexpr std::uint64_t kInotifyData = ~std::uint64_t{0};
+
+  /// user_data of the cancel requests
+  static constexpr std::uint64_t kCancelData = kInotifyData - 1;
+
+  /**
+   * @brief Submit the SQEs committed, waiting for \a min_complete completions
+   *        when \a flags has IORING_ENTER_GETEVENTS
+   *
+   * @return The number of SQEs submitted, -1 on failure (errno set)
+   */
+  auto Submit(unsigned min_complete, unsigned flags) noexcept -> int {
+    const auto submitted = static_cast<int>(
+        ::syscall(__NR_io_uring_enter, m_ring, m_to_submit, min_complete,
+                  flags, nullptr, 0));
+    // The kernel stops at the first SQE failing to start (i.e. EINVAL): the
+    // next ones are left in the SQ, for the next call
+    if (submitted > 0) m_to_submit -= static_cast<unsigned>(submitted);
+    return submitted;
+  }
+
+  /// @return true when \a ring supports IORING_OP_READ (Linux 5.6)
+  static auto SupportsRead(int ring) noexcept -> bool {
+    alignas(io_uring_probe) unsigned char
+        buffer[sizeof(io_uring_probe) +
+               (IORING_OP_LAST * sizeof(io_uring_probe_op))] = {};
+    auto* probe = reinterpret_cast<io_uring_probe*>(buffer);
+    return (::syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE,
+                      probe, IORING_OP_LAST) == 0) &&
+           (probe->last_op >= IORING_OP_READ) &&
+           ((probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0);
+  }
+
+  /// @return true when the ring has been created and mapped, and supports
+  ///         all the operations used
+  auto SetupRing() noexcept -> bool {
+    io_uring_params params = {};
+    m_ring = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, kRingEntries, &params));
+    if (m_ring < 0) return false;
+    if (!SupportsRead(m_ring)) {
+      // io_uring_setup() exists since Linux 5.1, IORING_OP_READ since 5.6
+      ::close(m_ring);
+      m_ring = -1;
+      return false;
+    }
+
+    m_sq_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    m_cq_size = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+
+    const auto map = [&](std::size_t size, off_t offset) noexcept -> void* {
+      void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_ring, offset);
+      return (ptr == MAP_FAILED) ? nullptr : ptr;
+    };
+
+    m_sq_ptr = map(m_sq_size, IORING_OFF_SQ_RING);
+    m_cq_ptr = single_mmap ? m_sq_ptr : map(m_cq_size, IORING_OFF_CQ_RING);
+    m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = map(m_sqes_size, IORING_OFF_SQES);
+    if ((m_sq_ptr == nullptr) || (m_cq_ptr == nullptr) || (sqes == nullptr)) {
+      if (sqes != nullptr) ::munmap(sqes, m_sqes_size);
+      UnmapRing();
+      return false;
+    }
+
+    auto* sq = static_cast<char*>(m_sq_ptr);
+    auto* cq = static_cast<char*>(m_cq_ptr);
+    m_sq = {
+        reinterpret_cast<unsigned*>(sq + params.sq_off.head),
+        reinterpret_cast<unsigned*>(sq + params.sq_off.tail),
+        *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask),
+        params.sq_entries,
+        reinterpret_cast<unsigned*>(sq + params.sq_off.array),
+        static_cast<io_uring_sqe*>(sqes),
+    };
+    m_cq = {
+        reinterpret_cast<unsigned*>(cq + params.cq_off.head),
+        reinterpret_cast<unsigned*>(cq + params.cq_off.tail),
+        *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask),
+        reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes),
+    };
+    return true;
+  }
+
+  auto UnmapRing() noexcept -> void {
+    if (m_sq.sqes != nullptr) ::munmap(m_sq.sqes, m_sqes_size);
+    if ((m_cq_ptr != nullptr) && (m_cq_ptr != m_sq_ptr)) {
+      ::munmap(m_cq_ptr, m_cq_size);
+    }
+    if (m_sq_ptr != nullptr) ::munmap(m_sq_ptr, m_sq_size);
+    if (m_ring >= 0) ::close(m_ring);
+
+    m_sq = {};
+    m_cq = {};
+    m_sq_ptr = m_cq_ptr = nullptr;
+    m_ring = -1;
+  }
+
+  /// @return A zeroed SQE, to fill and commit with CommitSqe()
+  auto NextSqe() -> io_uring_sqe* {
+    const unsigned tail = *m_sq.tail;
+    if ((tail - __atomic_load_n(m_sq.head, __ATOMIC_ACQUIRE)) == m_sq.entries) {
+      // Full: submit what's pending to make room
+      if (Submit(0, 0) < 0) Throw("io_uring_enter");
+    }
+
+    const unsigned index = tail & m_sq.mask;
+    m_sq.array[index] = index;
+    io_uring_sqe* sqe = &m_sq.sqes[index];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+  }
+
+  auto CommitSqe() noexcept -> void {
+    __atomic_store_n(m_sq.tail, *m_sq.tail + 1, __ATOMIC_RELEASE);
+    ++m_to_submit;
+  }
+
+  /// @pre No read of this file is in flight
+  auto QueueRead(std::size_t id) -> void {
+    auto& file = *m_files[id];
+    if (file.modified) CheckTruncated(file);
+    const std::size_t space = std::min<std::size_t>(FreeSpace(file), 1u << 30);
+
+    io_uring_sqe* sqe = NextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = file.fd;
+    sqe->off = file.offset;
+    sqe->addr =
+        reinterpret_cast<std::uintptr_t>(file.buffer.data() + file.used);
+    sqe->len = static_cast<std::uint32_t>(space);
+    sqe->user_data = id;
+    CommitSqe();
+
+    file.reading = true;
+    file.modified = false;
+    ++m_reads;
+  }
+
+  auto QueueInotifyRead() -> void {
+    io_uring_sqe* sqe = NextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = m_inotify;
+    sqe->addr = reinterpret_cast<std::uintptr_t>(m_events);
+    sqe->len = sizeof(m_events);
+    sqe->user_data = kInotifyData;
+    CommitSqe();
+    m_inotify_reading = true;
+  }
+
+  /**
+   * @brief Process all the completions available
+   *
+   * @param[in] dispatch When false, data read is dropped (no more reads are
+   *                     queued)
+   *
+   * @return The number of lines matching
+   */
+  auto DrainCompletions(bool dispatch) -> std::size_t {
+    std::size_t count = 0;
+    unsigned head = *m_cq.head;
+    while (head != __atomic_load_n(m_cq.tail, __ATOMIC_ACQUIRE)) {
+      const io_uring_cqe cqe = m_cq.cqes[head & m_cq.mask];
+      __atomic_store_n(m_cq.head, ++head, __ATOMIC_RELEASE);
+
+      if (cqe.user_data == kCancelData) continue;
+
+      if (cqe.user_data == kInotifyData) {
+        m_inotify_reading = false;
+        if (!dispatch) continue;
+        if (cqe.res > 0) {
+          OnInotifyEvents(m_events, static_cast<std::size_t>(cqe.res));
+        } else if ((cqe.res != -EINTR) && (cqe.res != -EAGAIN)) {
+          m_ring_failed = true;  // Not re-queued: it would fail again
+          continue;
+        }
+        QueueInotifyRead();
+        continue;
+      }
+
+      const std::size_t id = cqe.user_data;
+      auto& file = *m_files[id];
+      file.reading = false;
+      --m_reads;
+      if (!dispatch) continue;
+
+      if (cqe.res > 0) {
+        count += Consume(id, file, static_cast<std::size_t>(cqe.res));
+        QueueRead(id);  // There may be more
+      } else if ((cqe.res == -EINVAL) || (cqe.res == -EOPNOTSUPP)) {
+        // The read itself isn't supported: pread() will do it
+        file.modified = true;
+        m_ring_failed = true;
+      } else if ((cqe.res == -EINTR) || (cqe.res == -EAGAIN) || file.modified) {
+        QueueRead(id);
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief Complete the reads queued and wait for the inotify events, until a
+   *        line matches or \a timeout expires
+   *
+   * Reads re-queued by their completion (more data may be available) are
+   * left to the next call: a file that keeps growing can't hold Poll() forever
+   */
+  auto PollRing(std::chrono::milliseconds timeout) -> std::size_t {
+    using Clock = std::chrono::steady_clock;
+    const int timeout_ms = TimeoutMs(timeout);
+    const Clock::time_point deadline =
+        Clock::now() + std::chrono::milliseconds{timeout_ms};
+    const auto remaining_ms = [timeout_ms, &deadline]() -> int {
+      if (timeout_ms < 0) return -1;
+      const auto left =
+          std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+      return static_cast<int>(std::max<std::chrono::milliseconds::rep>(
+          left.count(), 0));
+    };
+
+    std::size_t count = 0;
+    while (true) {
+      // Reads of regular files never block for long: wait for all of them
+      const unsigned flags = (m_reads > 0) ? IORING_ENTER_GETEVENTS : 0;
+      if (Submit(static_cast<unsigned>(m_reads), flags) < 0) {
+        if (errno == EINTR) continue;
+        Throw("io_uring_enter");
+      }
+
+      count += DrainCompletions(true);
+      if (m_ring_failed) {
+        FallBackToEpoll();
+        return count + PollEpoll(std::chrono::milliseconds{remaining_ms()});
+      }
+      if (count > 0) break;
+
+      const int wait_ms = remaining_ms();
+      if ((m_reads > 0) || (m_to_submit > 0)) {
+        if (wait_ms == 0) break;
+        continue;
+      }
+
+      // Only the inotify read is pending: wait for it (or a timeout)
+      pollfd ring = {m_ring, POLLIN, 0};
+      if (::poll(&ring, 1, wait_ms) <= 0) break;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Switch to the epoll backend, after the ring failed to read (the
+   *        reads not completed are done again using pread())
+   *
+   * @throw std::system_error When epoll can't be initialized
+   */
+  auto FallBackToEpoll() -> void {
+    CancelAll();
+    UnmapRing();
+    m_backend = TailBackend::kEpoll;
+    m_to_submit = 0;
+    m_reads = 0;
+    m_inotify_reading = false;
+    for (const auto& file : m_files) {
+      file->reading = false;
+      file->modified = true;
+    }
+
+    if (const int error = SetupEpoll(); error != 0) Throw("epoll", {}, error);
+  }
+
+  /// Wait for all the requests in flight (they reference our buffers)
+  auto CancelAll() noexcept -> void {
+    try {
+      if (m_inotify_reading) {
+        io_uring_sqe* sqe = NextSqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = kInotifyData;
+        sqe->user_data = kCancelData;
+        CommitSqe();
+      }
+
+      while ((m_reads > 0) || m_inotify_reading) {
+        if ((Submit(1, IORING_ENTER_GETEVENTS) < 0) && (errno != EINTR)) {
+          break;
+        }
+        DrainCompletions(false);
+      }
+    } catch (...) {
+      // Nothing else to do: the ring is closed right after
+    }
+  }
+
+  struct SubmissionQueue {
+    unsigned* head = nullptr;
+    unsigned* tail = nullptr;
+    unsigned mask = 0;
+    unsigned entries = 0;
+    unsigned* array = nullptr;
+    io_uring_sqe* sqes = nullptr;
+  };
+
+  struct CompletionQueue {
+    unsigned* head = nullptr;
+    unsigned* tail = nullptr;
+    unsigned mask = 0;
+    io_uring_cqe* cqes = nullptr;
+  };
+
+  int m_ring = -1;              /*!< io_uring fd */
+  void* m_sq_ptr = nullptr;     /*!< SQ ring mapping */
+  void* m_cq_ptr = nullptr;     /*!< CQ ring mapping (may be m_sq_ptr) */
+  std::size_t m_sq_size = 0;    /*!< Size of the SQ ring mapping */
+  std::size_t m_cq_size = 0;    /*!< Size of the CQ ring mapping */
+  std::size_t m_sqes_size = 0;  /*!< Size of the SQEs mapping */
+  SubmissionQueue m_sq;
+  CompletionQueue m_cq;
+  unsigned m_to_submit = 0;        /*!< SQEs committed, not submitted */
+  std::size_t m_reads = 0;         /*!< File reads in flight */
+  bool m_inotify_reading = false;  /*!< The inotify read is in flight */
+  bool m_ring_failed = false;      /*!< A read failed: use epoll instead */
+
+#endif  // ATB_TAIL_IO_URING
+
+  TailBackend m_backend = TailBackend::kEpoll;
+  std::size_t m_buffer_size; /*!< Initial size of the files buffers */
+  int m_inotify = -1;        /*!< Watches all files (IN_MODIFY) */
+  int m_epoll = -1;          /*!< Waits on m_inotify (epoll backend) */
+  std::vector<std::unique_ptr<File>> m_files; /*!< Indexed by id */
+  std::unordered_map<int, std::vector<std::size_t>> m_watches; /*!< By wd */
+  alignas(inotify_event) char m_events[4096]; /*!< inotify events read */
+};
+
+}  // namespace atb
+
+#endif  // defined(__linux__)
@@ -0,0 +1,450 @@
+#pragma once
+
+#include <algorithm>  // std::min
+#include <cstddef>    // std::size_t
+#include <cstdint>
+#include <cstring>  // std::memcpy
+#include <optional>
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+
+namespace atb {
+
+/**
+ * @brief Scalar implementation of Utf8IsValid()
+ */
+constexpr auto Utf8IsValidScalar(std::string_view str) noexcept -> bool {
+  const auto byte = [&](std::size_t i) -> unsigned {
+    return static_cast<unsigned char>(str[i]);
+  };
+
+  std::size_t i = 0;
+  while (i < str.size()) {
+    const unsigned lead = byte(i);
+    if (lead < 0x80u) {
+      ++i;
+      continue;
+    }
+
+    // Number of continuation bytes and the range allowed for the FIRST one
+    // (excludes overlongs, surrogates and code points above U+10FFFF)
+    std::size_t n = 0;
+    unsigned low = 0x80u;
+    unsigned high = 0xBFu;
+    if ((lead >= 0xC2u) && (lead <= 0xDFu)) {
+      n = 1;
+    } else if ((lead >= 0xE0u) && (lead <= 0xEFu)) {
+      n = 2;
+      if (lead == 0xE0u) low = 0xA0u;
+      if (lead == 0xEDu) high = 0x9Fu;
+    } else if ((lead >= 0xF0u) && (lead <= 0xF4u)) {
+      n = 3;
+      if (lead == 0xF0u) low = 0x90u;
+      if (lead == 0xF4u) high = 0x8Fu;
+    } else {
+      return false;
+    }
+
+    if (n >= (str.size() - i)) return false;
+    if ((byte(i + 1) < low) || (byte(i + 1) > high)) return false;
+    for (std::size_t j = 2; j <= n; ++j) {
+      if ((byte(i + j) & 0xC0u) != 0x80u) return false;
+    }
+    i += n + 1;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Scalar implementation of Utf8Count()
+ */
+constexpr auto Utf8CountScalar(std::string_view str) noexcept -> std::size_t {
+  std::size_t count = 0;
+  for (char c : str) {
+    // Count all bytes but the continuation ones (10xxxxxx)
+    count += ((static_cast<unsigned char>(c) & 0xC0u) != 0x80u) ? 1 : 0;
+  }
+  return count;
+}
+
+/**
+ * @return true when \a str is a valid UTF-8 sequence (no overlong encodings,
+ *         no surrogates, no code points above U+10FFFF, no truncated
+ *         sequences)
+ *
+ * @note Validates 16/32 bytes at once with SSSE3/AVX2, using the lookup table
+ *       algorithm from Keiser & Lemire ("Validating UTF-8 In Less Than One
+ *       Instruction Per Byte"). Pure ASCII blocks are skipped early.
+ */
+inline auto Utf8IsValid(std::string_view str) noexcept -> bool;
+
+/**
+ * @return The number of code points of \a str
+ *
+ * @pre \a str is valid UTF-8 (otherwise, it only counts the bytes that aren't
+ *      continuation bytes)
+ *
+ * @note Counts 16/32 bytes at once with SSE2/AVX2
+ */
+inline auto Utf8Count(std::string_view str) noexcept -> std::size_t;
+
+/**
+ * @return The number of code points of \a str. std::nullopt when \a str isn't
+ *         valid UTF-8.
+ *
+ * @code{.cpp}
+ * assert(Utf8Length("héllo") == 5);
+ * assert(!Utf8Length("\xC3"));  // Truncated
+ * @endcode
+ */
+inline auto Utf8Length(std::string_view str) noexcept
+    -> std::optional<std::size_t> {
+  if (!Utf8IsValid(str)) return std::nullopt;
+  return Utf8Count(str);
+}
+
+namespace details {
+
+#if ATB_SIMD_X86
+
+// Error flags of the lookup tables. Each one is set by the 3 lookups (high
+// and low nibbles of the previous byte, high nibble of the current byte) only
+// when the pair of bytes exhibits the error.
+constexpr std::uint8_t kUtf8TooShort = 1 << 0;   /*!< Lead not followed */
+constexpr std::uint8_t kUtf8TooLong = 1 << 1;    /*!< Lone continuation */
+constexpr std::uint8_t kUtf8Overlong3 = 1 << 2;  /*!< E0 80..9F */
+constexpr std::uint8_t kUtf8TooLarge = 1 << 3;   /*!< F4 90..BF, F5..FF */
+constexpr std::uint8_t kUtf8Surrogate = 1 << 4;  /*!< ED A0..BF */
+constexpr std::uint8_t kUtf8Overlong2 = 1 << 5;  /*!< C0..C1 */
+constexpr std::uint8_t kUtf8TooLarge1000 = 1 << 6;
+constexpr std::uint8_t kUtf8Overlong4 = 1 << 6;  /*!< F0 80..8F */
+constexpr std::uint8_t kUtf8TwoConts = 1 << 7;
+constexpr std::uint8_t kUtf8Carry =
+    kUtf8TooShort | kUtf8TooLong | kUtf8TwoConts;
+
+/// Lookup tables, indexed by a nibble, in the _mm_setr_epi8 order
+struct Utf8Tables {
+  std::uint8_t byte_1_high[16];
+  std::uint8_t byte_1_low[16];
+  std::uint8_t byte_2_high[16];
+};
+
+constexpr Utf8Tables kUtf8Tables = {
+    // byte_1_high: high nibble of the previous byte
+    {
+        kUtf8TooLong, kUtf8TooLong, kUtf8TooLong, kUtf8TooLong,  // 0xxx ASCII
+        kUtf8TooLong, kUtf8TooLong, kUtf8TooLong, kUtf8TooLong,
+        kUtf8TwoConts, kUtf8TwoConts, kUtf8TwoConts,  // 10xx continuation
+        kUtf8TwoConts,
+        kUtf8TooShort | kUtf8Overlong2,  // 1100 2 bytes lead
+        kUtf8TooShort,                   // 1101 2 bytes lead
+        kUtf8TooShort | kUtf8Overlong3 | kUtf8Surrogate,  // 1110 3 bytes lead
+        kUtf8TooShort | kUtf8TooLarge | kUtf8TooLarge1000 |
+            kUtf8Overlong4,  // 1111 4 bytes lead
+    },
+    // byte_1_low: low nibble of the previous byte
+    {
+        kUtf8Carry | kUtf8Overlong3 | kUtf8Overlong2 | kUtf8Overlong4,  // 0000
+        kUtf8Carry | kUtf8Overlong2,                                   // 0001
+        kUtf8Carry,                                                    // 001x
+        kUtf8Carry,
+        kUtf8Carry | kUtf8TooLarge,                                    // 0100
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,                // 0101
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,  // 1xxx
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000 |
+            kUtf8Surrogate,  // 1101
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+        kUtf8Carry | kUtf8TooLarge | kUtf8TooLarge1000,
+    },
+    // byte_2_high: high nibble of the current byte
+    {
+        kUtf8TooShort, kUtf8TooShort, kUtf8TooShort, kUtf8TooShort,  // 0xxx
+        kUtf8TooShort, kUtf8TooShort, kUtf8TooShort, kUtf8TooShort,
+        kUtf8TooLong | kUtf8Overlong2 | kUtf8TwoConts | kUtf8Overlong3 |
+            kUtf8TooLarge1000 | kUtf8Overlong4,  // 1000
+        kUtf8TooLong | kUtf8Overlong2 | kUtf8TwoConts | kUtf8Overlong3 |
+            kUtf8TooLarge,  // 1001
+        kUtf8TooLong | kUtf8Overlong2 | kUtf8TwoConts | kUtf8Surrogate |
+            kUtf8TooLarge,  // 101x
+        kUtf8TooLong | kUtf8Overlong2 | kUtf8TwoConts | kUtf8Surrogate |
+            kUtf8TooLarge,
+        kUtf8TooShort, kUtf8TooShort, kUtf8TooShort, kUtf8TooShort,  // 11xx
+    },
+};
+
+/// Bytes greater than these, in the last 3 bytes of a block, start a sequence
+/// truncated by the end of the block
+constexpr std::uint8_t kUtf8IncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+/// Validation state carried from one block to the next
+struct Utf8StateSsse3 {
+  __m128i error;      /*!< Accumulated errors (non zero when invalid) */
+  __m128i previous;   /*!< Previous block */
+  __m128i incomplete; /*!< Truncated sequences at the end of previous */
+};
+
+ATB_SIMD_TARGET("ssse3")
+inline auto Utf8LookupSsse3(__m128i nibbles,
+                            const std::uint8_t* table) noexcept -> __m128i {
+  return _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)), nibbles);
+}
+
+ATB_SIMD_TARGET("ssse3")
+inline auto Utf8CheckBlockSsse3(__m128i input, Utf8StateSsse3& state) noexcept
+    -> void {
+  if (_mm_movemask_epi8(input) == 0) {
+    // ASCII only: only a sequence truncated by the previous block can fail
+    state.error = _mm_or_si128(state.error, state.incomplete);
+    return;
+  }
+
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  const __m128i prev1 = _mm_alignr_epi8(input, state.previous, 16 - 1);
+  const __m128i prev2 = _mm_alignr_epi8(input, state.previous, 16 - 2);
+  const __m128i prev3 = _mm_alignr_epi8(input, state.previous, 16 - 3);
+
+  const __m128i special = _mm_and_si128(
+      _mm_and_si128(
+          Utf8LookupSsse3(_mm_and_si128(_mm_srli_epi16(prev1, 4), nibble),
+                          kUtf8Tables.byte_1_high),
+          Utf8LookupSsse3(_mm_and_si128(prev1, nibble),
+                          kUtf8Tables.byte_1_low)),
+      Utf8LookupSsse3(_mm_and_si128(_mm_srli_epi16(input, 4), nibble),
+                      kUtf8Tables.byte_2_high));
+
+  // 3rd/4th bytes of a sequence MUST be continuations (the lookups only see
+  // pairs of bytes)
+  const __m128i must_be_continuation = _mm_and_si128(
+      _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+                   _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80))),
+      _mm_set1_epi8(static_cast<char>(0x80)));
+
+  state.error = _mm_or_si128(state.error,
+                             _mm_xor_si128(must_be_continuation, special));
+  state.incomplete = _mm_subs_epu8(
+      input, _mm_loadu_si128(
+                 reinterpret_cast<const __m128i*>(kUtf8IncompleteMax + 16)));
+  state.previous = input;
+}
+
+ATB_SIMD_TARGET("ssse3")
+inline auto Utf8IsValidSsse3(std::string_view str) noexcept -> bool {
+  Utf8StateSsse3 state = {_mm_setzero_si128(), _mm_setzero_si128(),
+                          _mm_setzero_si128()};
+
+  std::size_t i = 0;
+  for (; (i + 16) <= str.size(); i += 16) {
+    Utf8CheckBlockSsse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i)),
+        state);
+  }
+
+  if (i < str.size()) {
+    // Tail padded with 0s: a truncated sequence is followed by ASCII
+    char tail[16] = {};
+    std::memcpy(tail, str.data() + i, str.size() - i);
+    Utf8CheckBlockSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)),
+                        state);
+  }
+
+  state.error = _mm_or_si128(state.error, state.incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(state.error, _mm_setzero_si128())) ==
+         0xFFFF;
+}
+
+/// Validation state carried from one block to the next
+struct Utf8StateAvx2 {
+  __m256i error;      /*!< Accumulated errors (non zero when invalid) */
+  __m256i previous;   /*!< Previous block */
+  __m256i incomplete; /*!< Truncated sequences at the end of previous */
+};
+
+ATB_SIMD_TARGET("avx2")
+inline auto Utf8LookupAvx2(__m256i nibbles,
+                           const std::uint8_t* table) noexcept -> __m256i {
+  return _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(table))),
+      nibbles);
+}
+
+/// @return The bytes of \a input shifted by N, with the last N bytes of
+///         \a previous shifted in
+template <int N>
+ATB_SIMD_TARGET("avx2")
+inline auto Utf8PrevAvx2(__m256i input, __m256i previous) noexcept -> __m256i {
+  return _mm256_alignr_epi8(
+      input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Utf8CheckBlockAvx2(__m256i input, Utf8StateAvx2& state) noexcept
+    -> void {
+  if (_mm256_movemask_epi8(input) == 0) {
+    // ASCII only: only a sequence truncated by the previous block can fail
+    state.error = _mm256_or_si256(state.error, state.incomplete);
+    return;
+  }
+
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  const __m256i prev1 = Utf8PrevAvx2<1>(input, state.previous);
+  const __m256i prev2 = Utf8PrevAvx2<2>(input, state.previous);
+  const __m256i prev3 = Utf8PrevAvx2<3>(input, state.previous);
+
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(
+          Utf8LookupAvx2(_mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble),
+                         kUtf8Tables.byte_1_high),
+          Utf8LookupAvx2(_mm256_and_si256(prev1, nibble),
+                         kUtf8Tables.byte_1_low)),
+      Utf8LookupAvx2(_mm256_and_si256(_mm256_srli_epi16(input, 4), nibble),
+                     kUtf8Tables.byte_2_high));
+
+  // 3rd/4th bytes of a sequence MUST be continuations (the lookups only see
+  // pairs of bytes)
+  const __m256i must_be_continuation = _mm256_and_si256(
+      _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80))),
+      _mm256_set1_epi8(static_cast<char>(0x80)));
+
+  state.error = _mm256_or_si256(
+      state.error, _mm256_xor_si256(must_be_continuation, special));
+  state.incomplete = _mm256_subs_epu8(
+      input,
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kUtf8IncompleteMax)));
+  state.previous = input;
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Utf8IsValidAvx2(std::string_view str) noexcept -> bool {
+  Utf8StateAvx2 state = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+                         _mm256_setzero_si256()};
+
+  std::size_t i = 0;
+  for (; (i + 32) <= str.size(); i += 32) {
+    Utf8CheckBlockAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i)),
+        state);
+
+    // Bail out early on invalid inputs
+    if (((i & 1023u) == 0) && !_mm256_testz_si256(state.error, state.error)) {
+      return false;
+    }
+  }
+
+  if (i < str.size()) {
+    // Tail padded with 0s: a truncated sequence is followed by ASCII
+    char tail[32] = {};
+    std::memcpy(tail, str.data() + i, str.size() - i);
+    Utf8CheckBlockAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail)), state);
+  }
+
+  state.error = _mm256_or_si256(state.error, state.incomplete);
+  return _mm256_testz_si256(state.error, state.error) != 0;
+}
+
+ATB_SIMD_TARGET("sse2")
+inline auto Utf8CountSse2(std::string_view str) noexcept -> std::size_t {
+  // Not a continuation byte <=> (signed) byte > -65
+  const __m128i threshold = _mm_set1_epi8(-65);
+
+  std::size_t count = 0;
+  std::size_t i = 0;
+  while ((i + 16) <= str.size()) {
+    // Per byte counters, summed before they can overflow
+    const std::size_t blocks =
+        std::min<std::size_t>((str.size() - i) / 16, 255);
+    __m128i counters = _mm_setzero_si128();
+    for (std::size_t b = 0; b < blocks; ++b, i += 16) {
+      const __m128i input =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i));
+      counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(input, threshold));
+    }
+
+    const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+    count += static_cast<std::size_t>(_mm_cvtsi128_si32(sums)) +
+             static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+  }
+
+  return count + Utf8CountScalar(str.substr(i));
+}
+
+ATB_SIMD_TARGET("avx2")
+inline auto Utf8CountAvx2(std::string_view str) noexcept -> std::size_t {
+  // Not a continuation byte <=> (signed) byte > -65
+  const __m256i threshold = _mm256_set1_epi8(-65);
+
+  std::size_t count = 0;
+  std::size_t i = 0;
+  while ((i + 32) <= str.size()) {
+    // Per byte counters, summed before they can overflow
+    const std::size_t blocks =
+        std::min<std::size_t>((str.size() - i) / 32, 255);
+    __m256i counters = _mm256_setzero_si256();
+    for (std::size_t b = 0; b < blocks; ++b, i += 32) {
+      const __m256i input =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data() + i));
+      counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(input, threshold));
+    }
+
+    const __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+    const __m128i sums128 = _mm_add_epi64(_mm256_castsi256_si128(sums),
+                                          _mm256_extracti128_si256(sums, 1));
+    count += static_cast<std::size_t>(_mm_cvtsi128_si32(sums128)) +
+             static_cast<std::size_t>(_mm_extract_epi16(sums128, 4));
+  }
+
+  return count + Utf8CountSse2(str.substr(i));
+}
+
+#endif  // ATB_SIMD_X86
+
+}  // namespace details
+
+inline auto Utf8IsValid(std::string_view str) noexcept -> bool {
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return details::Utf8IsValidAvx2(str);
+    case simd::Isa::kSsse3:
+      return details::Utf8IsValidSsse3(str);
+    case simd::Isa::kSse2:
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+
+  return Utf8IsValidScalar(str);
+}
+
+inline auto Utf8Count(std::string_view str) noexcept -> std::size_t {
+#if ATB_SIMD_X86
+  switch (simd::DetectedIsa()) {
+    case simd::Isa::kAvx2:
+      return details::Utf8CountAvx2(str);
+    case simd::Isa::kSsse3:
+    case simd::Isa::kSse2:
+      return details::Utf8CountSse2(str);
+    case simd::Isa::kScalar:
+      break;
+  }
+#endif
+
+  return Utf8CountScalar(str);
+}
+
+}  // namespace atb
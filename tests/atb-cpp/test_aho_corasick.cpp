@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/aho_corasick.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+using Match = AhoCorasick::Match;
+
+/// Naive leftmost-longest search used as reference
+auto NaiveFind(const std::vector<std::string>& patterns, std::string_view str)
+    -> std::optional<Match> {
+  std::optional<Match> best;
+  for (std::size_t p = 0; p < patterns.size(); ++p) {
+    const auto pos = str.find(patterns[p]);
+    if (pos == std::string_view::npos) continue;
+
+    if (!best || (pos < best->position) ||
+        ((pos == best->position) && (patterns[p].size() > best->size))) {
+      best = Match{p, pos, patterns[p].size()};
+    }
+  }
+  return best;
+}
+
+auto RandomString(std::mt19937& gen, std::size_t size) -> std::string {
+  std::uniform_int_distribution<int> dist('a', 'd');
+  std::string str(size, '\0');
+  for (auto& c : str) c = static_cast<char>(dist(gen));
+  return str;
+}
+
+TEST(AtbAhoCorasickTest, Empty) {
+  const AhoCorasick ac;
+  EXPECT_EQ(ac.PatternsCount(), 0);
+  EXPECT_FALSE(ac.Contains(""));
+  EXPECT_FALSE(ac.Contains("foo"));
+  EXPECT_FALSE(ac.Find("foo").has_value());
+
+  // The empty pattern matches everything, at the beginning
+  const AhoCorasick empty_pattern({""});
+  EXPECT_TRUE(empty_pattern.Contains(""));
+  EXPECT_TRUE(empty_pattern.Contains("foo"));
+  EXPECT_EQ(empty_pattern.Find("foo"), (Match{0, 0, 0}));
+}
+
+TEST(AtbAhoCorasickTest, Nominal) {
+  const AhoCorasick ac({"he", "she", "his", "hers"});
+  EXPECT_EQ(ac.PatternsCount(), 4);
+  EXPECT_EQ(ac.ClassesCount(), 6);  // h, e, s, i, r + others
+
+  EXPECT_TRUE(ac.Contains("ushers"));
+  EXPECT_TRUE(ac.Contains("his"));
+  EXPECT_FALSE(ac.Contains("hi"));
+  EXPECT_FALSE(ac.Contains(""));
+
+  EXPECT_EQ(ac.Find("ushers"), (Match{1, 1, 3}));
+  EXPECT_EQ(ac.Find("hers"), (Match{3, 0, 4}));
+  EXPECT_EQ(ac.Find("a his"), (Match{2, 2, 3}));
+  EXPECT_FALSE(ac.Find("foo bar").has_value());
+
+  // Duplicated patterns: the first one wins
+  const AhoCorasick dup({"foo", "bar", "foo"});
+  EXPECT_EQ(dup.Find("a foo"), (Match{0, 2, 3}));
+}
+
+TEST(AtbAhoCorasickTest, ForEachMatch) {
+  const AhoCorasick ac({"he", "she", "his", "hers"});
+
+  std::vector<Match> matches;
+  ac.ForEachMatch("ushers", [&](Match m) {
+    matches.push_back(m);
+    return true;
+  });
+
+  ASSERT_EQ(matches.size(), 3);
+  EXPECT_EQ(matches[0], (Match{1, 1, 3}));
+  EXPECT_EQ(matches[1], (Match{0, 2, 2}));
+  EXPECT_EQ(matches[2], (Match{3, 2, 4}));
+
+  // Early stop
+  matches.clear();
+  ac.ForEachMatch("ushers", [&](Match m) {
+    matches.push_back(m);
+    return false;
+  });
+  EXPECT_EQ(matches.size(), 1);
+}
+
+TEST(AtbAhoCorasickTest, AllBytes) {
+  std::vector<std::string> patterns;
+  for (int b = 0; b < 256; ++b) {
+    patterns.emplace_back(1, static_cast<char>(b));
+  }
+  const AhoCorasick ac(patterns.begin(), patterns.end());
+  EXPECT_EQ(ac.ClassesCount(), 256);
+
+  EXPECT_EQ(ac.Find("\xFF"sv), (Match{255, 0, 1}));
+  EXPECT_EQ(ac.Find("\0"sv), (Match{0, 0, 1}));
+  EXPECT_EQ(ac.Find("a"sv), (Match{'a', 0, 1}));
+}
+
+TEST(AtbAhoCorasickTest, SameAsNaiveSearch) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> count(1, 10);
+  std::uniform_int_distribution<std::size_t> size(1, 5);
+
+  for (int i = 0; i < 300; ++i) {
+    std::vector<std::string> patterns(count(gen));
+    for (auto& p : patterns) p = RandomString(gen, size(gen));
+
+    const AhoCorasick ac(patterns.begin(), patterns.end());
+
+    for (int j = 0; j < 10; ++j) {
+      const auto str = RandomString(gen, 4 * size(gen));
+      const auto expected = NaiveFind(patterns, str);
+
+      EXPECT_EQ(ac.Find(str), expected) << str;
+      EXPECT_EQ(ac.Contains(str), expected.has_value()) << str;
+
+      std::size_t matches = 0;
+      ac.ForEachMatch(str, [&](Match m) {
+        EXPECT_EQ(str.substr(m.position, m.size), patterns[m.pattern]);
+        ++matches;
+        return true;
+      });
+      EXPECT_EQ(matches > 0, expected.has_value()) << str;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/arena.hpp"
+#include "gtest/gtest.h"
+
+namespace atb {
+namespace {
+
+TEST(AtbMonotonicArenaTest, Allocate) {
+  MonotonicArena arena(64);
+  EXPECT_EQ(arena.BlocksCount(), 0);
+  EXPECT_EQ(arena.BytesUsed(), 0);
+
+  auto* a = static_cast<char*>(arena.Allocate(3, 1));
+  auto* b = static_cast<char*>(arena.Allocate(8, 8));
+  EXPECT_EQ(arena.BlocksCount(), 1);
+  EXPECT_EQ(arena.BytesUsed(), 11);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0);
+  EXPECT_GE(b, a + 3);
+
+  // Current block exhausted
+  arena.Allocate(30, 1);
+  arena.Allocate(30, 1);
+  EXPECT_EQ(arena.BlocksCount(), 2);
+
+  // Big requests get their own block
+  arena.Allocate(100, 1);
+  EXPECT_EQ(arena.BlocksCount(), 3);
+
+  arena.Reset();
+  EXPECT_EQ(arena.BlocksCount(), 0);
+  EXPECT_EQ(arena.BytesUsed(), 0);
+}
+
+TEST(AtbMonotonicArenaTest, Copy) {
+  MonotonicArena arena(16);
+
+  std::vector<std::string_view> views;
+  for (int i = 0; i < 100; ++i) {
+    const std::string str = "string #" + std::to_string(i);
+    views.push_back(arena.Copy(str));
+  }
+
+  // All views remain valid
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(views[static_cast<std::size_t>(i)],
+              "string #" + std::to_string(i));
+  }
+
+  EXPECT_TRUE(arena.Copy("").empty());
+
+  // Moving the arena doesn't invalidate them
+  MonotonicArena other = std::move(arena);
+  EXPECT_EQ(views.front(), "string #0");
+  EXPECT_EQ(arena.BlocksCount(), 0);
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/ascii.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// Random string using a small alphabet, in random case
+auto RandomString(std::mt19937& gen, std::size_t size) -> std::string {
+  std::uniform_int_distribution<int> dist('a', 'c');
+  std::bernoulli_distribution upper;
+  std::string str(size, '\0');
+  for (auto& c : str) {
+    c = static_cast<char>(dist(gen));
+    if (upper(gen)) c = AsciiToUpper(c);
+  }
+  return str;
+}
+
+TEST(AtbAsciiTest, ToLowerToUpper) {
+  for (int i = 0; i < 256; ++i) {
+    const auto c = static_cast<char>(i);
+    const bool is_upper = (c >= 'A') && (c <= 'Z');
+    const bool is_lower = (c >= 'a') && (c <= 'z');
+
+    EXPECT_EQ(AsciiToLower(c), is_upper ? static_cast<char>(c + 32) : c) << i;
+    EXPECT_EQ(AsciiToUpper(c), is_lower ? static_cast<char>(c - 32) : c) << i;
+  }
+}
+
+TEST(AtbAsciiTest, Constexpr) {
+  static_assert(AsciiIEqualsScalar("Foo"sv, "fOO"sv));
+  static_assert(!AsciiIEqualsScalar("Foo"sv, "fOOd"sv));
+  static_assert(AsciiIFindScalar("a FOO b foo"sv, "Foo"sv) == 2);
+  static_assert(AsciiIRFindScalar("a FOO b foo"sv, "Foo"sv) == 8);
+}
+
+TEST(AtbAsciiTest, IEquals) {
+  // All bytes values, long enough to use the vectorized kernels
+  std::string lower;
+  std::string upper;
+  for (int i = 0; i < 256; ++i) {
+    lower.push_back(AsciiToLower(static_cast<char>(i)));
+    upper.push_back(AsciiToUpper(static_cast<char>(i)));
+  }
+
+  EXPECT_TRUE(AsciiIEquals(lower, upper));
+  EXPECT_TRUE(AsciiIEquals(lower.substr(7, 100), upper.substr(7, 100)));
+  EXPECT_FALSE(AsciiIEquals(lower, upper.substr(1)));
+
+  for (std::size_t i = 0; i < upper.size(); ++i) {
+    auto other = upper;
+    other[i] = static_cast<char>(other[i] ^ 0x01);
+    EXPECT_FALSE(AsciiIEquals(lower, other)) << i;
+  }
+}
+
+TEST(AtbAsciiTest, SameAsScalar) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> pattern_size(0, 40);
+  std::uniform_int_distribution<std::size_t> str_size(0, 200);
+
+  for (int i = 0; i < 500; ++i) {
+    const auto str = RandomString(gen, str_size(gen));
+    const auto pattern = RandomString(gen, pattern_size(gen) % 6);
+    const std::size_t pos = str_size(gen);
+
+    EXPECT_EQ(AsciiIFind(str, pattern), AsciiIFindScalar(str, pattern))
+        << str << " / " << pattern;
+    EXPECT_EQ(AsciiIFind(str, pattern, pos),
+              AsciiIFindScalar(str, pattern, pos))
+        << str << " / " << pattern << " / " << pos;
+    EXPECT_EQ(AsciiIRFind(str, pattern), AsciiIRFindScalar(str, pattern))
+        << str << " / " << pattern;
+    EXPECT_EQ(AsciiIRFind(str, pattern, pos),
+              AsciiIRFindScalar(str, pattern, pos))
+        << str << " / " << pattern << " / " << pos;
+
+    const auto other = RandomString(gen, str.size());
+    EXPECT_EQ(AsciiIEquals(str, other), AsciiIEqualsScalar(str, other));
+  }
+}
+
+TEST(AtbAsciiTest, SameAsStdFindOnLowerCase) {
+  const std::string str =
+      "The Quick Brown Fox Jumps Over The Lazy Dog, THE QUICK BROWN FOX";
+  std::string lower = str;
+  for (auto& c : lower) c = AsciiToLower(c);
+
+  for (auto pattern : {"the"sv, "quick brown"sv, "dog, the"sv, "x"sv,
+                       "fox"sv, "cat"sv, ""sv}) {
+    EXPECT_EQ(AsciiIFind(str, pattern), lower.find(pattern)) << pattern;
+    EXPECT_EQ(AsciiIRFind(str, pattern), lower.rfind(pattern)) << pattern;
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/char_set.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// Random string containing any byte values (including '\0' and >= 0x80)
+auto RandomBytes(std::mt19937& gen, std::size_t size, int first = 0,
+                 int last = 255) -> std::string {
+  std::uniform_int_distribution<int> dist(first, last);
+  std::string str(size, '\0');
+  for (auto& c : str) c = static_cast<char>(dist(gen));
+  return str;
+}
+
+TEST(AtbCharSetTest, Contains) {
+  constexpr CharSet empty;
+  static_assert(empty.Empty());
+  static_assert(!empty.Contains('a'));
+
+  constexpr CharSet set("a\x7F\x80\xFF"sv);
+  static_assert(!set.Empty());
+  static_assert(set.Contains('a'));
+  static_assert(set.Contains('\x7F'));
+  static_assert(set.Contains('\x80'));
+  static_assert(set.Contains('\xFF'));
+  static_assert(!set.Contains('b'));
+  static_assert(!set.Contains('\0'));
+
+  CharSet other;
+  other.Insert('\0').Insert('z');
+  EXPECT_TRUE(other.Contains('\0'));
+  EXPECT_TRUE(other.Contains('z'));
+  EXPECT_FALSE(other.Contains('a'));
+}
+
+TEST(AtbCharSetTest, Find) {
+  const CharSet set(" \t"sv);
+  EXPECT_EQ(set.Find(""), CharSet::npos);
+  EXPECT_EQ(set.Find("foo"), CharSet::npos);
+  EXPECT_EQ(set.Find("foo bar\tbaz"), 3);
+  EXPECT_EQ(set.Find("foo bar\tbaz", 4), 7);
+  EXPECT_EQ(set.Find("foo bar\tbaz", 8), CharSet::npos);
+  EXPECT_EQ(set.Find("foo bar\tbaz", 42), CharSet::npos);
+
+  // Hits located after the vectorized chunks
+  const std::string str = std::string(100, 'x') + "\t";
+  EXPECT_EQ(set.Find(str), 100);
+  EXPECT_EQ(set.Find(std::string(100, 'x')), CharSet::npos);
+  EXPECT_EQ(CharSet{}.Find(str), CharSet::npos);
+}
+
+TEST(AtbCharSetTest, RFind) {
+  const CharSet set(" \t"sv);
+  EXPECT_EQ(set.RFind(""), CharSet::npos);
+  EXPECT_EQ(set.RFind("foo"), CharSet::npos);
+  EXPECT_EQ(set.RFind("foo bar\tbaz"), 7);
+  EXPECT_EQ(set.RFind("foo bar\tbaz", 6), 3);
+  EXPECT_EQ(set.RFind("foo bar\tbaz", 2), CharSet::npos);
+
+  // Hits located before the vectorized chunks
+  const std::string str = "\t" + std::string(100, 'x');
+  EXPECT_EQ(set.RFind(str), 0);
+  EXPECT_EQ(set.RFind(std::string(100, 'x')), CharSet::npos);
+  EXPECT_EQ(CharSet{}.RFind(str), CharSet::npos);
+}
+
+TEST(AtbCharSetTest, SameAsStdFindFirstLastOf) {
+  std::mt19937 gen(42);
+
+  for (int i = 0; i < 200; ++i) {
+    const auto chars = RandomBytes(gen, static_cast<std::size_t>(i % 12));
+    const auto str = RandomBytes(gen, static_cast<std::size_t>(i * 3) % 150);
+    const std::string_view sv = str;
+    const CharSet set(chars);
+
+    for (std::size_t pos : {std::size_t{0}, std::size_t{5}, sv.size() / 2}) {
+      EXPECT_EQ(set.Find(sv, pos), sv.find_first_of(chars, pos))
+          << "i = " << i << " pos = " << pos;
+      EXPECT_EQ(set.RFind(sv, pos), sv.find_last_of(chars, pos))
+          << "i = " << i << " pos = " << pos;
+    }
+    EXPECT_EQ(set.RFind(sv), sv.find_last_of(chars)) << "i = " << i;
+  }
+}
+
+#if ATB_SIMD_X86
+TEST(AtbCharSetTest, VectorizedKernels) {
+  std::mt19937 gen(24);
+
+  for (int i = 0; i < 200; ++i) {
+    const auto chars = RandomBytes(gen, static_cast<std::size_t>(1 + i % 6));
+    const auto str = RandomBytes(gen, static_cast<std::size_t>(i * 7) % 300);
+    const std::string_view sv = str;
+    const CharSet set(chars);
+
+    if (simd::DetectedIsa() >= simd::Isa::kSsse3) {
+      EXPECT_EQ(details::CharSetFindSsse3(set, sv, 0), sv.find_first_of(chars));
+      EXPECT_EQ(details::CharSetRFindSsse3(set, sv, sv.size()),
+                sv.find_last_of(chars));
+    }
+
+    if (simd::DetectedIsa() >= simd::Isa::kAvx2) {
+      EXPECT_EQ(details::CharSetFindAvx2(set, sv, 0), sv.find_first_of(chars));
+      EXPECT_EQ(details::CharSetRFindAvx2(set, sv, sv.size()),
+                sv.find_last_of(chars));
+    }
+  }
+}
+#endif
+
+}  // namespace
+}  // namespace atb
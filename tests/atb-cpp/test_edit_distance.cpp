@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/edit_distance.hpp"
+#include "atb-cpp/matchers.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// O(n * m) dynamic programming reference
+auto ReferenceDistance(std::string_view pattern, std::string_view str,
+                       bool search) -> std::size_t {
+  std::vector<std::size_t> column(pattern.size() + 1);
+  for (std::size_t i = 0; i <= pattern.size(); ++i) column[i] = i;
+  std::size_t best = column.back();
+
+  for (std::size_t j = 1; j <= str.size(); ++j) {
+    std::size_t diagonal = column[0];
+    column[0] = search ? 0 : j;
+    for (std::size_t i = 1; i <= pattern.size(); ++i) {
+      const std::size_t above = column[i];
+      column[i] = std::min({column[i] + 1, column[i - 1] + 1,
+                            diagonal + (pattern[i - 1] == str[j - 1] ? 0 : 1)});
+      diagonal = above;
+    }
+    best = std::min(best, column.back());
+  }
+  return search ? best : column.back();
+}
+
+TEST(AtbEditDistanceTest, StrNear) {
+  const auto near = StrNear("kitten", 2);
+  EXPECT_EQ(near.PatternSize(), 6u);
+  EXPECT_EQ(near.MaxEdits(), 2u);
+  EXPECT_EQ(near.GetMode(), StrNearMatcher::Mode::kFullMatch);
+
+  EXPECT_EQ(near.Distance("kitten"), 0u);
+  EXPECT_EQ(near.Distance("sitten"), 1u);
+  EXPECT_EQ(near.Distance("sitting"), 3u);
+  EXPECT_EQ(near.Distance(""), 6u);
+  EXPECT_EQ(near.Distance("a much longer string"), 18u);
+
+  EXPECT_EQ(near.Score("kitten"), 0u);
+  EXPECT_EQ(near.Score("kiten"), 1u);
+  EXPECT_EQ(near.Score("kitchen"), 2u);
+  EXPECT_EQ(near.Score("sitting"), std::nullopt);
+  EXPECT_EQ(near.Score("kit"), std::nullopt);
+
+  EXPECT_TRUE(::IsMatching(near, "mitten"));
+  EXPECT_FALSE(::IsMatching(near, "mittens!"));
+  EXPECT_TRUE(::IsMatching(AnyOf(near, StrNear("dog", 1)), "dig"));
+
+  const auto empty = StrNear("", 1);
+  EXPECT_EQ(empty.Score(""), 0u);
+  EXPECT_EQ(empty.Score("a"), 1u);
+  EXPECT_EQ(empty.Score("ab"), std::nullopt);
+}
+
+TEST(AtbEditDistanceTest, StrContainsNear) {
+  const auto near = StrContainsNear("kitten", 1);
+  EXPECT_EQ(near.GetMode(), StrNearMatcher::Mode::kSearch);
+
+  EXPECT_EQ(near.Distance("my kitten is cute"), 0u);
+  EXPECT_EQ(near.Distance("my kiten is cute"), 1u);
+  EXPECT_EQ(near.Distance("my kit is cute"), 3u);
+  EXPECT_EQ(near.Distance(""), 6u);
+
+  EXPECT_TRUE(::IsMatching(near, "my kiten is cute"));
+  EXPECT_TRUE(::IsMatching(near, "kittens"));
+  EXPECT_FALSE(::IsMatching(near, "my kit is cute"));
+
+  EXPECT_EQ(StrContainsNear("", 0).Score("foo"), 0u);
+}
+
+TEST(AtbEditDistanceTest, StrEditDistance) {
+  EXPECT_EQ(StrEditDistance("", ""), 0u);
+  EXPECT_EQ(StrEditDistance("abc", ""), 3u);
+  EXPECT_EQ(StrEditDistance("", "abc"), 3u);
+  EXPECT_EQ(StrEditDistance("flaw", "lawn"), 2u);
+  EXPECT_EQ(StrEditDistance("lawn", "flaw"), 2u);
+  EXPECT_EQ(StrEditDistance("intention", "execution"), 5u);
+}
+
+TEST(AtbEditDistanceTest, ScoreAll) {
+  const std::vector<std::string> names = {"Alice", "alice", "Alicia", "Bob",
+                                          "Alex"};
+  std::vector<std::optional<std::size_t>> scores;
+  StrNear("Alice", 1).ScoreAll(names, std::back_inserter(scores));
+
+  EXPECT_EQ(scores, (std::vector<std::optional<std::size_t>>{
+                        0u, 1u, std::nullopt, std::nullopt, std::nullopt}));
+}
+
+TEST(AtbEditDistanceTest, SameAsReference) {
+  // Single and multi blocks (> 64 chars) patterns
+  std::mt19937 gen{42};
+  const auto random_str = [&gen](std::size_t size) {
+    std::uniform_int_distribution<int> dist{'a', 'd'};
+    std::string str(size, ' ');
+    for (auto& c : str) c = static_cast<char>(dist(gen));
+    return str;
+  };
+
+  for (const std::size_t size : {1u, 5u, 63u, 64u, 65u, 100u, 128u, 200u}) {
+    for (int n = 0; n < 20; ++n) {
+      const std::string pattern = random_str(size);
+
+      // Candidates close to the pattern, or not
+      std::string str = pattern;
+      std::uniform_int_distribution<std::size_t> pos_dist{0, size};
+      const int edits = n % 6;
+      for (int e = 0; e < edits; ++e) {
+        const std::size_t pos = pos_dist(gen) % (str.size() + 1);
+        switch (e % 3) {
+          case 0:
+            str.insert(pos, 1, 'x');
+            break;
+          case 1:
+            if (pos < str.size()) str.erase(pos, 1);
+            break;
+          default:
+            if (pos < str.size()) str[pos] = 'y';
+            break;
+        }
+      }
+      if (n % 7 == 6) str = random_str(size + (size / 2));
+
+      for (const auto mode : {StrNearMatcher::Mode::kFullMatch,
+                              StrNearMatcher::Mode::kSearch}) {
+        const bool search = mode == StrNearMatcher::Mode::kSearch;
+        const std::size_t expected = ReferenceDistance(pattern, str, search);
+        const StrNearMatcher near{pattern, 3, mode};
+
+        EXPECT_EQ(near.Distance(str), expected)
+            << "pattern: " << pattern << " str: " << str;
+        EXPECT_EQ(near.Score(str), expected <= 3
+                                       ? std::optional<std::size_t>{expected}
+                                       : std::nullopt);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,411 @@
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "atb-cpp/encoding.hpp"
+#include "atb-cpp/simd.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// Random bytes of size \a size
+auto RandomBytes(std::mt19937& gen, std::size_t size) -> std::string {
+  std::uniform_int_distribution<int> byte(0x00, 0xFF);
+  std::string bytes(size, '\0');
+  for (auto& c : bytes) c = static_cast<char>(byte(gen));
+  return bytes;
+}
+
+using EncodeFunction = std::optional<char*> (*)(std::string_view, char*,
+                                                std::size_t);
+using DecodeFunction = std::optional<char*> (*)(std::string_view, char*,
+                                                std::size_t, std::size_t*);
+
+/// @return The output of \a encode written in a buffer of size \a d_size
+auto Encode(EncodeFunction encode, std::string_view input, std::size_t d_size)
+    -> std::optional<std::string> {
+  std::string output(d_size, '\0');
+  const auto last = encode(input, output.data(), output.size());
+  if (!last) return std::nullopt;
+  output.resize(static_cast<std::size_t>(*last - output.data()));
+  return output;
+}
+
+/// @return The output of \a decode written in a buffer of size \a d_size
+auto Decode(DecodeFunction decode, std::string_view input, std::size_t d_size)
+    -> std::optional<std::string> {
+  std::string output(d_size, '\0');
+  const auto last = decode(input, output.data(), output.size(), nullptr);
+  if (!last) return std::nullopt;
+  output.resize(static_cast<std::size_t>(*last - output.data()));
+  return output;
+}
+
+constexpr EncodeFunction kHexEncoders[] = {StrHexEncodeScalar, StrHexEncode};
+constexpr DecodeFunction kHexDecoders[] = {StrHexDecodeScalar, StrHexDecode};
+constexpr EncodeFunction kBase64Encoders[] = {StrBase64EncodeScalar,
+                                              StrBase64Encode};
+constexpr DecodeFunction kBase64Decoders[] = {StrBase64DecodeScalar,
+                                              StrBase64Decode};
+
+TEST(AtbEncodingTest, Sizes) {
+  static_assert(HexEncodedSize(0) == 0);
+  static_assert(HexEncodedSize(3) == 6);
+  static_assert(HexDecodedSize("abcd"sv) == 2);
+  static_assert(!HexDecodedSize("abc"sv));
+
+  static_assert(Base64EncodedSize(0) == 0);
+  static_assert(Base64EncodedSize(1) == 4);
+  static_assert(Base64EncodedSize(3) == 4);
+  static_assert(Base64EncodedSize(4) == 8);
+  static_assert(Base64DecodedSize("Zm9v"sv) == 3);
+  static_assert(Base64DecodedSize("Zm8="sv) == 2);
+  static_assert(Base64DecodedSize("Zg=="sv) == 1);
+  static_assert(!Base64DecodedSize("Zg="sv));
+}
+
+TEST(AtbEncodingTest, Constexpr) {
+  constexpr auto kEncoded = [] {
+    std::array<char, 4> buffer = {};
+    StrHexEncodeScalar("\x01\xAB"sv, buffer.data(), buffer.size());
+    return buffer;
+  }();
+  static_assert(std::string_view(kEncoded.data(), kEncoded.size()) == "01ab");
+
+  constexpr auto kDecoded = [] {
+    std::array<char, 3> buffer = {};
+    StrBase64DecodeScalar("Zm9v"sv, buffer.data(), buffer.size());
+    return buffer;
+  }();
+  static_assert(std::string_view(kDecoded.data(), kDecoded.size()) == "foo");
+
+  constexpr auto kJson = [] {
+    std::array<char, 7> buffer = {};
+    StrEscapeJsonScalar("a\"b\nc"sv, buffer.data(), buffer.size());
+    return buffer;
+  }();
+  static_assert(std::string_view(kJson.data(), kJson.size()) == R"(a\"b\nc)");
+
+  constexpr auto kCsv = [] {
+    std::array<char, 7> buffer = {};
+    StrEscapeCsvScalar("a,\"b"sv, buffer.data(), buffer.size());
+    return buffer;
+  }();
+  static_assert(std::string_view(kCsv.data(), kCsv.size()) == R"("a,""b")");
+}
+
+TEST(AtbEncodingTest, Hex) {
+  for (auto encode : kHexEncoders) {
+    EXPECT_EQ(Encode(encode, "", 0), "");
+    EXPECT_EQ(Encode(encode, "\x01\xAB\xff"sv, 6), "01abff");
+    EXPECT_EQ(Encode(encode, "\x01\xAB\xff"sv, 10), "01abff");
+    EXPECT_FALSE(Encode(encode, "\x01\xAB\xff"sv, 5));
+  }
+
+  for (auto decode : kHexDecoders) {
+    EXPECT_EQ(Decode(decode, "", 0), "");
+    EXPECT_EQ(Decode(decode, "01abFF", 3), "\x01\xAB\xFF"sv);
+    EXPECT_EQ(Decode(decode, "01abFF", 8), "\x01\xAB\xFF"sv);
+    EXPECT_FALSE(Decode(decode, "01abFF", 2));
+    EXPECT_FALSE(Decode(decode, "01abF", 3));
+    EXPECT_FALSE(Decode(decode, "01agFF", 3));
+  }
+}
+
+TEST(AtbEncodingTest, Base64) {
+  // RFC 4648 test vectors
+  constexpr std::pair<std::string_view, std::string_view> kVectors[] = {
+      {"", ""},          {"f", "Zg=="},         {"fo", "Zm8="},
+      {"foo", "Zm9v"},   {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="},
+      {"foobar", "Zm9vYmFy"},
+  };
+
+  for (auto [data, base64] : kVectors) {
+    for (auto encode : kBase64Encoders) {
+      EXPECT_EQ(Encode(encode, data, base64.size()), base64);
+      if (!base64.empty()) {
+        EXPECT_FALSE(Encode(encode, data, base64.size() - 1));
+      }
+    }
+    for (auto decode : kBase64Decoders) {
+      EXPECT_EQ(Decode(decode, base64, data.size()), data);
+      if (!data.empty()) {
+        EXPECT_FALSE(Decode(decode, base64, data.size() - 1));
+      }
+    }
+  }
+
+  for (auto decode : kBase64Decoders) {
+    EXPECT_EQ(Decode(decode, "+/+/", 3), "\xFB\xFF\xBF"sv);
+    EXPECT_FALSE(Decode(decode, "Zm9", 3));       // Not a multiple of 4
+    EXPECT_FALSE(Decode(decode, "Zm-v", 3));      // Invalid char
+    EXPECT_FALSE(Decode(decode, "Zg==Zm9v", 6));  // Padding in the middle
+    EXPECT_FALSE(Decode(decode, "Z===", 3));      // Too much padding
+  }
+}
+
+TEST(AtbEncodingTest, SameAsScalar) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> size(0, 300);
+
+  for (int i = 0; i < 300; ++i) {
+    const auto data = RandomBytes(gen, size(gen));
+
+    const auto hex =
+        Encode(StrHexEncodeScalar, data, HexEncodedSize(data.size()));
+    ASSERT_TRUE(hex);
+    EXPECT_EQ(Encode(StrHexEncode, data, hex->size()), hex);
+    EXPECT_EQ(Decode(StrHexDecode, *hex, data.size()), data);
+
+    std::string upper = *hex;
+    for (auto& c : upper) {
+      if ((c >= 'a') && (c <= 'f')) c = static_cast<char>(c - 'a' + 'A');
+    }
+    EXPECT_EQ(Decode(StrHexDecode, upper, data.size()), data);
+
+    const auto base64 =
+        Encode(StrBase64EncodeScalar, data, Base64EncodedSize(data.size()));
+    ASSERT_TRUE(base64);
+    EXPECT_EQ(Encode(StrBase64Encode, data, base64->size()), base64);
+    EXPECT_EQ(Decode(StrBase64Decode, *base64, data.size()), data);
+  }
+}
+
+TEST(AtbEncodingTest, InvalidWhere) {
+  std::mt19937 gen(42);
+  const auto data = RandomBytes(gen, 200);
+
+  std::string hex;
+  ASSERT_EQ(StrAppendHex(data, hex), 400);
+  std::string base64;
+  ASSERT_EQ(StrAppendBase64(data, base64), Base64EncodedSize(200));
+
+  // Each position, whatever the kernel handling it
+  for (std::size_t where = 0; where < hex.size(); where += 7) {
+    for (char invalid : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xFF'}) {
+      auto corrupted = hex;
+      corrupted[where] = invalid;
+
+      std::string buffer(data.size(), '\0');
+      std::size_t found = 0;
+      EXPECT_FALSE(
+          StrHexDecode(corrupted, buffer.data(), buffer.size(), &found));
+      EXPECT_EQ(found, where);
+    }
+  }
+
+  for (std::size_t where = 0; where < (base64.size() - 4); where += 5) {
+    for (char invalid : {'-', '_', '=', '.', '*', ' ', '\x80', '\xFF'}) {
+      auto corrupted = base64;
+      corrupted[where] = invalid;
+
+      std::string buffer(data.size(), '\0');
+      std::size_t found = 0;
+      EXPECT_FALSE(
+          StrBase64Decode(corrupted, buffer.data(), buffer.size(), &found));
+      EXPECT_EQ(found, where);
+    }
+  }
+}
+
+TEST(AtbEncodingTest, Kernels) {
+#if ATB_SIMD_X86
+  std::mt19937 gen(7);
+  const auto data = RandomBytes(gen, 1000);
+  const auto hex =
+      Encode(StrHexEncodeScalar, data, HexEncodedSize(data.size()));
+  const auto base64 =
+      Encode(StrBase64EncodeScalar, data, Base64EncodedSize(data.size()));
+
+  std::string buffer(4000, '\0');
+  const auto check = [&](auto kernel, std::string_view input,
+                         std::string_view expected, std::size_t in,
+                         std::size_t out) {
+    const std::size_t done = kernel(input, buffer.data());
+    EXPECT_GT(done, 0u);
+    EXPECT_EQ(std::string_view(buffer.data(), (done / in) * out),
+              expected.substr(0, (done / in) * out));
+  };
+
+  if (simd::DetectedIsa() >= simd::Isa::kSsse3) {
+    check(details::HexEncodeSsse3, data, *hex, 1, 2);
+    check(details::HexDecodeSsse3, *hex, data, 2, 1);
+    check(details::Base64EncodeSsse3, data, *base64, 3, 4);
+    check(details::Base64DecodeSsse3, *base64, data, 4, 3);
+  }
+  if (simd::DetectedIsa() >= simd::Isa::kAvx2) {
+    check(details::HexEncodeAvx2, data, *hex, 1, 2);
+    check(details::HexDecodeAvx2, *hex, data, 2, 1);
+    check(details::Base64EncodeAvx2, data, *base64, 3, 4);
+    check(details::Base64DecodeAvx2, *base64, data, 4, 3);
+  }
+#else
+  GTEST_SKIP() << "No SIMD kernels";
+#endif
+}
+
+TEST(AtbEncodingTest, Append) {
+  std::string str = "id=";
+  EXPECT_EQ(StrAppendHex("\xDE\xAD\xBE\xEF"sv, str), 8);
+  EXPECT_EQ(str, "id=deadbeef");
+
+  EXPECT_EQ(StrAppendBase64(" foobar", str), 12);
+  EXPECT_EQ(str, "id=deadbeefIGZvb2Jhcg==");
+
+  std::string decoded = ">";
+  EXPECT_EQ(StrAppendHexDecoded("DEADbeef", decoded), 4);
+  EXPECT_EQ(StrAppendBase64Decoded("IGZvb2Jhcg==", decoded), 7);
+  EXPECT_EQ(decoded, ">\xDE\xAD\xBE\xEF foobar"sv);
+
+  // Left untouched on error
+  std::size_t where = 0;
+  EXPECT_FALSE(StrAppendHexDecoded("00zz", decoded, &where));
+  EXPECT_EQ(where, 2);
+  EXPECT_FALSE(StrAppendBase64Decoded("Zm9", decoded));
+  EXPECT_FALSE(StrAppendBase64Decoded("Zm9!", decoded, &where));
+  EXPECT_EQ(where, 3);
+  EXPECT_EQ(decoded, ">\xDE\xAD\xBE\xEF foobar"sv);
+}
+
+/// @return \a str JSON escaped, using a per char loop
+auto JsonEscapeReference(std::string_view str) -> std::string {
+  std::string escaped;
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\r':
+        escaped += "\\r";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      case '\b':
+        escaped += "\\b";
+        break;
+      case '\f':
+        escaped += "\\f";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          constexpr std::string_view kDigits = "0123456789abcdef";
+          escaped += "\\u00";
+          escaped += kDigits[static_cast<unsigned char>(c) >> 4];
+          escaped += kDigits[static_cast<unsigned char>(c) & 0x0F];
+        } else {
+          escaped += c;
+        }
+        break;
+    }
+  }
+  return escaped;
+}
+
+TEST(AtbEncodingTest, EscapeJson) {
+  static_assert(details::JsonFindScalar("abc\"d"sv, 0) == 3);
+
+  for (auto [str, escaped] : {
+           std::pair{""sv, ""sv},
+           std::pair{"foo"sv, "foo"sv},
+           std::pair{"say \"hi\"\n"sv, R"(say \"hi\"\n)"sv},
+           std::pair{"C:\\dir\t\r\b\f"sv, R"(C:\\dir\t\r\b\f)"sv},
+           std::pair{"\x01\x1F\x7F"sv, "\\u0001\\u001f\x7F"sv},
+           std::pair{"caf\xC3\xA9"sv, "caf\xC3\xA9"sv},
+       }) {
+    EXPECT_EQ(StrEscapedJsonSize(str), escaped.size());
+    EXPECT_EQ(Encode(StrEscapeJsonScalar, str, escaped.size()), escaped);
+    EXPECT_EQ(Encode(StrEscapeJson, str, escaped.size() + 3), escaped);
+    if (!escaped.empty()) {
+      EXPECT_FALSE(Encode(StrEscapeJson, str, escaped.size() - 1));
+    }
+  }
+
+  std::string str = "{\"msg\":\"";
+  EXPECT_EQ(StrAppendEscapedJson("a\"b", str), 4);
+  str += "\"}";
+  EXPECT_EQ(str, R"({"msg":"a\"b"})");
+}
+
+TEST(AtbEncodingTest, EscapeJsonSameAsReference) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> size(0, 200);
+  std::uniform_int_distribution<int> dirty(0, 40);
+
+  for (int i = 0; i < 300; ++i) {
+    // Mostly clean, with some chars to escape at random positions
+    std::string str(size(gen), 'x');
+    for (auto& c : str) {
+      if (dirty(gen) == 0) c = "\"\\\n\x01\x1F"[dirty(gen) % 5];
+    }
+
+    const auto expected = JsonEscapeReference(str);
+    EXPECT_EQ(Encode(StrEscapeJsonScalar, str, expected.size()), expected);
+    EXPECT_EQ(Encode(StrEscapeJson, str, expected.size()), expected);
+
+    std::string appended = "prefix";
+    EXPECT_EQ(StrAppendEscapedJson(str, appended), expected.size());
+    EXPECT_EQ(appended, "prefix" + expected);
+  }
+}
+
+TEST(AtbEncodingTest, EscapeCsv) {
+  for (auto [str, escaped] : {
+           std::pair{""sv, ""sv},
+           std::pair{"foo bar"sv, "foo bar"sv},
+           std::pair{"a,b"sv, R"("a,b")"sv},
+           std::pair{"a,\"b\""sv, R"("a,""b""")"sv},
+           std::pair{"line\nbreak"sv, "\"line\nbreak\""sv},
+           std::pair{"cr\r"sv, "\"cr\r\""sv},
+           std::pair{"\""sv, R"("""")"sv},
+           std::pair{"a;b"sv, "a;b"sv},
+       }) {
+    EXPECT_EQ(StrEscapedCsvSize(str), escaped.size());
+    EXPECT_EQ(Encode(
+                  [](std::string_view s, char* d_first, std::size_t d_size) {
+                    return StrEscapeCsvScalar(s, d_first, d_size);
+                  },
+                  str, escaped.size()),
+              escaped);
+
+    std::string appended;
+    EXPECT_EQ(StrAppendEscapedCsv(str, appended), escaped.size());
+    EXPECT_EQ(appended, escaped);
+  }
+
+  // Custom separator
+  std::string line;
+  StrAppendEscapedCsv("a;b", line, ';');
+  line += ';';
+  StrAppendEscapedCsv("a,b", line, ';');
+  EXPECT_EQ(line, "\"a;b\";a,b");
+
+  // Long fields, quotes after the SIMD blocks
+  const std::string clean(100, 'x');
+  const std::string dirty = clean + "\"" + clean;
+  std::string buffer(300, '\0');
+  const auto last = StrEscapeCsv(dirty, buffer.data(), buffer.size());
+  ASSERT_TRUE(last);
+  EXPECT_EQ(std::string_view(buffer.data(),
+                             static_cast<std::size_t>(*last - buffer.data())),
+            "\"" + clean + "\"\"" + clean + "\"");
+  EXPECT_EQ(StrEscapeCsv(clean, buffer.data(), buffer.size()),
+            buffer.data() + clean.size());
+  EXPECT_FALSE(StrEscapeCsv(dirty, buffer.data(), 203));
+}
+
+}  // namespace
+}  // namespace atb
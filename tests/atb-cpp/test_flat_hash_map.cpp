@@ -0,0 +1,282 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/flat_hash_map.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// @return The value associated to \a key into \a map, or \a missing
+template <class Map, class K, class V>
+auto FindOr(const Map& map, const K& key, V missing) -> V {
+  const auto* value = map.Find(key);
+  return value == nullptr ? missing : *value;
+}
+
+TEST(AtbFlatHashMapTest, Basics) {
+  FlatHashMap<std::string, int> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Size(), 0u);
+  EXPECT_EQ(map.Capacity(), 0u);
+  EXPECT_EQ(map.Find("foo"sv), nullptr);
+  EXPECT_FALSE(map.Contains("foo"sv));
+  EXPECT_FALSE(map.Erase("foo"sv));
+  EXPECT_EQ(map.begin(), map.end());
+
+  const auto [foo, inserted] = map.TryEmplace("foo"sv, 1);
+  ASSERT_NE(foo, nullptr);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*foo, 1);
+  EXPECT_EQ(map.Size(), 1u);
+  EXPECT_EQ(map.Capacity(), 16u);
+
+  // Already present: no overwrite
+  const auto [other_foo, other_inserted] = map.TryEmplace("foo", 2);
+  EXPECT_EQ(other_foo, foo);
+  EXPECT_FALSE(other_inserted);
+  EXPECT_EQ(*foo, 1);
+
+  map["bar"] = 3;
+  map[std::string{"bar"}] += 1;
+  EXPECT_EQ(map.Size(), 2u);
+
+  // Heterogeneous lookups
+  EXPECT_EQ(map.Find("foo"sv), foo);
+  EXPECT_EQ(FindOr(map, "bar", 0), 4);
+  EXPECT_EQ(FindOr(map, std::string{"bar"}, 0), 4);
+  EXPECT_TRUE(map.Contains("bar"sv));
+  EXPECT_FALSE(map.Contains("baz"sv));
+
+  const auto& cmap = map;
+  EXPECT_EQ(FindOr(cmap, "foo"sv, 0), 1);
+
+  EXPECT_TRUE(map.Erase("foo"sv));
+  EXPECT_FALSE(map.Erase("foo"sv));
+  EXPECT_FALSE(map.Contains("foo"sv));
+  EXPECT_EQ(map.Size(), 1u);
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Capacity(), 16u);
+  EXPECT_FALSE(map.Contains("bar"sv));
+}
+
+TEST(AtbFlatHashMapTest, NotTransparent) {
+  FlatHashMap<int, std::string, std::hash<int>, std::equal_to<int>> map{
+      {1, "one"}, {2, "two"}, {1, "uno"}};
+
+  EXPECT_EQ(map.Size(), 2u);
+  EXPECT_EQ(FindOr(map, 1, std::string{}), "one");
+  EXPECT_EQ(FindOr(map, 2, std::string{}), "two");
+  EXPECT_EQ(map.Find(3), nullptr);
+
+  const int three = 3;
+  map[three] = "three";
+  map[4] = "four";
+  EXPECT_TRUE(map.Contains(3));
+  EXPECT_TRUE(map.Erase(4));
+  EXPECT_EQ(map.Size(), 3u);
+}
+
+TEST(AtbFlatHashMapTest, MixedWidthKeys) {
+  FlatHashMap<std::int64_t, int> map;
+  EXPECT_TRUE(map.TryEmplace(std::int64_t{-1}, 1).second);
+
+  // Equal values of other types find the same key
+  EXPECT_EQ(FindOr(map, -1, 0), 1);
+  EXPECT_EQ(FindOr(map, std::int8_t{-1}, 0), 1);
+  EXPECT_TRUE(map.Contains(short{-1}));
+  EXPECT_FALSE(map.TryEmplace(-1, 2).second);
+
+  map[-1] = 5;
+  EXPECT_EQ(map.Size(), 1u);
+  EXPECT_EQ(FindOr(map, std::int64_t{-1}, 0), 5);
+
+  map[std::uint8_t{200}] = 200;
+  map[-200] = -200;
+  EXPECT_EQ(map.Size(), 3u);
+  EXPECT_EQ(FindOr(map, std::int64_t{200}, 0), 200);
+  EXPECT_EQ(FindOr(map, 200u, 0), 200);
+  EXPECT_EQ(FindOr(map, std::int64_t{-200}, 0), -200);
+  EXPECT_EQ(map.Find(std::uint8_t{56}), nullptr);
+
+  EXPECT_TRUE(map.Erase(-1));
+  EXPECT_FALSE(map.Contains(std::int64_t{-1}));
+
+  FlatHashMap<std::uint32_t, int> unsigned_map;
+  unsigned_map[7u] = 7;
+  EXPECT_EQ(FindOr(unsigned_map, 7, 0), 7);
+  EXPECT_EQ(FindOr(unsigned_map, std::uint64_t{7}, 0), 7);
+}
+
+/// Hash of the keys converted to std::uint64_t (not sign extended)
+struct ZeroExtendHash {
+  using is_transparent = void;
+
+  template <class T>
+  auto operator()(T value) const noexcept -> std::size_t {
+    return std::hash<std::uint64_t>{}(
+        static_cast<std::make_unsigned_t<T>>(value));
+  }
+};
+
+TEST(AtbFlatHashMapTest, KeysNotRepresentable) {
+  FlatHashMap<std::uint8_t, int> small;
+  small[44] = 44;
+  EXPECT_EQ(small.Find(300), nullptr);
+  EXPECT_FALSE(small.Contains(-212));
+  EXPECT_FALSE(small.Erase(300));
+  EXPECT_EQ(FindOr(small, 44u, 0), 44);
+  EXPECT_THROW(small[300], std::invalid_argument);
+  EXPECT_THROW(small.TryEmplace(-1, 0), std::invalid_argument);
+  EXPECT_EQ(small.Size(), 1u);
+
+  FlatHashMap<int, int> ints;
+  ints[1] = 1;
+  EXPECT_EQ(ints.Find(1.5), nullptr);
+  EXPECT_FALSE(ints.Erase(1.9));
+  EXPECT_FALSE(ints.Contains(std::numeric_limits<double>::quiet_NaN()));
+  EXPECT_FALSE(ints.Contains(1e300));
+  EXPECT_EQ(FindOr(ints, 1.0, 0), 1);
+  EXPECT_THROW(ints[2.7], std::invalid_argument);
+  ints[2.0] = 2;
+  EXPECT_EQ(FindOr(ints, 2, 0), 2);
+  EXPECT_EQ(ints.Size(), 2u);
+
+  // Converted (when exact) with a custom hash
+  FlatHashMap<std::int64_t, int, ZeroExtendHash> custom;
+  custom[-1] = -1;
+  EXPECT_EQ(FindOr(custom, -1, 0), -1);
+  EXPECT_EQ(FindOr(custom, std::int8_t{-1}, 0), -1);
+  EXPECT_EQ(custom.Find(std::uint64_t{0xFFFFFFFFFFFFFFFF}), nullptr);
+  EXPECT_EQ(custom.Find(-1.5f), nullptr);
+}
+
+TEST(AtbFlatHashMapTest, Iterators) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i) map[i] = i * 2;
+
+  std::map<int, int> seen;
+  for (auto& [key, value] : map) {
+    seen[key] = value;
+    value += 1;
+  }
+  ASSERT_EQ(seen.size(), 100u);
+  for (const auto& [key, value] : seen) EXPECT_EQ(value, key * 2);
+
+  const auto& cmap = map;
+  std::size_t count = 0;
+  for (auto it = cmap.begin(); it != cmap.end(); ++it) {
+    EXPECT_EQ(it->second, (it->first * 2) + 1);
+    ++count;
+  }
+  EXPECT_EQ(count, 100u);
+
+  FlatHashMap<int, int>::const_iterator it = map.begin();
+  EXPECT_EQ(it, cmap.begin());
+}
+
+TEST(AtbFlatHashMapTest, CopyAndMove) {
+  FlatHashMap<std::string, std::unique_ptr<int>> moveonly;
+  moveonly.TryEmplace("foo", std::make_unique<int>(1));
+
+  auto moved = std::move(moveonly);
+  const auto* foo = moved.Find("foo"sv);
+  EXPECT_TRUE((foo != nullptr) && (*foo != nullptr) && (**foo == 1));
+  EXPECT_TRUE(moveonly.Empty());  // NOLINT(bugprone-use-after-move)
+
+  FlatHashMap<std::string, int> map;
+  for (int i = 0; i < 50; ++i) map[std::to_string(i)] = i;
+
+  FlatHashMap<std::string, int> copy = map;
+  map.Clear();
+  EXPECT_EQ(copy.Size(), 50u);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(FindOr(copy, std::to_string(i), -1), i);
+  }
+
+  map = copy;
+  EXPECT_EQ(map.Size(), 50u);
+  copy = std::move(map);
+  EXPECT_EQ(copy.Size(), 50u);
+
+  FlatHashMap<std::string, int> other;
+  other.Swap(copy);
+  EXPECT_EQ(other.Size(), 50u);
+  EXPECT_TRUE(copy.Empty());
+}
+
+TEST(AtbFlatHashMapTest, Reserve) {
+  FlatHashMap<int, int> map{1000};
+  const auto capacity = map.Capacity();
+  EXPECT_GE(capacity, 1000u);
+  EXPECT_EQ(capacity & (capacity - 1), 0u);
+
+  for (int i = 0; i < 1000; ++i) map[i] = i;
+  EXPECT_EQ(map.Capacity(), capacity);
+
+  map.Reserve(10);
+  EXPECT_EQ(map.Capacity(), capacity);
+}
+
+TEST(AtbFlatHashMapTest, SameAsStdMap) {
+  // Random insertions/erasures (many tombstones, rehashes...)
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> key_dist{0, 2000};
+  std::uniform_int_distribution<int> op_dist{0, 2};
+
+  FlatHashMap<std::string, int> map;
+  std::map<std::string, int> expected;
+  for (int n = 0; n < 50000; ++n) {
+    const std::string key = std::to_string(key_dist(gen));
+    switch (op_dist(gen)) {
+      case 0:
+        EXPECT_EQ(map.TryEmplace(key, n).second,
+                  expected.emplace(key, n).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.Erase(key), expected.erase(key) == 1);
+        break;
+      default: {
+        const auto found = expected.find(key);
+        const int value = FindOr(map, std::string_view{key}, -1);
+        EXPECT_EQ(value, found == expected.end() ? -1 : found->second);
+      } break;
+    }
+    ASSERT_EQ(map.Size(), expected.size());
+  }
+
+  std::map<std::string, int> content;
+  for (const auto& [key, value] : map) content.emplace(key, value);
+  EXPECT_EQ(content, expected);
+}
+
+TEST(AtbFlatHashMapTest, BadHash) {
+  // All keys share the same hash: falls back to linear search
+  struct ConstantHash {
+    auto operator()(int) const noexcept -> std::size_t { return 42; }
+  };
+
+  FlatHashMap<int, int, ConstantHash, std::equal_to<int>> map;
+  for (int i = 0; i < 200; ++i) map[i] = -i;
+  for (int i = 0; i < 200; i += 2) EXPECT_TRUE(map.Erase(i));
+  for (int i = 0; i < 200; ++i) EXPECT_EQ(map.Contains(i), (i % 2) == 1);
+  EXPECT_EQ(map.Size(), 100u);
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/format.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbFormatTest, StrPiece) {
+  EXPECT_EQ(StrPiece{"foo"}.View(), "foo"sv);
+  EXPECT_EQ(StrPiece{"foo"sv}.View(), "foo"sv);
+  EXPECT_EQ(StrPiece{std::string{"foo"}}.Size(), 3u);
+  EXPECT_EQ(StrPiece{'c'}.View(), "c"sv);
+  EXPECT_EQ(StrPiece{true}.View(), "true"sv);
+  EXPECT_EQ(StrPiece{false}.View(), "false"sv);
+
+  EXPECT_EQ(StrPiece{0}.View(), "0"sv);
+  EXPECT_EQ(StrPiece{-42}.View(), "-42"sv);
+  EXPECT_EQ(StrPiece{std::uint8_t{255}}.View(), "255"sv);
+  EXPECT_EQ(StrPiece{std::numeric_limits<std::int64_t>::min()}.View(),
+            "-9223372036854775808"sv);
+  EXPECT_EQ(StrPiece{std::numeric_limits<std::uint64_t>::max()}.View(),
+            "18446744073709551615"sv);
+
+  EXPECT_EQ(StrPiece{1.5}.View(), "1.5"sv);
+  EXPECT_EQ(StrPiece{-0.1f}.View(), "-0.1"sv);
+  EXPECT_EQ(StrPiece{std::numeric_limits<double>::lowest()}.View(),
+            "-1.7976931348623157e+308"sv);
+
+  // Copies keep their own buffer
+  StrPiece piece{123};
+  const StrPiece copy = piece;
+  piece = StrPiece{4};
+  EXPECT_EQ(copy.View(), "123"sv);
+  EXPECT_EQ(piece.View(), "4"sv);
+}
+
+TEST(AtbFormatTest, Format) {
+  EXPECT_EQ(Format(ATB_FMT("")), "");
+  EXPECT_EQ(Format(ATB_FMT("no args")), "no args");
+  EXPECT_EQ(Format(ATB_FMT("{}"), 1), "1");
+  EXPECT_EQ(Format(ATB_FMT("req={} took={}us"), 42, 1.25),
+            "req=42 took=1.25us");
+  EXPECT_EQ(Format(ATB_FMT("{}{}{}"), "a", 'b', std::string{"c"}), "abc");
+  EXPECT_EQ(Format(ATB_FMT("{{{}}} {{}} }}{{"), "x"sv), "{x} {} }{");
+  EXPECT_EQ(Format(ATB_FMT("ok={}, "), true), "ok=true, ");
+}
+
+TEST(AtbFormatTest, FormatSizeToAndAppend) {
+  const auto fmt = ATB_FMT("[{}] {}");
+  EXPECT_EQ(FormatSize(fmt, 404, "not found"), 15u);
+
+  char buffer[16] = {};
+  const auto end = FormatTo(fmt, buffer, sizeof(buffer), 404, "not found");
+  ASSERT_TRUE(end.has_value());
+  EXPECT_EQ(std::string_view(buffer, static_cast<std::size_t>(*end - buffer)),
+            "[404] not found"sv);
+
+  // Too small: nothing written
+  char small[8] = {};
+  EXPECT_FALSE(FormatTo(fmt, small, sizeof(small), 404, "not found"));
+  EXPECT_EQ(small[0], '\0');
+
+  std::string str = "log: ";
+  EXPECT_EQ(FormatAppend(fmt, str, 200, "ok"), 8u);
+  EXPECT_EQ(str, "log: [200] ok");
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/hash.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbHashTest, Hash64) {
+  // All the sizes ranges (<4, <=16, <=48, >48) depend on all their bytes
+  std::string str;
+  std::unordered_set<std::uint64_t> hashes;
+  for (std::size_t size = 0; size < 200; ++size) {
+    EXPECT_TRUE(hashes.insert(Hash64(str)).second) << "size: " << size;
+    EXPECT_EQ(Hash64(str), Hash64(str.data(), str.size()));
+
+    for (std::size_t i = 0; i < size; ++i) {
+      std::string modified = str;
+      modified[i] = static_cast<char>(modified[i] ^ 0x01);
+      EXPECT_NE(Hash64(modified), Hash64(str))
+          << "size: " << size << " byte: " << i;
+    }
+
+    str.push_back(static_cast<char>('a' + (size % 26)));
+  }
+
+  EXPECT_NE(Hash64("foo"sv, 0), Hash64("foo"sv, 1));
+  EXPECT_EQ(Hash64("foo"sv, 42), Hash64("foo"sv, 42));
+}
+
+TEST(AtbHashTest, HashMixAndCombine) {
+  static_assert(HashMix(1) != HashMix(2));
+  static_assert(HashCombine(1, 2) != HashCombine(2, 1));
+
+  std::unordered_set<std::uint64_t> hashes;
+  for (std::uint64_t i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(hashes.insert(HashMix(i)).second);
+  }
+
+  // Low bits are well distributed, even for values sharing them
+  std::unordered_set<std::uint64_t> low_bits;
+  for (std::uint64_t i = 0; i < 128; ++i) {
+    low_bits.insert(HashMix(i << 32) & 0x7F);
+  }
+  EXPECT_GT(low_bits.size(), 64u);
+}
+
+enum class Color { kRed, kGreen };
+
+TEST(AtbHashTest, Hasher) {
+  constexpr Hasher hasher;
+
+  // All strings hash the same way (heterogeneous lookups)
+  const std::string foo = "foo";
+  EXPECT_EQ(hasher(foo), hasher("foo"sv));
+  EXPECT_EQ(hasher(foo), hasher("foo"));
+  EXPECT_NE(hasher(foo), hasher("bar"));
+
+  // Integers hash their value, whatever their types
+  EXPECT_EQ(hasher(42), hasher(42u));
+  EXPECT_EQ(hasher(std::int8_t{-1}), hasher(std::int64_t{-1}));
+  EXPECT_EQ(hasher(-1), hasher(std::int16_t{-1}));
+  EXPECT_EQ(hasher(std::uint8_t{0xFF}), hasher(std::uint64_t{0xFF}));
+  EXPECT_NE(hasher(std::int8_t{-1}), hasher(std::uint8_t{0xFF}));
+  EXPECT_NE(hasher(1), hasher(2));
+  static_assert(hasher(3) == hasher(3L));
+  EXPECT_EQ(hasher(Color::kGreen), hasher(1));
+
+  // Tuples/pairs combine their elements, in order
+  EXPECT_EQ(hasher(std::make_tuple(1, "a"sv)), hasher(std::make_pair(1, "a")));
+  EXPECT_NE(hasher(std::make_tuple(1, 2)), hasher(std::make_tuple(2, 1)));
+  EXPECT_NE(hasher(std::make_tuple(1)), hasher(std::make_tuple(1, 0)));
+  EXPECT_NE(hasher(std::make_tuple()), hasher(std::make_tuple(0)));
+  EXPECT_EQ(hasher(std::make_tuple(std::make_pair(1, 2), foo)),
+            hasher(std::make_tuple(std::make_tuple(1, 2), "foo"sv)));
+
+  std::unordered_set<std::pair<int, int>, Hasher> pairs;
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 100; ++j) pairs.emplace(i, j);
+  }
+  EXPECT_EQ(pairs.size(), 10000u);
+  EXPECT_EQ(pairs.count({42, 24}), 1u);
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,134 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/key_value.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+using Pairs = std::vector<std::pair<std::string_view, std::string_view>>;
+
+auto Tokenize(std::string_view text,
+              const StrKeyValueFormat& format = kStrAttributesFormat)
+    -> Pairs {
+  Pairs pairs;
+  for (const auto& kv : StrKeyValues{text, format}) {
+    pairs.emplace_back(kv.key, kv.value);
+  }
+  return pairs;
+}
+
+TEST(AtbStrKeyValuesTest, Attributes) {
+  EXPECT_EQ(Tokenize(""), Pairs{});
+  EXPECT_EQ(Tokenize(" ; ;;"), Pairs{});
+  EXPECT_EQ(Tokenize("k1=v1"), (Pairs{{"k1", "v1"}}));
+  EXPECT_EQ(Tokenize("k1=v1;k2=v2;"), (Pairs{{"k1", "v1"}, {"k2", "v2"}}));
+  EXPECT_EQ(Tokenize("  k1 = v 1 ;\tk2=  v2\r\n"),
+            (Pairs{{"k1", "v 1"}, {"k2", "v2"}}));
+
+  // Missing values/keys
+  EXPECT_EQ(Tokenize("flag;k=;=v;k2=a=b"),
+            (Pairs{{"flag", ""}, {"k", ""}, {"", "v"}, {"k2", "a=b"}}));
+}
+
+TEST(AtbStrKeyValuesTest, Quotes) {
+  EXPECT_EQ(Tokenize(R"(k1="v 1";k2=" a;b=c ")"),
+            (Pairs{{"k1", "v 1"}, {"k2", " a;b=c "}}));
+  EXPECT_EQ(Tokenize(R"(k="";k2 = "x" garbage ;k3=y)"),
+            (Pairs{{"k", ""}, {"k2", "x"}, {"k3", "y"}}));
+
+  // Unterminated
+  EXPECT_EQ(Tokenize(R"(k="a;b)"), (Pairs{{"k", "a;b"}}));
+  EXPECT_EQ(Tokenize(R"(k="a\)"), (Pairs{{"k", R"(a\)"}}));
+
+  // Quotes inside values are kept
+  EXPECT_EQ(Tokenize(R"(k=a"b;c)"), (Pairs{{"k", R"(a"b)"}, {"c", ""}}));
+
+  // Escapes
+  const StrKeyValues kvs{R"(a="x\"y\\";b="plain";c=raw\n)"};
+  std::vector<StrKeyValue> pairs{kvs.begin(), kvs.end()};
+  ASSERT_EQ(pairs.size(), 3u);
+
+  EXPECT_EQ(pairs[0].value, R"(x\"y\\)"sv);
+  EXPECT_TRUE(pairs[0].escaped);
+  EXPECT_EQ(pairs[0].Unescaped(), R"(x"y\)");
+
+  EXPECT_EQ(pairs[1].value, "plain"sv);
+  EXPECT_FALSE(pairs[1].escaped);
+  EXPECT_EQ(pairs[1].Unescaped(), "plain");
+
+  // Only quoted values are unescaped
+  EXPECT_EQ(pairs[2].value, R"(raw\n)"sv);
+  EXPECT_FALSE(pairs[2].escaped);
+}
+
+TEST(AtbStrKeyValuesTest, Headers) {
+  constexpr auto kRequest =
+      "GET / HTTP/1.1\r\n"
+      "Host: example.com:8080\r\n"
+      "Content-Length:  42 \r\n"
+      "ETag: \"abc\"\r\n"
+      "\r\n"sv;
+
+  EXPECT_EQ(Tokenize(kRequest, kStrHeadersFormat),
+            (Pairs{{"GET / HTTP/1.1", ""},
+                   {"Host", "example.com:8080"},
+                   {"Content-Length", "42"},
+                   {"ETag", "\"abc\""}}));
+
+  const StrKeyValues headers{kRequest, kStrHeadersFormat};
+  const auto host = headers.Find("host");
+  ASSERT_TRUE(host.has_value());
+  EXPECT_EQ(host->key, "Host"sv);
+  EXPECT_EQ(host->value, "example.com:8080"sv);
+  EXPECT_FALSE(headers.Find("Accept").has_value());
+
+  const auto [length, accept, etag] =
+      headers.Extract({"CONTENT-LENGTH", "accept", "etag"});
+  ASSERT_TRUE(length.has_value());
+  EXPECT_EQ(length->value, "42"sv);
+  EXPECT_FALSE(accept.has_value());
+  ASSERT_TRUE(etag.has_value());
+  EXPECT_EQ(etag->value, "\"abc\""sv);
+}
+
+TEST(AtbStrKeyValuesTest, Extract) {
+  // Case sensitive by default, the first pair wins
+  const StrKeyValues kvs{"a=1;A=2;b=3;a=4"};
+  const auto [a, upper_a, b, c] = kvs.Extract({"a", "A", "b", "c"});
+  ASSERT_TRUE(a && upper_a && b);
+  EXPECT_EQ(a->value, "1"sv);
+  EXPECT_EQ(upper_a->value, "2"sv);
+  EXPECT_EQ(b->value, "3"sv);
+  EXPECT_FALSE(c.has_value());
+
+  EXPECT_EQ(kvs.Find("a")->value, "1"sv);
+}
+
+TEST(AtbStrKeyValuesTest, LongText) {
+  // Longer than the vectorized blocks
+  std::string text;
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = "key_" + std::to_string(i);
+    const std::string value(static_cast<std::size_t>(i % 40), 'v');
+    text += key + "=\"" + value + ";=\\\"\";";
+    expected[key] = value + ";=\"";
+  }
+
+  std::map<std::string, std::string> tokenized;
+  for (const auto& kv : StrKeyValues{text}) {
+    EXPECT_TRUE(kv.escaped);
+    tokenized.emplace(kv.key, kv.Unescaped());
+  }
+  EXPECT_EQ(tokenized, expected);
+}
+
+}  // namespace
+}  // namespace atb
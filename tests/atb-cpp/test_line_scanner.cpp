@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "atb-cpp/line_scanner.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// @return All lines of \a text, using std::getline
+auto GetLines(const std::string& text) -> std::vector<std::string> {
+  std::vector<std::string> lines;
+  std::istringstream stream(text);
+  for (std::string line; std::getline(stream, line);) lines.push_back(line);
+  return lines;
+}
+
+/// @return All lines of \a text, using StrForEachLine
+auto ForEachLines(std::string_view text) -> std::vector<std::string> {
+  std::vector<std::string> lines;
+  StrForEachLine(text, [&](std::string_view line) {
+    lines.push_back(std::string{line});
+  });
+  return lines;
+}
+
+/// Random text, made of lines of random sizes
+auto RandomText(std::mt19937& gen, std::size_t lines_count) -> std::string {
+  std::uniform_int_distribution<std::size_t> size(0, 80);
+  std::uniform_int_distribution<int> letter('a', 'e');
+
+  std::string text;
+  for (std::size_t i = 0; i < lines_count; ++i) {
+    for (std::size_t n = size(gen); n > 0; --n) {
+      text += static_cast<char>(letter(gen));
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+TEST(AtbLineScannerTest, ForEachLine) {
+  EXPECT_TRUE(ForEachLines("").empty());
+  EXPECT_EQ(ForEachLines("foo"), std::vector<std::string>{"foo"});
+  EXPECT_EQ(ForEachLines("foo\n"), std::vector<std::string>{"foo"});
+  EXPECT_EQ(ForEachLines("\n"), std::vector<std::string>{""});
+  EXPECT_EQ(ForEachLines("foo\n\nbar"),
+            (std::vector<std::string>{"foo", "", "bar"}));
+
+  std::mt19937 gen(42);
+  for (std::size_t count = 0; count < 100; ++count) {
+    auto text = RandomText(gen, count);
+    EXPECT_EQ(ForEachLines(text), GetLines(text));
+
+    // Without trailing '\n'
+    text += "last";
+    EXPECT_EQ(ForEachLines(text), GetLines(text));
+  }
+}
+
+TEST(AtbLineScannerTest, ForEachLineIsZeroCopy) {
+  const std::string text = "foo\nbar\nbaz";
+  StrForEachLine(text, [&](std::string_view line) {
+    EXPECT_GE(line.data(), text.data());
+    EXPECT_LE(line.data() + line.size(), text.data() + text.size());
+  });
+}
+
+TEST(AtbLineScannerTest, ForEachMatchingLine) {
+  const std::string text = "an error\nok\nanother ERROR\nfatal error\n";
+
+  std::vector<std::string_view> lines;
+  EXPECT_EQ(StrForEachMatchingLine(
+                text, StrContains("error"),
+                [&](std::string_view line) { lines.push_back(line); }),
+            2);
+  EXPECT_EQ(lines, (std::vector<std::string_view>{"an error", "fatal error"}));
+
+  // Any matcher
+  lines.clear();
+  EXPECT_EQ(StrForEachMatchingLine(
+                text, [](std::string_view line) { return line.size() == 2; },
+                [&](std::string_view line) { lines.push_back(line); }),
+            1);
+  EXPECT_EQ(lines, (std::vector<std::string_view>{"ok"}));
+}
+
+TEST(AtbLineScannerTest, LinesChunks) {
+  EXPECT_TRUE(StrLinesChunks("", 4).empty());
+  EXPECT_EQ(StrLinesChunks("foo", 4), (std::vector<std::string_view>{"foo"}));
+
+  std::mt19937 gen(42);
+  const auto text = RandomText(gen, 1000);
+  for (std::size_t count : {0u, 1u, 2u, 3u, 7u, 16u, 5000u}) {
+    const auto chunks = StrLinesChunks(text, count);
+    EXPECT_LE(chunks.size(), std::max<std::size_t>(count, 1));
+
+    // Contiguous, newline aligned and covering the whole text
+    std::size_t size = 0;
+    for (auto chunk : chunks) {
+      EXPECT_EQ(chunk.data(), text.data() + size);
+      EXPECT_EQ(chunk.back(), '\n');
+      size += chunk.size();
+    }
+    EXPECT_EQ(size, text.size());
+  }
+}
+
+TEST(AtbLineScannerTest, ForEachMatchingLineParallel) {
+  std::mt19937 gen(42);
+  const auto text = RandomText(gen, 10000);
+  const auto matcher = StrContains("abc");
+
+  std::vector<std::string_view> expected;
+  const auto expected_count = StrForEachMatchingLine(
+      text, matcher, [&](std::string_view line) { expected.push_back(line); });
+  ASSERT_GT(expected_count, 0);
+
+  for (std::size_t threads : {1u, 2u, 4u, 9u}) {
+    std::vector<std::string_view> lines;
+    EXPECT_EQ(StrForEachMatchingLineParallel(
+                  text, matcher,
+                  [&](std::string_view line) { lines.push_back(line); },
+                  threads, LinesOrder::kOrdered),
+              expected_count);
+    EXPECT_EQ(lines, expected) << threads;
+
+    lines.clear();
+    EXPECT_EQ(StrForEachMatchingLineParallel(
+                  text, matcher,
+                  [&](std::string_view line) { lines.push_back(line); },
+                  threads, LinesOrder::kUnordered),
+              expected_count);
+    std::sort(lines.begin(), lines.end(),
+              [](auto lhs, auto rhs) { return lhs.data() < rhs.data(); });
+    EXPECT_EQ(lines, expected) << threads;
+  }
+}
+
+TEST(AtbLineScannerTest, ForEachMatchingLineParallelRethrows) {
+  std::mt19937 gen(42);
+  const auto text = RandomText(gen, 1000);
+
+  EXPECT_THROW(StrForEachMatchingLineParallel(
+                   text,
+                   [](std::string_view line) -> bool {
+                     if (line.size() == 80) throw std::runtime_error("80");
+                     return false;
+                   },
+                   [](std::string_view) {}, 4),
+               std::runtime_error);
+}
+
+TEST(AtbLineScannerTest, MappedFile) {
+  const std::string path = ::testing::TempDir() + "atb_line_scanner.txt";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "foo\nbar error\nbaz\n";
+  }
+
+  MappedFile file(path);
+  EXPECT_EQ(file.View(), "foo\nbar error\nbaz\n");
+  EXPECT_EQ(file.Size(), 18);
+  EXPECT_FALSE(file.Empty());
+
+  std::vector<std::string_view> lines;
+  EXPECT_EQ(StrForEachMatchingLine(
+                file.View(), StrContains("error"),
+                [&](std::string_view line) { lines.push_back(line); }),
+            1);
+  EXPECT_EQ(lines, std::vector<std::string_view>{"bar error"});
+
+  // Moved
+  MappedFile other = std::move(file);
+  EXPECT_EQ(other.View(), "foo\nbar error\nbaz\n");
+  EXPECT_EQ(other.Size(), 18);
+  EXPECT_TRUE(file.Empty());
+#if ATB_LINE_SCANNER_MMAP
+  // Views remain valid
+  EXPECT_EQ(lines, std::vector<std::string_view>{"bar error"});
+#endif
+
+  // Small files too (without mmap(), their content is stored inline)
+  {
+    std::ofstream small(path, std::ios::binary | std::ios::trunc);
+    small << "ab\n";
+  }
+  MappedFile small(path);
+  MappedFile moved = std::move(small);
+  EXPECT_EQ(moved.View(), "ab\n");
+  other = std::move(moved);
+  EXPECT_EQ(other.View(), "ab\n");
+  EXPECT_TRUE(moved.Empty());
+
+  {
+    std::ofstream empty(path, std::ios::binary | std::ios::trunc);
+  }
+  EXPECT_TRUE(MappedFile(path).Empty());
+  std::remove(path.c_str());
+
+  EXPECT_THROW(MappedFile("/this/file/does/not/exist"), std::system_error);
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,236 @@
+#if __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "atb-cpp/logger.hpp"
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+namespace atb {
+namespace {
+
+/// Fixture logging into a pipe, read by a background thread
+class AtbLoggerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ASSERT_EQ(::pipe(m_pipe), 0); }
+
+  void TearDown() override {
+    if (m_pipe[1] >= 0) ::close(m_pipe[1]);
+    if (m_reader.joinable()) m_reader.join();
+    ::close(m_pipe[0]);
+  }
+
+  auto WriteFd() const -> int { return m_pipe[1]; }
+
+  /// Start reading the pipe, until EOF (see Content())
+  void StartReading() {
+    m_reader = std::thread([this] {
+      char buffer[4096];
+      for (;;) {
+        const ssize_t size = ::read(m_pipe[0], buffer, sizeof(buffer));
+        if (size <= 0) break;
+        m_content.append(buffer, static_cast<std::size_t>(size));
+      }
+    });
+  }
+
+  /// @return Everything written into the pipe (closed)
+  auto Content() -> std::string {
+    if (!m_reader.joinable()) StartReading();
+    ::close(m_pipe[1]);
+    m_pipe[1] = -1;
+    m_reader.join();
+    return m_content;
+  }
+
+  static auto Lines(std::string_view content) -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    for (std::size_t end = content.find('\n'); end != std::string_view::npos;
+         end = content.find('\n')) {
+      lines.emplace_back(content.substr(0, end));
+      content.remove_prefix(end + 1);
+    }
+    return lines;
+  }
+
+  int m_pipe[2] = {-1, -1};
+  std::thread m_reader;
+  std::string m_content;
+};
+
+TEST_F(AtbLoggerTest, LogAndWrite) {
+  {
+    AsyncLogger logger{WriteFd()};
+    EXPECT_EQ(logger.Capacity(), 4096u);
+    EXPECT_TRUE(logger.Log(ATB_FMT("req={} took={}us"), 42, 1.5));
+    EXPECT_TRUE(logger.Write({"event=", "start", "\n"}));
+    EXPECT_TRUE(logger.Log(ATB_FMT("no args")));
+  }
+
+  EXPECT_EQ(Content(), "req=42 took=1.5us\nevent=start\nno args\n");
+}
+
+TEST_F(AtbLoggerTest, Flush) {
+  StartReading();
+
+  AsyncLogger logger{WriteFd()};
+  for (int i = 0; i < 100; ++i) logger.Log(ATB_FMT("{}"), i);
+  logger.Flush();
+  EXPECT_EQ(logger.DroppedCount(), 0u);
+  EXPECT_EQ(logger.ErrorsCount(), 0u);
+}
+
+TEST_F(AtbLoggerTest, Truncates) {
+  LogOptions options;
+  options.record_size = 8;
+  {
+    AsyncLogger logger{WriteFd(), options};
+    logger.Log(ATB_FMT("{}"), "0123456789");
+    logger.Log(ATB_FMT("0123456"));
+    logger.Write({"abcd", "efghij"});
+  }
+
+  EXPECT_EQ(Content(), "0123456\n0123456\nabcdefgh");
+}
+
+TEST_F(AtbLoggerTest, ManyProducersKeepTheirOrder) {
+  constexpr int kThreads = 4;
+  constexpr int kRecords = 5000;
+
+  LogOptions options;
+  options.capacity = 64;
+  options.overflow = LogOverflow::kBlock;
+  StartReading();
+  {
+    AsyncLogger logger{WriteFd(), options};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+      producers.emplace_back([&logger, t] {
+        for (int i = 0; i < kRecords; ++i) {
+          logger.Log(ATB_FMT("{} {}"), t, i);
+        }
+      });
+    }
+    for (auto& producer : producers) producer.join();
+    EXPECT_EQ(logger.DroppedCount(), 0u);
+  }
+
+  const auto lines = Lines(Content());
+  ASSERT_EQ(lines.size(), std::size_t{kThreads * kRecords});
+
+  std::vector<int> next(kThreads, 0);
+  for (const auto& line : lines) {
+    const auto space = line.find(' ');
+    ASSERT_NE(space, std::string::npos);
+    const int t = std::stoi(line.substr(0, space));
+    ASSERT_GE(t, 0);
+    ASSERT_LT(t, kThreads);
+    EXPECT_EQ(std::stoi(line.substr(space + 1)),
+              next[static_cast<std::size_t>(t)]++);
+  }
+}
+
+/// Options of a logger filling a pipe (not read) after a few records
+auto SlowOptions(LogOverflow overflow) -> LogOptions {
+  LogOptions options;
+  options.capacity = 8;
+  options.record_size = 4096;
+  options.overflow = overflow;
+  options.sample_rate = 2;
+  return options;
+}
+
+TEST_F(AtbLoggerTest, DropWhenFull) {
+  constexpr std::size_t kRecords = 200;
+  const std::string payload(1000, 'x');
+
+  std::size_t queued = 0;
+  std::size_t dropped = 0;
+  {
+    AsyncLogger logger{WriteFd(), SlowOptions(LogOverflow::kDrop)};
+    for (std::size_t i = 0; i < kRecords; ++i) {
+      queued += logger.Log(ATB_FMT("{}"), payload) ? 1u : 0u;
+    }
+    dropped = logger.DroppedCount();
+    StartReading();
+  }
+
+  EXPECT_GT(dropped, 0u);
+  EXPECT_EQ(queued + dropped, kRecords);
+  EXPECT_EQ(Lines(Content()).size(), queued);
+}
+
+TEST_F(AtbLoggerTest, SampleWhenAlmostFull) {
+  constexpr std::size_t kRecords = 200;
+  const std::string payload(1000, 'x');
+
+  std::size_t queued = 0;
+  std::size_t dropped = 0;
+  {
+    AsyncLogger logger{WriteFd(), SlowOptions(LogOverflow::kSample)};
+    for (std::size_t i = 0; i < kRecords; ++i) {
+      queued += logger.Log(ATB_FMT("{}"), payload) ? 1u : 0u;
+    }
+    dropped = logger.DroppedCount();
+    StartReading();
+  }
+
+  EXPECT_GT(dropped, 0u);
+  EXPECT_EQ(queued + dropped, kRecords);
+  EXPECT_EQ(Lines(Content()).size(), queued);
+}
+
+TEST_F(AtbLoggerTest, BlockWhenFull) {
+  constexpr std::size_t kRecords = 200;
+  const std::string payload(1000, 'x');
+
+  StartReading();
+  {
+    AsyncLogger logger{WriteFd(), SlowOptions(LogOverflow::kBlock)};
+    for (std::size_t i = 0; i < kRecords; ++i) {
+      EXPECT_TRUE(logger.Log(ATB_FMT("{}"), payload));
+    }
+    EXPECT_EQ(logger.DroppedCount(), 0u);
+  }
+
+  EXPECT_EQ(Lines(Content()).size(), kRecords);
+}
+
+TEST_F(AtbLoggerTest, InvalidOptions) {
+  LogOptions options;
+  options.capacity = 100;
+  EXPECT_THROW(AsyncLogger(WriteFd(), options), std::invalid_argument);
+
+  options.capacity = 1;
+  EXPECT_THROW(AsyncLogger(WriteFd(), options), std::invalid_argument);
+
+  options = {};
+  options.record_size = 0;
+  EXPECT_THROW(AsyncLogger(WriteFd(), options), std::invalid_argument);
+
+  options = {};
+  options.sample_rate = 0;
+  EXPECT_THROW(AsyncLogger(WriteFd(), options), std::invalid_argument);
+}
+
+TEST_F(AtbLoggerTest, WriteErrors) {
+  // Nothing can be written into the read end of the pipe
+  {
+    AsyncLogger logger{m_pipe[0]};
+    logger.Write({"lost\n"});
+    logger.Flush();
+    EXPECT_EQ(logger.ErrorsCount(), 1u);
+  }
+  EXPECT_EQ(Content(), "");
+}
+
+}  // namespace
+}  // namespace atb
+
+#endif  // __has_include(<sys/uio.h>) && __has_include(<unistd.h>)
@@ -0,0 +1,119 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/number.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbNumberTest, Integers) {
+  EXPECT_EQ(StrToNumber<int>("0"), 0);
+  EXPECT_EQ(StrToNumber<int>("42"), 42);
+  EXPECT_EQ(StrToNumber<int>("-42"), -42);
+  EXPECT_EQ(StrToNumber<unsigned>("42"), 42u);
+
+  // Invalid
+  EXPECT_FALSE(StrToNumber<int>(""));
+  EXPECT_FALSE(StrToNumber<int>("-"));
+  EXPECT_FALSE(StrToNumber<int>("+42"));
+  EXPECT_FALSE(StrToNumber<int>(" 42"));
+  EXPECT_FALSE(StrToNumber<int>("42 "));
+  EXPECT_FALSE(StrToNumber<int>("4a2"));
+  EXPECT_FALSE(StrToNumber<unsigned>("-42"));
+
+  // Range
+  EXPECT_EQ(StrToNumber<std::uint8_t>("255"), 255);
+  EXPECT_FALSE(StrToNumber<std::uint8_t>("256"));
+  EXPECT_EQ(StrToNumber<std::int8_t>("-128"), -128);
+  EXPECT_FALSE(StrToNumber<std::int8_t>("-129"));
+  EXPECT_EQ(StrToNumber<std::int64_t>("-9223372036854775808"),
+            std::numeric_limits<std::int64_t>::min());
+  EXPECT_EQ(StrToNumber<std::uint64_t>("18446744073709551615"),
+            std::numeric_limits<std::uint64_t>::max());
+  EXPECT_FALSE(StrToNumber<std::uint64_t>("18446744073709551616"));
+}
+
+TEST(AtbNumberTest, IntegersFastPath) {
+  // 8 to 16 digits
+  EXPECT_EQ(StrToNumber<int>("12345678"), 12345678);
+  EXPECT_EQ(StrToNumber<int>("-12345678"), -12345678);
+  EXPECT_EQ(StrToNumber<int>("00000042"), 42);
+  EXPECT_EQ(StrToNumber<int>("2147483647"), 2147483647);
+  EXPECT_EQ(StrToNumber<int>("-2147483648"),
+            std::numeric_limits<int>::min());
+  EXPECT_FALSE(StrToNumber<int>("2147483648"));
+  EXPECT_FALSE(StrToNumber<int>("-2147483649"));
+  EXPECT_EQ(StrToNumber<std::int64_t>("1234567890123456"),
+            1234567890123456);
+  EXPECT_EQ(StrToNumber<std::uint64_t>("9999999999999999"),
+            9999999999999999u);
+
+  for (auto invalid : {"1234567a"sv, "a2345678"sv, "123456789012345/"sv,
+                       "12345:78"sv, "-1234567-"sv, "--1234567"sv,
+                       "1234567 "sv}) {
+    EXPECT_FALSE(StrToNumber<std::int64_t>(invalid)) << invalid;
+  }
+
+  // Same as std::from_chars for all sizes
+  std::mt19937_64 gen(42);
+  for (int i = 0; i < 2000; ++i) {
+    const auto value = static_cast<std::int64_t>(gen() >> (gen() % 64));
+    const auto str = std::to_string((i % 2) ? value : -value);
+    EXPECT_EQ(StrToNumber<std::int64_t>(str), (i % 2) ? value : -value)
+        << str;
+    EXPECT_EQ(StrToNumber<std::int32_t>(str).has_value(),
+              (str.size() < 10) || (std::stoll(str) ==
+                                    static_cast<std::int32_t>(std::stoll(str))))
+        << str;
+  }
+}
+
+TEST(AtbNumberTest, FloatingPoints) {
+  EXPECT_EQ(StrToNumber<double>("0"), 0.0);
+  EXPECT_EQ(StrToNumber<double>("-1.5"), -1.5);
+  EXPECT_EQ(StrToNumber<double>("1.5e3"), 1500.0);
+  EXPECT_EQ(StrToNumber<float>("0.25"), 0.25f);
+  EXPECT_EQ(StrToNumber<double>("12345678"), 12345678.0);
+
+  EXPECT_FALSE(StrToNumber<double>(""));
+  EXPECT_FALSE(StrToNumber<double>("1.5 "));
+  EXPECT_FALSE(StrToNumber<double>("1.5.3"));
+  EXPECT_FALSE(StrToNumber<double>("1e400"));
+}
+
+TEST(AtbNumberTest, Batch) {
+  const std::vector<std::string_view> column = {"1", "-22", "333",
+                                                "1234567890"};
+
+  std::array<std::int64_t, 4> values = {};
+  EXPECT_EQ(StrToNumbers(column, values.data()), values.data() + 4);
+  EXPECT_EQ(values, (std::array<std::int64_t, 4>{1, -22, 333, 1234567890}));
+
+  std::vector<double> doubles = {0.5};
+  EXPECT_EQ(StrToNumbers(column, doubles), 4);
+  EXPECT_EQ(doubles, (std::vector<double>{0.5, 1, -22, 333, 1234567890}));
+
+  // Invalid tokens
+  const std::vector<std::string> invalid = {"1", "2", "x", "4"};
+  std::size_t where = 0;
+  EXPECT_FALSE(StrToNumbers(invalid, values.data(), &where));
+  EXPECT_EQ(where, 2);
+  EXPECT_EQ(values[0], 1);
+  EXPECT_EQ(values[1], 2);
+
+  std::vector<int> ints = {42};
+  EXPECT_FALSE(StrToNumbers(invalid, ints, &where));
+  EXPECT_EQ(ints, std::vector<int>{42});
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,107 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/prefix_router.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbStrPrefixRouterTest, Empty) {
+  const StrPrefixRouter<int> router;
+  EXPECT_EQ(router.Size(), 0);
+  EXPECT_EQ(router.LongestMatch("foo"), nullptr);
+  EXPECT_EQ(router.LongestMatch(""), nullptr);
+  EXPECT_FALSE(::IsMatching(router, "foo"));
+}
+
+TEST(AtbStrPrefixRouterTest, LongestMatch) {
+  StrPrefixRouter<int> router;
+  router.Insert("/api", 1)
+      .Insert("/api/v2", 2)
+      .Insert("/static", 3)
+      .Insert("/api/v2/items", 4)
+      .Insert("/apx", 5);
+
+  EXPECT_EQ(router.Size(), 5);
+
+  std::size_t size = 0;
+  const auto Route = [&](std::string_view str) -> int {
+    size = std::string_view::npos;
+    const auto value = router.LongestMatch(str, &size);
+    return (value != nullptr) ? *value : -1;
+  };
+
+  EXPECT_EQ(Route("/api"), 1);
+  EXPECT_EQ(size, 4);
+  EXPECT_EQ(Route("/api/v1/items"), 1);
+  EXPECT_EQ(size, 4);
+  EXPECT_EQ(Route("/api/v2"), 2);
+  EXPECT_EQ(size, 7);
+  EXPECT_EQ(Route("/api/v2/item"), 2);
+  EXPECT_EQ(size, 7);
+  EXPECT_EQ(Route("/api/v2/items/42"), 4);
+  EXPECT_EQ(size, 13);
+  EXPECT_EQ(Route("/apx/foo"), 5);
+  EXPECT_EQ(size, 4);
+  EXPECT_EQ(Route("/static/index.html"), 3);
+  EXPECT_EQ(size, 7);
+
+  // d_size is untouched when nothing matches
+  EXPECT_EQ(Route("/ap"), -1);
+  EXPECT_EQ(size, std::string_view::npos);
+  EXPECT_EQ(Route("/home"), -1);
+  EXPECT_EQ(Route(""), -1);
+
+  EXPECT_TRUE(::IsMatching(router, "/api/v3"));
+  EXPECT_FALSE(::IsMatching(router, "api"));
+}
+
+TEST(AtbStrPrefixRouterTest, EmptyPrefixAndOverwrite) {
+  StrPrefixRouter<std::string> router;
+  router.Insert("", "root").Insert("ab", "ab").Insert("abcd", "abcd");
+
+  EXPECT_EQ(*router.LongestMatch(""), "root");
+  EXPECT_EQ(*router.LongestMatch("zzz"), "root");
+  EXPECT_EQ(*router.LongestMatch("abc"), "ab");
+
+  router.Insert("ab", "AB");
+  EXPECT_EQ(router.Size(), 3);
+  EXPECT_EQ(*router.LongestMatch("abc"), "AB");
+}
+
+TEST(AtbStrPrefixRouterTest, SameAsStrStartsWithChain) {
+  const std::vector<std::string> prefixes = {
+      "a", "abc", "abd", "abcdef", "b", "bar", "barfoo", "ba", "xyz", "xy",
+  };
+
+  StrPrefixRouter<std::size_t> router;
+  for (std::size_t i = 0; i < prefixes.size(); ++i) {
+    router.Insert(prefixes[i], i);
+  }
+
+  for (auto str : {"a"sv, "ab"sv, "abc"sv, "abcde"sv, "abcdefg"sv, "abdd"sv,
+                   "b"sv, "baz"sv, "barf"sv, "barfoo!"sv, "x"sv, "xyzt"sv,
+                   "c"sv, ""sv}) {
+    // Reference: the longest of all StrStartsWith matching
+    std::size_t expected = prefixes.size();
+    for (std::size_t i = 0; i < prefixes.size(); ++i) {
+      if (::IsMatching(StrStartsWith(prefixes[i]), str) &&
+          ((expected == prefixes.size()) ||
+           (prefixes[i].size() > prefixes[expected].size()))) {
+        expected = i;
+      }
+    }
+
+    const auto value = router.LongestMatch(str);
+    EXPECT_EQ((value != nullptr) ? *value : prefixes.size(), expected) << str;
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,171 @@
+#include <cstddef>
+#include <random>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/matchers.hpp"
+#include "atb-cpp/regex.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbRegexTest, Literals) {
+  EXPECT_TRUE(::IsMatching(StrRegex(""), ""));
+  EXPECT_FALSE(::IsMatching(StrRegex(""), "a"));
+  EXPECT_TRUE(::IsMatching(StrRegex("foo"), "foo"));
+  EXPECT_FALSE(::IsMatching(StrRegex("foo"), "fo"));
+  EXPECT_FALSE(::IsMatching(StrRegex("foo"), "fooo"));
+  EXPECT_TRUE(::IsMatching(StrRegex("a.c"), "a\nc"));
+  EXPECT_TRUE(::IsMatching(StrRegex("a\\.c"), "a.c"));
+  EXPECT_FALSE(::IsMatching(StrRegex("a\\.c"), "abc"));
+  EXPECT_TRUE(::IsMatching(StrRegex("\\(\\)\\[\\]\\*\\\\"), "()[]*\\"));
+}
+
+TEST(AtbRegexTest, Classes) {
+  const auto hex = StrRegex("[0-9a-fA-F]+");
+  EXPECT_TRUE(::IsMatching(hex, "deadBEEF42"));
+  EXPECT_FALSE(::IsMatching(hex, "dead-beef"));
+  EXPECT_FALSE(::IsMatching(hex, ""));
+
+  EXPECT_TRUE(::IsMatching(StrRegex("[^a-z]"), "A"));
+  EXPECT_FALSE(::IsMatching(StrRegex("[^a-z]"), "q"));
+  EXPECT_TRUE(::IsMatching(StrRegex("[]a]"), "]"));
+  EXPECT_TRUE(::IsMatching(StrRegex("[a-]"), "-"));
+  EXPECT_TRUE(::IsMatching(StrRegex("[\\d_]+"), "4_2"));
+  EXPECT_TRUE(::IsMatching(StrRegex("[\\]]"), "]"));
+
+  EXPECT_TRUE(::IsMatching(StrRegex("\\d\\D\\w\\W\\s\\S"), "1a_ \tx"));
+  EXPECT_FALSE(::IsMatching(StrRegex("\\d"), "a"));
+  EXPECT_FALSE(::IsMatching(StrRegex("\\s"), "a"));
+}
+
+TEST(AtbRegexTest, Repetitions) {
+  EXPECT_TRUE(::IsMatching(StrRegex("ab*c"), "ac"));
+  EXPECT_TRUE(::IsMatching(StrRegex("ab*c"), "abbbc"));
+  EXPECT_FALSE(::IsMatching(StrRegex("ab+c"), "ac"));
+  EXPECT_TRUE(::IsMatching(StrRegex("ab?c"), "abc"));
+  EXPECT_FALSE(::IsMatching(StrRegex("ab?c"), "abbc"));
+
+  const auto bounded = StrRegex("a{2,3}");
+  EXPECT_FALSE(::IsMatching(bounded, "a"));
+  EXPECT_TRUE(::IsMatching(bounded, "aa"));
+  EXPECT_TRUE(::IsMatching(bounded, "aaa"));
+  EXPECT_FALSE(::IsMatching(bounded, "aaaa"));
+  EXPECT_TRUE(::IsMatching(StrRegex("a{2}"), "aa"));
+  EXPECT_FALSE(::IsMatching(StrRegex("a{2}"), "aaa"));
+  EXPECT_TRUE(::IsMatching(StrRegex("a{2,}"), "aaaaa"));
+  EXPECT_FALSE(::IsMatching(StrRegex("a{2,}"), "a"));
+  EXPECT_TRUE(::IsMatching(StrRegex("(ab){0,2}"), ""));
+  EXPECT_TRUE(::IsMatching(StrRegex("(ab){0,2}"), "abab"));
+  EXPECT_TRUE(::IsMatching(StrRegex("a**"), "aaa"));
+}
+
+TEST(AtbRegexTest, Alternation) {
+  const auto version = StrRegex(R"(v\d+(\.\d+){0,2}(-rc\d+)?)");
+  EXPECT_TRUE(::IsMatching(version, "v1"));
+  EXPECT_TRUE(::IsMatching(version, "v1.22.3-rc1"));
+  EXPECT_FALSE(::IsMatching(version, "v1.22.3.4"));
+  EXPECT_FALSE(::IsMatching(version, "v1.-rc1"));
+
+  const auto verbs = StrRegex("(?:GET|POST|PUT|DELETE) /.*");
+  EXPECT_TRUE(::IsMatching(verbs, "GET /index.html"));
+  EXPECT_TRUE(::IsMatching(verbs, "DELETE /"));
+  EXPECT_FALSE(::IsMatching(verbs, "PATCH /"));
+
+  EXPECT_TRUE(::IsMatching(StrRegex("a|"), ""));
+  EXPECT_TRUE(::IsMatching(StrRegex("()"), ""));
+}
+
+TEST(AtbRegexTest, Search) {
+  const auto error = StrContainsRegex("error|fail(ed|ure)");
+  EXPECT_TRUE(::IsMatching(error, "request failed: timeout"));
+  EXPECT_TRUE(::IsMatching(error, "error"));
+  EXPECT_TRUE(::IsMatching(error, "disk failure"));
+  EXPECT_FALSE(::IsMatching(error, "request fail: timeout"));
+  EXPECT_FALSE(::IsMatching(error, ""));
+
+  EXPECT_TRUE(::IsMatching(StrContainsRegex(""), ""));
+  EXPECT_TRUE(::IsMatching(StrContainsRegex("a*"), "bbb"));
+  EXPECT_TRUE(::IsMatching(StrContainsRegex("\\d{3}"), "id=12 or 345"));
+  EXPECT_FALSE(::IsMatching(StrContainsRegex("\\d{3}"), "id=12 or 34"));
+}
+
+TEST(AtbRegexTest, Invalid) {
+  for (auto invalid : {
+           "("sv, ")"sv, "a)"sv, "(a"sv, "*"sv, "a|*"sv, "[a"sv, "[z-a]"sv,
+           "a{"sv, "a{2"sv, "a{,2}"sv, "a{3,2}"sv, "a{1001}"sv, "\\"sv,
+           "\\q"sv, "^a"sv, "a$"sv,
+       }) {
+    EXPECT_THROW(Regex{invalid}, std::invalid_argument) << invalid;
+  }
+
+  // DFA blow up
+  EXPECT_THROW(StrContainsRegex("a[ab]{20}"), std::length_error);
+}
+
+TEST(AtbRegexTest, Compilation) {
+  // All letters but 'a'..'c' are in the same class
+  const Regex regex("[a-z]+(abc)?");
+  EXPECT_EQ(regex.ClassesCount(), 5);
+  EXPECT_EQ(regex.GetMode(), Regex::Mode::kFullMatch);
+
+  // Minimized: equivalent patterns have the same number of states
+  EXPECT_EQ(Regex("(a|b)*abb").StatesCount(),
+            Regex("[ab]*a(b)(b)").StatesCount());
+  EXPECT_EQ(Regex("(a|aa)*").StatesCount(), Regex("a*").StatesCount());
+}
+
+TEST(AtbRegexTest, SameAsStdRegex) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> size(0, 8);
+  std::uniform_int_distribution<int> pick(0, 11);
+
+  constexpr std::string_view kAtoms[] = {
+      "a", "b", ".", "[ab]", "(a|b)", "(ab|ba)", "a*", "b+", "(a|bb)?",
+      "a{1,2}", "[^a]", "(a*b)*",
+  };
+
+  for (int i = 0; i < 300; ++i) {
+    std::string pattern;
+    for (auto n = size(gen); n > 0; --n) pattern += kAtoms[pick(gen)];
+    const Regex full(pattern);
+    const Regex search(pattern, Regex::Mode::kSearch);
+    const std::regex reference(pattern);
+
+    for (int j = 0; j < 20; ++j) {
+      std::string str;
+      for (auto n = size(gen); n > 0; --n) str += "abc"[pick(gen) % 3];
+
+      EXPECT_EQ(::IsMatching(full, str), std::regex_match(str, reference))
+          << pattern << " ~ " << str;
+      EXPECT_EQ(::IsMatching(search, str), std::regex_search(str, reference))
+          << pattern << " ~ " << str;
+    }
+  }
+}
+
+TEST(AtbRegexTest, Composition) {
+  EXPECT_EQ(2, StrSwitch<int>("v1.2")
+                   .Case(StrRegex("\\d+"), 1)
+                   .Case(StrRegex("v\\d+\\.\\d+"), 2)
+                   .Default(-1));
+
+  const auto id = AnyOf(StrRegex("[a-f0-9]{8}"), StrRegex("\\d+"));
+  EXPECT_TRUE(::IsMatching(id, "deadbeef"));
+  EXPECT_TRUE(::IsMatching(id, "1234567890"));
+  EXPECT_FALSE(::IsMatching(id, "deadbeefd"));
+
+  AnyMatcher<std::string_view> any_matcher;
+  any_matcher = StrContainsRegex("[Ee]rror");
+  EXPECT_TRUE(::IsMatching(any_matcher, "An Error occured"));
+  EXPECT_FALSE(::IsMatching(any_matcher, "All good"));
+}
+
+}  // namespace
+}  // namespace atb
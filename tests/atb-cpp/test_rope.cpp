@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "atb-cpp/rope.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbStrRopeTest, Empty) {
+  const StrRope rope;
+  EXPECT_TRUE(rope.Empty());
+  EXPECT_EQ(rope.Size(), 0);
+  EXPECT_EQ(rope.ChunksCount(), 0);
+  EXPECT_EQ(rope.Flatten(), "");
+}
+
+TEST(AtbStrRopeTest, Append) {
+  StrRope rope(8);
+  rope.Append("Coucou").Append({" ", "", "Chocolatine", " "}).Append("foo");
+
+  EXPECT_EQ(rope.Size(), 22);
+  EXPECT_EQ(rope.ChunksCount(), 3);
+  EXPECT_EQ(rope.Chunk(0), "Coucou C"sv);
+  EXPECT_EQ(rope.Chunk(1), "hocolati"sv);
+  EXPECT_EQ(rope.Chunk(2), "ne foo"sv);
+  EXPECT_EQ(rope.Flatten(), "Coucou Chocolatine foo");
+
+  std::string str = "> ";
+  EXPECT_EQ(rope.FlattenInto(str).value(), 22);
+  EXPECT_EQ(str, "> Coucou Chocolatine foo");
+
+  std::string chunks;
+  rope.ForEachChunk([&](std::string_view chunk) {
+    chunks.append(chunk).append("|");
+  });
+  EXPECT_EQ(chunks, "Coucou C|hocolati|ne foo|");
+}
+
+TEST(AtbStrRopeTest, BytesNeverMove) {
+  StrRope rope(16);
+  rope.Append("first chunk !!!!");
+  const std::string_view first = rope.Chunk(0);
+
+  const std::string big(1000, 'x');
+  for (int i = 0; i < 10; ++i) rope.Append(big);
+
+  EXPECT_EQ(rope.Chunk(0).data(), first.data());
+  EXPECT_EQ(first, "first chunk !!!!"sv);
+  EXPECT_EQ(rope.Size(), 16 + 10 * big.size());
+  EXPECT_EQ(rope.Flatten(), "first chunk !!!!" + std::string(10000, 'x'));
+
+  // Moving the rope doesn't move the bytes either
+  StrRope other = std::move(rope);
+  EXPECT_EQ(other.Chunk(0).data(), first.data());
+  EXPECT_TRUE(rope.Empty());
+}
+
+TEST(AtbStrRopeTest, Pool) {
+  StrBlockPool pool(4);
+  EXPECT_EQ(pool.BlockSize(), 4);
+  EXPECT_EQ(pool.FreeCount(), 0);
+
+  {
+    StrRope rope(pool);
+    rope.Append("0123456789");
+    EXPECT_EQ(rope.ChunksCount(), 3);
+    EXPECT_EQ(rope.Flatten(), "0123456789");
+
+    rope.Clear();
+    EXPECT_TRUE(rope.Empty());
+    EXPECT_EQ(pool.FreeCount(), 3);
+
+    // Blocks are recycled
+    rope.Append("abcdef");
+    EXPECT_EQ(pool.FreeCount(), 1);
+    EXPECT_EQ(rope.Flatten(), "abcdef");
+  }
+
+  // Blocks given back on destruction
+  EXPECT_EQ(pool.FreeCount(), 3);
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,139 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/searcher.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// Random string using a small alphabet (lots of partial matches)
+auto RandomString(std::mt19937& gen, std::size_t size) -> std::string {
+  std::uniform_int_distribution<int> dist('a', 'c');
+  std::string str(size, '\0');
+  for (auto& c : str) c = static_cast<char>(dist(gen));
+  return str;
+}
+
+TEST(AtbStrSearcherTest, Constexpr) {
+  constexpr StrSearcher searcher("foo"sv);
+  static_assert(searcher.Pattern() == "foo"sv);
+  static_assert(searcher.FindScalar("a foo b foo"sv) == 2);
+  static_assert(searcher.FindScalar("a foo b foo"sv, 3) == 8);
+  static_assert(searcher.FindScalar("a fo"sv) == StrSearcher::npos);
+  static_assert(searcher.RFindScalar("a foo b foo"sv) == 8);
+  static_assert(searcher.RFindScalar("a foo b foo"sv, 7) == 2);
+  static_assert(searcher.RFindScalar("a fo"sv) == StrSearcher::npos);
+}
+
+TEST(AtbStrSearcherTest, Find) {
+  const StrSearcher empty;
+  EXPECT_EQ(empty.Find(""), 0);
+  EXPECT_EQ(empty.Find("foo"), 0);
+  EXPECT_EQ(empty.Find("foo", 2), 2);
+  EXPECT_EQ(empty.Find("foo", 4), StrSearcher::npos);
+
+  const StrSearcher searcher("foo");
+  EXPECT_EQ(searcher.Find(""), StrSearcher::npos);
+  EXPECT_EQ(searcher.Find("fo"), StrSearcher::npos);
+  EXPECT_EQ(searcher.Find("foo"), 0);
+  EXPECT_EQ(searcher.Find("a foo b foo"), 2);
+  EXPECT_EQ(searcher.Find("a foo b foo", 3), 8);
+  EXPECT_EQ(searcher.Find("a foo b foo", 9), StrSearcher::npos);
+  EXPECT_EQ(searcher.Find("a foo b foo", 42), StrSearcher::npos);
+
+  const std::string str = std::string(100, 'f') + "foo";
+  EXPECT_EQ(searcher.Find(str), 100);
+}
+
+TEST(AtbStrSearcherTest, RFind) {
+  const StrSearcher empty;
+  EXPECT_EQ(empty.RFind(""), 0);
+  EXPECT_EQ(empty.RFind("foo"), 3);
+  EXPECT_EQ(empty.RFind("foo", 1), 1);
+
+  const StrSearcher searcher("foo");
+  EXPECT_EQ(searcher.RFind(""), StrSearcher::npos);
+  EXPECT_EQ(searcher.RFind("fo"), StrSearcher::npos);
+  EXPECT_EQ(searcher.RFind("foo"), 0);
+  EXPECT_EQ(searcher.RFind("a foo b foo"), 8);
+  EXPECT_EQ(searcher.RFind("a foo b foo", 7), 2);
+  EXPECT_EQ(searcher.RFind("a foo b foo", 1), StrSearcher::npos);
+
+  const std::string str = "foo" + std::string(100, 'o');
+  EXPECT_EQ(searcher.RFind(str), 0);
+}
+
+TEST(AtbStrSearcherTest, SameAsStdFind) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> pattern_size(0, 80);
+  std::uniform_int_distribution<std::size_t> str_size(0, 400);
+
+  for (int i = 0; i < 500; ++i) {
+    const auto str = RandomString(gen, str_size(gen));
+
+    // Use part of the string as pattern half of the time (always found)
+    std::string pattern = RandomString(gen, pattern_size(gen) % 8);
+    if (((i % 2) == 0) && !str.empty()) {
+      std::uniform_int_distribution<std::size_t> from_dist(0, str.size() - 1);
+      const auto from = from_dist(gen);
+      pattern = str.substr(from, pattern_size(gen));
+    }
+
+    const std::string_view sv = str;
+    const StrSearcher searcher(pattern);
+
+    for (std::size_t pos : {std::size_t{0}, std::size_t{7}, sv.size() / 2,
+                            StrSearcher::npos}) {
+      if (pos != StrSearcher::npos) {
+        EXPECT_EQ(searcher.Find(sv, pos), sv.find(pattern, pos))
+            << pattern << " / " << sv;
+        EXPECT_EQ(searcher.FindScalar(sv, pos), sv.find(pattern, pos))
+            << pattern << " / " << sv;
+      }
+
+      EXPECT_EQ(searcher.RFind(sv, pos), sv.rfind(pattern, pos))
+          << pattern << " / " << sv;
+      EXPECT_EQ(searcher.RFindScalar(sv, pos), sv.rfind(pattern, pos))
+          << pattern << " / " << sv;
+    }
+  }
+}
+
+#if ATB_SIMD_X86
+TEST(AtbStrSearcherTest, VectorizedKernels) {
+  std::mt19937 gen(24);
+  std::uniform_int_distribution<std::size_t> pattern_size(1, 32);
+  std::uniform_int_distribution<std::size_t> str_size(32, 300);
+
+  for (int i = 0; i < 300; ++i) {
+    const auto str = RandomString(gen, str_size(gen));
+    std::uniform_int_distribution<std::size_t> from_dist(0, str.size() - 32);
+    const auto from = from_dist(gen);
+    const auto pattern = (i % 2 == 0) ? str.substr(from, pattern_size(gen))
+                                      : RandomString(gen, pattern_size(gen));
+
+    const std::string_view sv = str;
+    const auto end = sv.size() - pattern.size() + 1;
+
+    if (simd::DetectedIsa() >= simd::Isa::kSse2) {
+      EXPECT_EQ(details::SearcherFindSse2(pattern, sv, 0), sv.find(pattern));
+      EXPECT_EQ(details::SearcherRFindSse2(pattern, sv, end),
+                sv.rfind(pattern));
+    }
+
+    if (simd::DetectedIsa() >= simd::Isa::kAvx2) {
+      EXPECT_EQ(details::SearcherFindAvx2(pattern, sv, 0), sv.find(pattern));
+      EXPECT_EQ(details::SearcherRFindAvx2(pattern, sv, end),
+                sv.rfind(pattern));
+    }
+  }
+}
+#endif
+
+}  // namespace
+}  // namespace atb
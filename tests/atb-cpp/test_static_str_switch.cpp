@@ -0,0 +1,147 @@
+#include <cstddef>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/static_str_switch.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+constexpr auto kVerbs = MakeStaticStrSwitch<int>({
+    {"GET", 0},
+    {"PUT", 1},
+    {"POST", 2},
+    {"DELETE", 3},
+    {"", 4},
+});
+
+TEST(AtbStaticStrSwitchTest, Constexpr) {
+  static_assert(kVerbs.Size() == 5);
+  static_assert(*kVerbs.Find("GET") == 0);
+  static_assert(*kVerbs.Find("PUT") == 1);
+  static_assert(*kVerbs.Find("POST") == 2);
+  static_assert(*kVerbs.Find("DELETE") == 3);
+  static_assert(*kVerbs.Find("") == 4);
+  static_assert(kVerbs.Find("PATCH") == nullptr);
+  static_assert(kVerbs.Find("GETS") == nullptr);
+  static_assert(kVerbs.Find("get") == nullptr);
+
+  static_assert(kVerbs.FindOr("POST", -1) == 2);
+  static_assert(kVerbs.FindOr("PATCH", -1) == -1);
+}
+
+TEST(AtbStaticStrSwitchTest, Runtime) {
+  const std::string put = "PUT";
+  EXPECT_NE(kVerbs.Find(put), nullptr);
+  EXPECT_EQ(kVerbs.FindOr(put, -1), 1);
+  EXPECT_EQ(kVerbs.FindOr(put + "S", -1), -1);
+
+  // Duplicated keys can't be hashed
+  using Switch = StaticStrSwitch<int, 3>;
+  const Switch::Case cases[3] = {{"a", 0}, {"b", 1}, {"a", 2}};
+  EXPECT_THROW(Switch{cases}, std::invalid_argument);
+}
+
+/// Build many switches of N random distinct keys, and look all keys up
+template <std::size_t N>
+void CheckRandomKeySets(std::mt19937& rng, std::size_t sets) {
+  using Switch = StaticStrSwitch<std::size_t, N>;
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<std::size_t> size(1, 8);
+
+  for (std::size_t set = 0; set < sets; ++set) {
+    std::set<std::string> unique;
+    while (unique.size() < N) {
+      std::string key(size(rng), 'a');
+      for (auto& c : key) c = static_cast<char>(letter(rng));
+      unique.insert(std::move(key));
+    }
+
+    const std::vector<std::string> keys(unique.begin(), unique.end());
+    typename Switch::Case cases[N];
+    for (std::size_t i = 0; i < N; ++i) cases[i] = {keys[i], i};
+
+    const Switch sw{cases};
+    for (std::size_t i = 0; i < N; ++i) {
+      ASSERT_EQ(sw.FindOr(keys[i], N), i) << "N=" << N << " key=" << keys[i];
+    }
+  }
+}
+
+TEST(AtbStaticStrSwitchTest, RandomKeySets) {
+  std::mt19937 rng{42};
+  CheckRandomKeySets<2>(rng, 5000);
+  CheckRandomKeySets<3>(rng, 5000);
+  CheckRandomKeySets<4>(rng, 5000);
+  CheckRandomKeySets<8>(rng, 2000);
+  CheckRandomKeySets<32>(rng, 500);
+  CheckRandomKeySets<100>(rng, 100);
+}
+
+TEST(AtbStaticStrSwitchTest, ManyCases) {
+  static constexpr auto kCommands = MakeStaticStrSwitch<int>({
+      {"abort", 0},     {"add", 1},      {"alias", 2},     {"append", 3},
+      {"attach", 4},    {"bind", 5},     {"break", 6},     {"cancel", 7},
+      {"cat", 8},       {"cd", 9},       {"chmod", 10},    {"chown", 11},
+      {"clear", 12},    {"close", 13},   {"commit", 14},   {"connect", 15},
+      {"copy", 16},     {"create", 17},  {"delete", 18},   {"detach", 19},
+      {"diff", 20},     {"disable", 21}, {"echo", 22},     {"edit", 23},
+      {"enable", 24},   {"exec", 25},    {"exit", 26},     {"export", 27},
+      {"fetch", 28},    {"find", 29},    {"flush", 30},    {"get", 31},
+      {"grep", 32},     {"help", 33},    {"history", 34},  {"import", 35},
+      {"info", 36},     {"kill", 37},    {"link", 38},     {"list", 39},
+      {"load", 40},     {"lock", 41},    {"log", 42},      {"merge", 43},
+      {"move", 44},     {"open", 45},    {"pause", 46},    {"ping", 47},
+      {"pull", 48},     {"push", 49},    {"put", 50},      {"quit", 51},
+      {"read", 52},     {"reload", 53},  {"remove", 54},   {"rename", 55},
+      {"reset", 56},    {"resume", 57},  {"save", 58},     {"set", 59},
+      {"show", 60},     {"start", 61},   {"status", 62},   {"stop", 63},
+  });
+
+  static_assert(kCommands.Size() == 64);
+  static_assert(kCommands.FindOr("abort", -1) == 0);
+  static_assert(kCommands.FindOr("stop", -1) == 63);
+  static_assert(kCommands.FindOr("stopped", -1) == -1);
+
+  const std::string_view keys[] = {
+      "abort",  "add",     "alias",   "append", "attach", "bind",    "break",
+      "cancel", "cat",     "cd",      "chmod",  "chown",  "clear",   "close",
+      "commit", "connect", "copy",    "create", "delete", "detach",  "diff",
+      "disable", "echo",   "edit",    "enable", "exec",   "exit",    "export",
+      "fetch",  "find",    "flush",   "get",    "grep",   "help",    "history",
+      "import", "info",    "kill",    "link",   "list",   "load",    "lock",
+      "log",    "merge",   "move",    "open",   "pause",  "ping",    "pull",
+      "push",   "put",     "quit",    "read",   "reload", "remove",  "rename",
+      "reset",  "resume",  "save",    "set",    "show",   "start",   "status",
+      "stop",
+  };
+
+  for (int i = 0; i < 64; ++i) {
+    const auto key = std::string{keys[i]};
+    EXPECT_EQ(kCommands.FindOr(key, -1), i) << key;
+    EXPECT_EQ(kCommands.FindOr(key + "_", -1), -1) << key;
+    EXPECT_EQ(kCommands.FindOr(key.substr(1), -1), -1) << key;
+  }
+}
+
+TEST(AtbStaticStrSwitchTest, Matcher) {
+  EXPECT_TRUE(::IsMatching(kVerbs, "GET"));
+  EXPECT_FALSE(::IsMatching(kVerbs, "PATCH"));
+
+  EXPECT_EQ(2, StrSwitch<int>("DELETE")
+                   .Case(StrStartsWith("P"), 1)
+                   .Case(kVerbs, 2)
+                   .Default(-1));
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,110 @@
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "atb-cpp/str_column.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+template <class T>
+auto ToCharsSize(T value) -> std::size_t {
+  return StrPiece{value}.Size();
+}
+
+TEST(AtbStrColumnTest, IntegerSize) {
+  for (std::int64_t value : {0l, 1l, 9l, 10l, 99l, 100l, -1l, -9l, -10l,
+                             123456789l, -123456789l, 1000000000000l}) {
+    EXPECT_EQ(details::StrIntegerSize(value), ToCharsSize(value)) << value;
+  }
+
+  for (std::uint64_t power = 1; power < (std::uint64_t{1} << 63);
+       power *= 10) {
+    EXPECT_EQ(details::StrIntegerSize(power), ToCharsSize(power)) << power;
+    EXPECT_EQ(details::StrIntegerSize(power - 1), ToCharsSize(power - 1))
+        << power;
+  }
+
+  EXPECT_EQ(details::StrIntegerSize(std::numeric_limits<std::uint64_t>::max()),
+            20u);
+  EXPECT_EQ(details::StrIntegerSize(std::numeric_limits<std::int64_t>::min()),
+            20u);
+  EXPECT_EQ(details::StrIntegerSize(std::numeric_limits<std::int32_t>::min()),
+            11u);
+  EXPECT_EQ(details::StrIntegerSize(std::numeric_limits<std::uint32_t>::max()),
+            10u);
+  EXPECT_EQ(details::StrIntegerSize(std::numeric_limits<std::int8_t>::min()),
+            4u);
+  EXPECT_EQ(details::StrIntegerSize(std::uint8_t{255}), 3u);
+}
+
+TEST(AtbStrColumnTest, StrCatColumns) {
+  const std::vector<std::string_view> names = {"foo", "", "bar"};
+  const std::vector<int> ids = {1, -42, 300};
+  const std::array<double, 3> ratios = {0.5, 1.0, -2.25};
+  const std::vector<std::string> tags = {"a", "bc", "def"};
+  const bool flags[] = {true, false, true};
+
+  const StrColumn csv =
+      StrCatColumns(names, ',', ids, ", ", ratios, ';', tags, '|', flags,
+                    std::string{"\n"});
+  EXPECT_EQ(csv.data,
+            "foo,1, 0.5;a|true\n"
+            ",-42, 1;bc|false\n"
+            "bar,300, -2.25;def|true\n");
+
+  ASSERT_EQ(csv.Size(), 3u);
+  EXPECT_FALSE(csv.Empty());
+  EXPECT_EQ(csv.offsets, (std::vector<std::size_t>{0, 18, 35, 59}));
+  EXPECT_EQ(csv[0], "foo,1, 0.5;a|true\n"sv);
+  EXPECT_EQ(csv[1], ",-42, 1;bc|false\n"sv);
+  EXPECT_EQ(csv[2], "bar,300, -2.25;def|true\n"sv);
+}
+
+TEST(AtbStrColumnTest, Empty) {
+  const StrColumn column = StrCatColumns(std::vector<int>{}, "-");
+  EXPECT_TRUE(column.Empty());
+  EXPECT_EQ(column.Size(), 0u);
+  EXPECT_EQ(column.data, "");
+  EXPECT_EQ(column.offsets, std::vector<std::size_t>{0});
+
+  EXPECT_TRUE(StrColumn{}.Empty());
+}
+
+TEST(AtbStrColumnTest, DifferentSizes) {
+  EXPECT_THROW(StrCatColumns(std::vector<int>{1, 2}, ',',
+                             std::vector<std::string_view>{"a"}),
+               std::invalid_argument);
+}
+
+TEST(AtbStrColumnTest, Parallel) {
+  constexpr std::size_t kRows = (kStrColumnsRowsPerThread * 4) + 123;
+
+  std::vector<std::uint64_t> ids(kRows);
+  std::vector<std::string> names(kRows);
+  for (std::size_t i = 0; i < kRows; ++i) {
+    ids[i] = i * 7919;
+    names[i] = std::string(i % 17, 'x');
+  }
+
+  const StrColumn expected = StrCatColumns(ids, '\t', names, '\n');
+  ASSERT_EQ(expected.Size(), kRows);
+  EXPECT_EQ(expected[kRows - 1], "130711014\txxxxxxxxxxxxxxxx\n"sv);
+
+  for (std::size_t threads : {1u, 2u, 3u, 4u, 8u, 64u}) {
+    const StrColumn column =
+        StrCatColumnsParallel(threads, ids, '\t', names, '\n');
+    EXPECT_EQ(column.data, expected.data) << threads;
+    EXPECT_EQ(column.offsets, expected.offsets) << threads;
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,103 @@
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/str_dispatch_table.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbStrDispatchTableTest, Empty) {
+  const StrDispatchTable<int> table;
+  EXPECT_EQ(table.Size(), 0);
+  EXPECT_EQ(table.Find("foo"), nullptr);
+  EXPECT_EQ(table.FindOr("", -1), -1);
+  EXPECT_FALSE(::IsMatching(table, "foo"));
+}
+
+TEST(AtbStrDispatchTableTest, SameAsStrSwitch) {
+  StrDispatchTable<int> table;
+  table.Case("foo", 1)
+      .Case("Coucou ", 2)
+      .Case(StrStartsWith("Cou "), 3)
+      .Case(StrContains("k"), 4)
+      .Case(AllOf(StrStartsWith("Co"), StrEndsWith("ou")), 5)
+      .Case("Coucou", 6);
+
+  EXPECT_EQ(table.Size(), 6);
+  EXPECT_EQ(table.GenericCount(), 3);
+
+  for (auto str : {"foo"sv, "Coucou "sv, "Cou cou"sv, "kiwi"sv, "Coucou"sv,
+                   "Chocolatine"sv, ""sv, "foo "sv}) {
+    EXPECT_EQ(table.FindOr(str, -1), StrSwitch<int>(str)
+                                         .Case("foo", 1)
+                                         .Case("Coucou ", 2)
+                                         .Case(StrStartsWith("Cou "), 3)
+                                         .Case(StrContains("k"), 4)
+                                         .Case(AllOf(StrStartsWith("Co"),
+                                                     StrEndsWith("ou")),
+                                               5)
+                                         .Case("Coucou", 6)
+                                         .Default(-1))
+        << str;
+  }
+
+  // Literal "Coucou" is shadowed by a generic matcher defined before
+  EXPECT_EQ(table.FindOr("Coucou", -1), 5);
+}
+
+TEST(AtbStrDispatchTableTest, FirstMatchWins) {
+  StrDispatchTable<std::string> table;
+  table.Case("foo", "first")
+      .Case("foo", "second")
+      .Case(StrStartsWith("b"), "starts")
+      .Case("bar", "literal");
+
+  EXPECT_EQ(table.FindOr("foo", ""), "first");
+  EXPECT_EQ(table.FindOr("bar", ""), "starts");
+  EXPECT_EQ(table.FindOr("baz", ""), "starts");
+  EXPECT_EQ(table.FindOr("toto", "none"), "none");
+}
+
+TEST(AtbStrDispatchTableTest, RuntimeKeys) {
+  // Keys coming from a config: temporaries are copied inside the table
+  std::vector<std::pair<std::string, int>> config;
+  for (int i = 0; i < 100; ++i) {
+    config.emplace_back("route/" + std::to_string(i), i);
+  }
+
+  StrDispatchTable<int> table;
+  for (const auto& [key, value] : config) table.Case(std::string{key}, value);
+  table.Case(StrStartsWith("route/"), -2);
+
+  EXPECT_EQ(table.Size(), 101);
+  EXPECT_EQ(table.GenericCount(), 1);
+
+  for (const auto& [key, value] : config) {
+    EXPECT_EQ(table.FindOr(key, -1), value) << key;
+  }
+  EXPECT_EQ(table.FindOr("route/100", -1), -2);
+  EXPECT_EQ(table.FindOr("route", -1), -1);
+}
+
+TEST(AtbStrDispatchTableTest, Matcher) {
+  StrDispatchTable<int> table;
+  table.Case("GET", 0).Case(StrStartsWith("P"), 1);
+
+  EXPECT_TRUE(::IsMatching(table, "GET"));
+  EXPECT_TRUE(::IsMatching(table, "POST"));
+  EXPECT_FALSE(::IsMatching(table, "DELETE"));
+
+  EXPECT_EQ(2, StrSwitch<int>("PUT")
+                   .Case("DELETE", 1)
+                   .Case(table, 2)
+                   .Default(-1));
+}
+
+}  // namespace
+}  // namespace atb
@@ -0,0 +1,92 @@
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "atb-cpp/str_expr.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+auto Endpoint(std::string_view host, int port) {
+  return StrLazyCat(host, ':', port);
+}
+
+auto Url(std::string_view host, int port, std::string_view path) {
+  return "http://" + Endpoint(host, port) + path;
+}
+
+TEST(AtbStrExprTest, Concatenation) {
+  const StrExpr<> empty;
+  EXPECT_EQ(empty.Size(), 0u);
+  EXPECT_EQ(empty.ToString(), "");
+
+  const std::string name = "world";
+  const auto expr = StrLazyCat("hello ") + name + '!' + " x" + 2 + ' ' + 1.5 +
+                    ' ' + true;
+  EXPECT_EQ(std::tuple_size_v<std::decay_t<decltype(expr.AsTuple())>>, 9u);
+  EXPECT_EQ(expr.Size(), 24u);
+  EXPECT_EQ(expr.ToString(), "hello world! x2 1.5 true");
+
+  const std::string str = "<" + expr + ">";
+  EXPECT_EQ(str, "<hello world! x2 1.5 true>");
+
+  EXPECT_EQ(std::string{Url("localhost", 8080, "/index.html")},
+            "http://localhost:8080/index.html");
+
+  // Concatenating expressions
+  const auto lhs = StrLazyCat("a", 1);
+  const auto rhs = StrLazyCat('b', 2u);
+  EXPECT_EQ((lhs + rhs).ToString(), "a1b2");
+  EXPECT_EQ((rhs + lhs + StrLazyCat("c")).ToString(), "b2a1c");
+}
+
+TEST(AtbStrExprTest, Ownership) {
+  // Lvalues strings are viewed, rvalues std::string are moved
+  std::string viewed = "viewed";
+  const auto expr = StrLazyCat(viewed) + std::string{"owned"};
+
+  using Tuple = std::decay_t<decltype(expr.AsTuple())>;
+  static_assert(std::is_same_v<std::tuple_element_t<0, Tuple>,
+                               std::string_view>);
+  static_assert(std::is_same_v<std::tuple_element_t<1, Tuple>, std::string>);
+
+  viewed[0] = 'V';
+  EXPECT_EQ(expr.ToString(), "Viewedowned");
+}
+
+TEST(AtbStrExprTest, StrPieceCopied) {
+  // Temporary StrPiece hold their formatted chars inline
+  const auto expr = StrLazyCat(StrPiece{42}) + StrPiece{-1.5} + StrPiece{'c'};
+
+  using Tuple = std::decay_t<decltype(expr.AsTuple())>;
+  static_assert(std::is_same_v<std::tuple_element_t<0, Tuple>, StrPiece>);
+  static_assert(std::is_same_v<std::tuple_element_t<1, Tuple>, StrPiece>);
+
+  EXPECT_EQ(expr.ToString(), "42-1.5c");
+}
+
+TEST(AtbStrExprTest, CopyToAndAppendTo) {
+  const auto expr = StrLazyCat("id=", 42);
+
+  char buffer[5] = {};
+  const auto end = expr.CopyTo(buffer, sizeof(buffer));
+  ASSERT_TRUE(end.has_value());
+  EXPECT_EQ(std::string_view(buffer, static_cast<std::size_t>(*end - buffer)),
+            "id=42"sv);
+
+  char small[4] = {};
+  EXPECT_FALSE(expr.CopyTo(small, sizeof(small)).has_value());
+  EXPECT_EQ(small[0], '\0');
+
+  std::string str = "[";
+  EXPECT_EQ(expr.AppendTo(str), 5u);
+  EXPECT_EQ((StrLazyCat(']')).AppendTo(str), 1u);
+  EXPECT_EQ(str, "[id=42]");
+}
+
+}  // namespace
+}  // namespace atb
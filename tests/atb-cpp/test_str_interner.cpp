@@ -0,0 +1,139 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "atb-cpp/str_interner.hpp"
+#include "atb-cpp/string.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+TEST(AtbStrInternerTest, Intern) {
+  StrInterner interner;
+  EXPECT_EQ(interner.Size(), 0);
+
+  const InternedStr invalid;
+  EXPECT_FALSE(invalid.IsValid());
+
+  const auto foo = interner.Intern("foo");
+  const auto bar = interner.Intern(std::string{"bar"});
+  const auto empty = interner.Intern("");
+
+  EXPECT_TRUE(foo.IsValid());
+  EXPECT_EQ(foo.Id(), 0);
+  EXPECT_EQ(bar.Id(), 1);
+  EXPECT_EQ(empty.Id(), 2);
+  EXPECT_EQ(foo.View(), "foo"sv);
+  EXPECT_EQ(bar.View(), "bar"sv);
+  EXPECT_EQ(empty.View(), ""sv);
+  EXPECT_EQ(interner.Size(), 3);
+
+  // Same strings give the same handles
+  const std::string other_foo = "foo";
+  EXPECT_EQ(interner.Intern(other_foo), foo);
+  EXPECT_EQ(interner.Intern(other_foo).View().data(), foo.View().data());
+  EXPECT_NE(foo, bar);
+  EXPECT_LT(foo, bar);
+  EXPECT_EQ(interner.Size(), 3);
+}
+
+TEST(AtbStrInternerTest, FindAndGet) {
+  StrInterner interner;
+  EXPECT_FALSE(interner.Find("foo").has_value());
+
+  const auto foo = interner.Intern("foo");
+  EXPECT_EQ(interner.Find("foo"), foo);
+  EXPECT_FALSE(interner.Find("fo").has_value());
+  EXPECT_EQ(interner.Size(), 1);
+
+  EXPECT_EQ(interner.Get(foo.Id()), foo);
+  EXPECT_EQ(interner.Get(foo.Id()).View(), "foo"sv);
+}
+
+TEST(AtbStrInternerTest, ManyStrings) {
+  // Small blocks and many strings: grow tables, arenas and ids directory
+  StrInterner interner(64);
+
+  std::vector<InternedStr> handles;
+  for (std::size_t i = 0; i < 5000; ++i) {
+    handles.push_back(interner.Intern("metric." + std::to_string(i)));
+    EXPECT_EQ(handles.back().Id(), i);
+  }
+
+  EXPECT_EQ(interner.Size(), 5000);
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    const auto name = "metric." + std::to_string(i);
+    EXPECT_EQ(handles[i].View(), name);
+    EXPECT_EQ(interner.Find(name), handles[i]);
+    EXPECT_EQ(interner.Get(static_cast<StrId>(i)), handles[i]);
+  }
+
+  std::unordered_set<InternedStr> set(handles.begin(), handles.end());
+  EXPECT_EQ(set.size(), handles.size());
+}
+
+TEST(AtbStrInternerTest, Matchers) {
+  StrInterner interner;
+  const auto cpu = interner.Intern("cpu.usage");
+  const auto mem = interner.Intern("mem.usage");
+
+  EXPECT_TRUE(::IsMatching(cpu, interner.Intern("cpu.usage")));
+  EXPECT_FALSE(::IsMatching(cpu, mem));
+  EXPECT_TRUE(::IsMatching(Eq(cpu), interner.Intern("cpu.usage")));
+  EXPECT_TRUE(::IsMatching(Ne(cpu), mem));
+
+  // Matching plain strings
+  const std::string str = "cpu.usage";
+  EXPECT_TRUE(::IsMatching(cpu, cpu.View()));
+  EXPECT_TRUE(::IsMatching(cpu, str));
+  EXPECT_FALSE(::IsMatching(cpu, "cpu"sv));
+
+  for (const auto& [name, expected] :
+       {std::pair{cpu.View(), 0}, std::pair{mem.View(), 1},
+        std::pair{"cpu.usage"sv, 0}, std::pair{"disk"sv, -1}}) {
+    EXPECT_EQ(expected, StrSwitch<int>(name)
+                            .Case(cpu, 0)
+                            .Case(mem, 1)
+                            .Default(-1));
+  }
+}
+
+TEST(AtbStrInternerTest, Concurrent) {
+  StrInterner interner(256);
+  constexpr std::size_t kThreads = 8;
+  constexpr std::size_t kStrings = 2000;
+
+  std::vector<std::vector<InternedStr>> handles(kThreads);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      // All threads intern the same strings, in different orders
+      for (std::size_t i = 0; i < kStrings; ++i) {
+        const std::size_t n = (i * (2 * t + 1)) % kStrings;
+        handles[t].push_back(interner.Intern("tag." + std::to_string(n)));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(interner.Size(), kStrings);
+
+  for (std::size_t t = 0; t < kThreads; ++t) {
+    for (std::size_t i = 0; i < kStrings; ++i) {
+      const std::size_t n = (i * (2 * t + 1)) % kStrings;
+      const auto& handle = handles[t][i];
+      EXPECT_EQ(handle.View(), "tag." + std::to_string(n));
+      EXPECT_EQ(handle, interner.Find(handle.View()));
+      EXPECT_EQ(handle, interner.Get(handle.Id()));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace atb
@@ -3,6 +3,9 @@
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <random>
+#include <string>
+#include <vector>
 
 #include "atb-cpp/string.hpp"
 #include "gtest/gtest.h"
@@ -156,6 +159,73 @@ TEST(AtbStringTest, StrCat) {
             "foo Chocolatine Coucou"sv);
 }
 
+TEST(AtbStringTest, StrReplaceAll) {
+  // Nothing to replace
+  EXPECT_EQ(StrReplaceAll("", {{"foo", "bar"}}).value(), "");
+  EXPECT_EQ(StrReplaceAll(coucou, {}).value(), coucou);
+  EXPECT_EQ(StrReplaceAll(coucou, {{"", "bar"}}).value(), coucou);
+  EXPECT_EQ(StrReplaceAll(coucou, {{"foo", "bar"}}).value(), coucou);
+
+  // Single pattern
+  EXPECT_EQ(StrReplaceAll("foo bar foo", {{"foo", "toto"}}).value(),
+            "toto bar toto");
+  EXPECT_EQ(StrReplaceAll("foo bar foo", {{"foo", ""}}).value(), " bar ");
+  EXPECT_EQ(StrReplaceAll("aaaaa", {{"aa", "b"}}).value(), "bba");
+
+  // Replacements are never re-scanned
+  EXPECT_EQ(StrReplaceAll("ab", {{"a", "aa"}}).value(), "aab");
+
+  // Several patterns, in a single scan
+  EXPECT_EQ(StrReplaceAll("foo bar", {{"foo", "bar"}, {"bar", "foo"}}).value(),
+            "bar foo");
+  EXPECT_EQ(StrReplaceAll("a < b & c",
+                          {{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}})
+                .value(),
+            "a &lt; b &amp; c");
+
+  // Longest pattern wins, then the first declared
+  EXPECT_EQ(StrReplaceAll("abcd", {{"ab", "1"}, {"abc", "2"}}).value(), "2d");
+  EXPECT_EQ(StrReplaceAll("abcd", {{"ab", "1"}, {"ab", "2"}}).value(), "1cd");
+  EXPECT_EQ(StrReplaceAll("abab", {{"a", "1"}, {"b", "2"}, {"a", "3"}}).value(),
+            "1212");
+
+  // Reusable replacer
+  const StrReplacer replacer({{"\n", "\\n"}, {"\t", "\\t"}});
+  EXPECT_TRUE(replacer.Grows());
+  EXPECT_EQ(replacer.Count("a\tb\nc\n"), 3);
+  EXPECT_EQ(replacer.ReplacedSize("a\tb\nc\n"), 9);
+  EXPECT_EQ(replacer.Replace("a\tb\nc\n").value(), "a\\tb\\nc\\n");
+}
+
+TEST(AtbStringTest, StrReplaceAllInPlace) {
+  // Shrinking (no allocation)
+  std::string str = "foo bar foo baz";
+  EXPECT_EQ(StrReplaceAllInPlace(str, {{"foo", "f"}, {"baz", ""}}), 3);
+  EXPECT_EQ(str, "f bar f ");
+
+  str = "aaaa";
+  EXPECT_EQ(StrReplaceAllInPlace(str, {{"a", "b"}}), 4);
+  EXPECT_EQ(str, "bbbb");
+
+  str = coucou;
+  EXPECT_EQ(StrReplaceAllInPlace(str, {{"toto", ""}}), 0);
+  EXPECT_EQ(str, coucou);
+
+  // Growing
+  str = "a-b-c";
+  EXPECT_EQ(StrReplaceAllInPlace(str, {{"-", " - "}}), 2);
+  EXPECT_EQ(str, "a - b - c");
+
+  // Same as the copy
+  const StrReplacer replacer({{"ou", "u"}, {"Co", ""}, {"c", "C"}});
+  EXPECT_FALSE(replacer.Grows());
+  for (auto input : {coucou, chocolatine, foo, "CoucouCoucou"sv}) {
+    str = input;
+    EXPECT_EQ(replacer.ReplaceInPlace(str), replacer.Count(input));
+    EXPECT_EQ(str, replacer.Replace(input).value());
+  }
+}
+
 TEST(AtbStringTest, StrStartsWith) {
   // Empty inputs
   EXPECT_TRUE(::IsMatching(StrStartsWith(""), ""));
@@ -340,6 +410,231 @@ TEST(AtbStringTest, StrContainsOneOfR) {
   EXPECT_EQ(where, 11);
 }
 
+TEST(AtbStringTest, StrContainsAnyOf) {
+  // Empty inputs
+  EXPECT_FALSE(::IsMatching(StrContainsAnyOf({}), ""));
+  EXPECT_FALSE(::IsMatching(StrContainsAnyOf({}), coucou));
+  EXPECT_TRUE(::IsMatching(StrContainsAnyOf({""}), coucou));
+  EXPECT_FALSE(::IsMatching(StrContainsAnyOf({coucou}), ""));
+
+  // Nominal
+  const auto contains_any = StrContainsAnyOf({foo, "lat", "ouc"});
+  EXPECT_TRUE(::IsMatching(contains_any, coucou));
+  EXPECT_TRUE(::IsMatching(contains_any, chocolatine));
+  EXPECT_TRUE(::IsMatching(contains_any, " foo bar"));
+  EXPECT_FALSE(::IsMatching(contains_any, "fobar"));
+
+  // Runtime list of patterns
+  const std::vector<std::string> patterns = {"bar", "baz"};
+  EXPECT_TRUE(::IsMatching(StrContainsAnyOf(patterns), " foo bar"));
+  EXPECT_FALSE(::IsMatching(StrContainsAnyOf(patterns), " foo ba"));
+
+  // Test d_match
+  AhoCorasick::Match match{42, 42, 42};
+
+  EXPECT_FALSE(
+      ::IsMatching(StrContainsAnyOf({"baz", "zz"}, &match), " foo bar foo"));
+  EXPECT_EQ(match, (AhoCorasick::Match{42, 42, 42}));
+
+  EXPECT_TRUE(
+      ::IsMatching(StrContainsAnyOf({"bar", "foo"}, &match), " foo bar foo"));
+  EXPECT_EQ(match, (AhoCorasick::Match{1, 1, 3}));
+
+  EXPECT_TRUE(::IsMatching(StrContainsAnyOf({"o", "bar", "o b"}, &match),
+                           " foo bar foo"));
+  EXPECT_EQ(match, (AhoCorasick::Match{0, 2, 1}));
+
+  EXPECT_TRUE(::IsMatching(StrContainsAnyOf(patterns, &match), " foo bar foo"));
+  EXPECT_EQ(match, (AhoCorasick::Match{0, 5, 3}));
+
+  // Composition
+  EXPECT_EQ(2, StrSwitch<int>(chocolatine)
+                   .Case(StrContainsAnyOf({"foo", "bar"}), 1)
+                   .Case(StrContainsAnyOf({"foo", "lat"}), 2)
+                   .Default(-1));
+
+  AnyMatcher<std::string_view> any_matcher;
+  any_matcher = StrContainsAnyOf({"foo", "bar"});
+  EXPECT_TRUE(::IsMatching(any_matcher, "a bar"));
+  EXPECT_FALSE(::IsMatching(any_matcher, coucou));
+}
+
+TEST(AtbStringTest, StrIEquals) {
+  EXPECT_TRUE(::IsMatching(StrIEquals(""), ""));
+  EXPECT_FALSE(::IsMatching(StrIEquals(""), coucou));
+  EXPECT_FALSE(::IsMatching(StrIEquals(coucou), ""));
+
+  EXPECT_TRUE(::IsMatching(StrIEquals("content-length"), "Content-Length"));
+  EXPECT_TRUE(::IsMatching(StrIEquals("CONTENT-LENGTH"), "content-length"));
+  EXPECT_FALSE(::IsMatching(StrIEquals("content-length"), "content-type"));
+  EXPECT_FALSE(::IsMatching(StrIEquals("content"), "content-length"));
+
+  // Only ASCII letters are folded
+  EXPECT_FALSE(::IsMatching(StrIEquals("@[`{"), "`{@["));
+}
+
+TEST(AtbStringTest, StrIStartsWith) {
+  EXPECT_TRUE(::IsMatching(StrIStartsWith(""), ""));
+  EXPECT_TRUE(::IsMatching(StrIStartsWith(""), coucou));
+  EXPECT_FALSE(::IsMatching(StrIStartsWith(coucou), ""));
+
+  constexpr auto starts_with_foo = StrIStartsWith("fOo");
+  EXPECT_TRUE(::IsMatching(starts_with_foo, "foobar"));
+  EXPECT_TRUE(::IsMatching(starts_with_foo, "FOO bar"));
+  EXPECT_FALSE(::IsMatching(starts_with_foo, "fobar"));
+  EXPECT_FALSE(::IsMatching(starts_with_foo, " foo"));
+}
+
+TEST(AtbStringTest, StrIEndsWith) {
+  EXPECT_TRUE(::IsMatching(StrIEndsWith(""), ""));
+  EXPECT_TRUE(::IsMatching(StrIEndsWith(""), coucou));
+  EXPECT_FALSE(::IsMatching(StrIEndsWith(coucou), ""));
+
+  constexpr auto ends_with_foo = StrIEndsWith("fOo");
+  EXPECT_FALSE(::IsMatching(ends_with_foo, "foobar"));
+  EXPECT_TRUE(::IsMatching(ends_with_foo, " FOO"));
+  EXPECT_TRUE(::IsMatching(ends_with_foo, "barfoo"));
+  EXPECT_FALSE(::IsMatching(ends_with_foo, "fo"));
+}
+
+TEST(AtbStringTest, StrIContains) {
+  EXPECT_TRUE(::IsMatching(StrIContains(""), ""));
+  EXPECT_FALSE(::IsMatching(StrIContains(coucou), ""));
+  EXPECT_TRUE(::IsMatching(StrIContains("COU"), coucou));
+  EXPECT_FALSE(::IsMatching(StrIContains("COUX"), coucou));
+
+  auto where = std::numeric_limits<std::size_t>::max();
+
+  EXPECT_FALSE(::IsMatching(StrIContains("baz", &where), " foo BAR foo"));
+  EXPECT_EQ(where, std::numeric_limits<std::size_t>::max());
+
+  EXPECT_TRUE(::IsMatching(StrIContains("Foo", &where), " foo BAR foo"));
+  EXPECT_EQ(where, 1);
+
+  EXPECT_TRUE(::IsMatching(StrIContainsR("Foo", &where), " foo BAR foo"));
+  EXPECT_EQ(where, 9);
+
+  EXPECT_TRUE(::IsMatching(StrIContainsR("bar", &where), " foo BAR foo"));
+  EXPECT_EQ(where, 5);
+}
+
+TEST(AtbStringTest, StrIContainsOneOf) {
+  EXPECT_FALSE(::IsMatching(StrIContainsOneOf(""), coucou));
+  EXPECT_FALSE(::IsMatching(StrIContainsOneOf(coucou), ""));
+
+  auto where = std::numeric_limits<std::size_t>::max();
+
+  EXPECT_FALSE(::IsMatching(StrIContainsOneOf("ZXY", &where), " foo bar foo"));
+  EXPECT_EQ(where, std::numeric_limits<std::size_t>::max());
+
+  EXPECT_TRUE(::IsMatching(StrIContainsOneOf("AKC", &where), " foo bar foo"));
+  EXPECT_EQ(where, 6);
+
+  EXPECT_TRUE(::IsMatching(StrIContainsOneOfR("hkO", &where), " foo bar foo"));
+  EXPECT_EQ(where, 11);
+
+  EXPECT_TRUE(::IsMatching(StrIContainsOneOfR("f", &where), " foo bar Foo"));
+  EXPECT_EQ(where, 9);
+}
+
+/// Reference glob matching (DP over pattern/str), without classes nor escapes
+auto GlobReference(std::string_view pattern, std::string_view str) -> bool {
+  std::vector<bool> row(str.size() + 1, false);
+  row[0] = true;
+  for (char p : pattern) {
+    std::vector<bool> next(str.size() + 1, false);
+    if (p == '*') {
+      bool any = false;
+      for (std::size_t j = 0; j <= str.size(); ++j) {
+        any = any || row[j];
+        next[j] = any;
+      }
+    } else {
+      for (std::size_t j = 1; j <= str.size(); ++j) {
+        next[j] = row[j - 1] && ((p == '?') || (p == str[j - 1]));
+      }
+    }
+    row = std::move(next);
+  }
+  return row[str.size()];
+}
+
+TEST(AtbStringTest, StrGlob) {
+  EXPECT_TRUE(::IsMatching(StrGlob(""), ""));
+  EXPECT_FALSE(::IsMatching(StrGlob(""), coucou));
+  EXPECT_TRUE(::IsMatching(StrGlob("*"), ""));
+  EXPECT_TRUE(::IsMatching(StrGlob("*"), coucou));
+  EXPECT_TRUE(::IsMatching(StrGlob("**"), coucou));
+  EXPECT_TRUE(::IsMatching(StrGlob(coucou), coucou));
+  EXPECT_FALSE(::IsMatching(StrGlob(coucou), "Coucou!"));
+
+  const auto api = StrGlob("api/*/v?/items");
+  EXPECT_TRUE(::IsMatching(api, "api/users/v2/items"));
+  EXPECT_TRUE(::IsMatching(api, "api//v2/items"));
+  EXPECT_TRUE(::IsMatching(api, "api/a/v1/b/v2/items"));
+  EXPECT_FALSE(::IsMatching(api, "api/users/v12/items"));
+  EXPECT_FALSE(::IsMatching(api, "api/users/v2/items/"));
+  EXPECT_FALSE(::IsMatching(api, "/api/users/v2/items"));
+
+  // Pieces in between the stars, located without backtracking
+  const auto pieces = StrGlob("*ab?d*ab*x");
+  EXPECT_TRUE(::IsMatching(pieces, "abcdabx"));
+  EXPECT_TRUE(::IsMatching(pieces, "aabab_dabababx"));
+  EXPECT_FALSE(::IsMatching(pieces, "abcdax"));
+  EXPECT_FALSE(::IsMatching(pieces, "abcdabx_"));
+  EXPECT_TRUE(::IsMatching(StrGlob("a*a"), "a1a"));
+  EXPECT_FALSE(::IsMatching(StrGlob("a*a"), "a"));  // Head/tail can't overlap
+  EXPECT_TRUE(::IsMatching(StrGlob("*??*"), "ab"));
+  EXPECT_FALSE(::IsMatching(StrGlob("*??*"), "a"));
+
+  // Classes
+  const auto sources = StrGlob("*_v[0-9].[ch]pp");
+  EXPECT_TRUE(::IsMatching(sources, "parser_v2.hpp"));
+  EXPECT_TRUE(::IsMatching(sources, "parser_v2.cpp"));
+  EXPECT_FALSE(::IsMatching(sources, "parser_v2.ipp"));
+  EXPECT_FALSE(::IsMatching(sources, "parser_vx.hpp"));
+  EXPECT_TRUE(::IsMatching(StrGlob("[!a-c]"), "d"));
+  EXPECT_FALSE(::IsMatching(StrGlob("[^a-c]"), "b"));
+  EXPECT_TRUE(::IsMatching(StrGlob("[]]"), "]"));
+  EXPECT_TRUE(::IsMatching(StrGlob("[!]]"), "a"));
+  EXPECT_FALSE(::IsMatching(StrGlob("[!]]"), "]"));
+  EXPECT_TRUE(::IsMatching(StrGlob("a[b"), "a[b"));  // Not a class
+
+  // Escapes
+  EXPECT_TRUE(::IsMatching(StrGlob("a\\*"), "a*"));
+  EXPECT_FALSE(::IsMatching(StrGlob("a\\*"), "ab"));
+  EXPECT_TRUE(::IsMatching(StrGlob("\\[a]"), "[a]"));
+  EXPECT_TRUE(::IsMatching(StrGlob("a\\"), "a\\"));
+
+  // Composition
+  EXPECT_EQ(2, StrSwitch<int>("main.cpp")
+                   .Case(StrGlob("*.hpp"), 1)
+                   .Case(StrGlob("*.cpp"), 2)
+                   .Default(-1));
+
+  AnyMatcher<std::string_view> any_matcher;
+  any_matcher = StrGlob("*.?pp");
+  EXPECT_TRUE(::IsMatching(any_matcher, "main.cpp"));
+  EXPECT_FALSE(::IsMatching(any_matcher, "main.c"));
+}
+
+TEST(AtbStringTest, StrGlobSameAsReference) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> size(0, 12);
+  std::uniform_int_distribution<int> pick(0, 5);
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string pattern;
+    for (auto n = size(gen); n > 0; --n) pattern += "ab*?ab"[pick(gen)];
+    std::string str;
+    for (auto n = size(gen) * 2; n > 0; --n) str += "ab"[pick(gen) % 2];
+
+    EXPECT_EQ(::IsMatching(StrGlob(pattern), str),
+              GlobReference(pattern, str))
+        << pattern << " ~ " << str;
+  }
+}
+
 TEST(AtbStringTest, StrSwitch) {
   EXPECT_EQ(2, StrSwitch<int>("Coucou")
                    .Case("foo", 1)
@@ -0,0 +1,167 @@
+#if defined(__linux__)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "atb-cpp/string.hpp"
+#include "atb-cpp/tail_reader.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::chrono_literals;
+
+namespace atb {
+namespace {
+
+/// Fixture running each test with both backends
+class AtbTailReaderTest : public ::testing::TestWithParam<TailBackend> {
+ protected:
+  void SetUp() override {
+    for (const char* name : {"atb_tail_0.log", "atb_tail_1.log"}) {
+      m_paths.push_back(::testing::TempDir() + name);
+      std::ofstream{m_paths.back(), std::ios::trunc};
+    }
+  }
+
+  void TearDown() override {
+    for (const auto& path : m_paths) std::remove(path.c_str());
+  }
+
+  /// Append \a str to the file \a i
+  void Append(std::size_t i, std::string_view str) {
+    std::ofstream file(m_paths[i], std::ios::app | std::ios::binary);
+    file << str;
+  }
+
+  /// Poll \a reader until \a count lines matched (or too many tries)
+  static auto PollFor(StrTailReader& reader, std::size_t count)
+      -> std::size_t {
+    std::size_t matched = 0;
+    for (int i = 0; (i < 50) && (matched < count); ++i) {
+      matched += reader.Poll(20ms);
+    }
+    return matched;
+  }
+
+  std::vector<std::string> m_paths;
+};
+
+TEST_P(AtbTailReaderTest, TailsNewLines) {
+  Append(0, "already there error\n");
+
+  StrTailReader reader(GetParam());
+  std::vector<std::pair<std::size_t, std::string>> lines;
+  const auto handler = [&](std::size_t id, std::string_view line) {
+    lines.emplace_back(id, line);
+  };
+
+  EXPECT_EQ(reader.Watch(m_paths[0], StrContains("error"), handler), 0);
+  EXPECT_EQ(reader.Watch(m_paths[1], StrStartsWith("W"), handler), 1);
+  EXPECT_EQ(reader.FilesCount(), 2);
+
+  EXPECT_EQ(reader.Poll(10ms), 0);
+  EXPECT_TRUE(lines.empty());
+
+  Append(0, "foo\nan error\nbar");
+  Append(1, "Warning\nInfo\n");
+  EXPECT_EQ(PollFor(reader, 2), 2);
+  EXPECT_EQ(lines.size(), 2);
+
+  // Partial line completed later
+  Append(0, " error\n");
+  EXPECT_EQ(PollFor(reader, 1), 1);
+
+  std::sort(lines.begin(), lines.end());
+  EXPECT_EQ(lines, (std::vector<std::pair<std::size_t, std::string>>{
+                       {0, "an error"},
+                       {0, "bar error"},
+                       {1, "Warning"},
+                   }));
+}
+
+TEST_P(AtbTailReaderTest, FromStart) {
+  Append(0, "error 1\nok\nerror 2\n");
+
+  StrTailReader reader(GetParam());
+  std::vector<std::string> lines;
+  reader.Watch(
+      m_paths[0], StrContains("error"),
+      [&](std::size_t, std::string_view line) { lines.emplace_back(line); },
+      true);
+
+  EXPECT_EQ(PollFor(reader, 2), 2);
+  EXPECT_EQ(lines, (std::vector<std::string>{"error 1", "error 2"}));
+}
+
+TEST_P(AtbTailReaderTest, LinesLongerThanTheBuffer) {
+  StrTailReader reader(GetParam(), 16);
+  std::vector<std::string> lines;
+  reader.Watch(m_paths[0], [](std::string_view) { return true; },
+               [&](std::size_t, std::string_view line) {
+                 lines.emplace_back(line);
+               });
+
+  const std::string big(100, 'x');
+  Append(0, "a\n" + big + "\nb\n");
+  EXPECT_EQ(PollFor(reader, 3), 3);
+  EXPECT_EQ(lines, (std::vector<std::string>{"a", big, "b"}));
+}
+
+TEST_P(AtbTailReaderTest, Truncated) {
+  Append(0, "some old content\n");
+
+  StrTailReader reader(GetParam());
+  std::vector<std::string> lines;
+  reader.Watch(m_paths[0], [](std::string_view) { return true; },
+               [&](std::size_t, std::string_view line) {
+                 lines.emplace_back(line);
+               });
+  EXPECT_EQ(reader.Poll(10ms), 0);
+
+  std::ofstream{m_paths[0], std::ios::trunc} << "new\n";
+  EXPECT_EQ(PollFor(reader, 1), 1);
+  EXPECT_EQ(lines, std::vector<std::string>{"new"});
+}
+
+TEST_P(AtbTailReaderTest, FileKeepsGrowing) {
+  // Each line matched appends another one: Poll() must return anyway
+  StrTailReader reader(GetParam());
+  std::size_t lines = 0;
+  reader.Watch(m_paths[0], [](std::string_view) { return true; },
+               [&](std::size_t, std::string_view) {
+                 if (++lines < 10000) Append(0, "more\n");
+               });
+
+  Append(0, "first\n");
+  const std::size_t matched = PollFor(reader, 1);
+  EXPECT_GE(matched, 1);
+  EXPECT_LT(matched, 100);
+}
+
+TEST_P(AtbTailReaderTest, Errors) {
+  StrTailReader reader(GetParam());
+  EXPECT_THROW(reader.Watch("/this/file/does/not/exist", StrContains("a"),
+                            [](std::size_t, std::string_view) {}),
+               std::system_error);
+  EXPECT_EQ(reader.FilesCount(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AtbTailReaderTest,
+                         ::testing::Values(TailBackend::kIoUring,
+                                           TailBackend::kEpoll));
+
+TEST(AtbTailReaderBackendTest, Fallback) {
+  EXPECT_EQ(StrTailReader(TailBackend::kEpoll).Backend(), TailBackend::kEpoll);
+}
+
+}  // namespace
+}  // namespace atb
+
+#endif  // defined(__linux__)
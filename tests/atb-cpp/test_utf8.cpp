@@ -0,0 +1,176 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "atb-cpp/simd.hpp"
+#include "atb-cpp/utf8.hpp"
+#include "gtest/gtest.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace atb {
+namespace {
+
+/// Random valid UTF-8 string of \a count code points (mostly ASCII)
+auto RandomUtf8(std::mt19937& gen, std::size_t count) -> std::string {
+  std::uniform_int_distribution<int> kind(0, 7);
+  std::uniform_int_distribution<char32_t> ascii(0x00, 0x7F);
+  std::uniform_int_distribution<char32_t> two(0x80, 0x7FF);
+  std::uniform_int_distribution<char32_t> three(0x800, 0xFFFF);
+  std::uniform_int_distribution<char32_t> four(0x10000, 0x10FFFF);
+
+  std::string str;
+  while (count-- > 0) {
+    char32_t c = 0;
+    switch (kind(gen)) {
+      case 0:
+        c = two(gen);
+        break;
+      case 1:
+        do {
+          c = three(gen);
+        } while ((c >= 0xD800) && (c <= 0xDFFF));
+        break;
+      case 2:
+        c = four(gen);
+        break;
+      default:
+        c = ascii(gen);
+        break;
+    }
+
+    if (c < 0x80) {
+      str += static_cast<char>(c);
+    } else if (c < 0x800) {
+      str += static_cast<char>(0xC0 | (c >> 6));
+      str += static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      str += static_cast<char>(0xE0 | (c >> 12));
+      str += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      str += static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+      str += static_cast<char>(0xF0 | (c >> 18));
+      str += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+      str += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+      str += static_cast<char>(0x80 | (c & 0x3F));
+    }
+  }
+  return str;
+}
+
+/// Check all implementations available agree with \a expected
+auto ExpectIsValid(std::string_view str, bool expected) -> void {
+  EXPECT_EQ(Utf8IsValidScalar(str), expected) << str.size();
+  EXPECT_EQ(Utf8IsValid(str), expected) << str.size();
+
+#if ATB_SIMD_X86
+  if (simd::DetectedIsa() >= simd::Isa::kSsse3) {
+    EXPECT_EQ(details::Utf8IsValidSsse3(str), expected) << str.size();
+  }
+  if (simd::DetectedIsa() >= simd::Isa::kAvx2) {
+    EXPECT_EQ(details::Utf8IsValidAvx2(str), expected) << str.size();
+  }
+#endif
+}
+
+TEST(AtbUtf8Test, Constexpr) {
+  static_assert(Utf8IsValidScalar(""sv));
+  static_assert(Utf8IsValidScalar("h\xC3\xA9llo"sv));
+  static_assert(!Utf8IsValidScalar("h\xC3"sv));
+  static_assert(Utf8CountScalar("h\xC3\xA9llo"sv) == 5);
+}
+
+TEST(AtbUtf8Test, IsValid) {
+  for (auto valid : {
+           ""sv,
+           "foo"sv,
+           "\x00"sv,
+           "\x7F"sv,
+           "\xC2\x80"sv,                                  // U+0080
+           "\xDF\xBF"sv,                                  // U+07FF
+           "\xE0\xA0\x80"sv,                              // U+0800
+           "\xED\x9F\xBF"sv,                              // U+D7FF
+           "\xEE\x80\x80"sv,                              // U+E000
+           "\xEF\xBF\xBF"sv,                              // U+FFFF
+           "\xF0\x90\x80\x80"sv,                          // U+10000
+           "\xF4\x8F\xBF\xBF"sv,                          // U+10FFFF
+           "Gr\xC3\xBC\xC3\x9F Gott \xE2\x82\xAC \xF0\x9F\x98\x80"sv,
+       }) {
+    ExpectIsValid(valid, true);
+  }
+
+  for (auto invalid : {
+           "\x80"sv,                  // Lone continuation
+           "\xBF"sv,                  //
+           "\xC0\x80"sv,              // Overlong
+           "\xC1\xBF"sv,              //
+           "\xE0\x9F\xBF"sv,          //
+           "\xF0\x8F\xBF\xBF"sv,      //
+           "\xED\xA0\x80"sv,          // Surrogates
+           "\xED\xBF\xBF"sv,          //
+           "\xF4\x90\x80\x80"sv,      // > U+10FFFF
+           "\xF5\x80\x80\x80"sv,      //
+           "\xFF"sv,                  //
+           "\xC2"sv,                  // Truncated
+           "\xE2\x82"sv,              //
+           "\xF0\x9F\x98"sv,          //
+           "\xC2\x41"sv,              // Not a continuation
+           "\xE2\x41\x82"sv,          //
+           "\xF0\x9F\x41\x80"sv,      //
+           "\xC2\x80\x80"sv,          // Too many continuations
+           "\xF0\x9F\x98\x80\x80"sv,  //
+       }) {
+    ExpectIsValid(invalid, false);
+
+    // Same errors, in the middle/at the end of long strings
+    for (std::size_t prefix :
+         {0u, 1u, 13u, 15u, 29u, 31u, 32u, 33u, 64u, 100u}) {
+      const std::string padding(prefix, 'a');
+      ExpectIsValid(padding + std::string{invalid}, false);
+      ExpectIsValid(padding + std::string{invalid} + padding, false);
+    }
+  }
+}
+
+TEST(AtbUtf8Test, SameAsScalar) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> count(0, 300);
+
+  for (int i = 0; i < 500; ++i) {
+    auto str = RandomUtf8(gen, count(gen));
+    ExpectIsValid(str, true);
+    EXPECT_EQ(Utf8Count(str), Utf8CountScalar(str));
+
+    if (!str.empty()) {
+      // Random corruption (may still be valid)
+      std::uniform_int_distribution<std::size_t> where(0, str.size() - 1);
+      std::uniform_int_distribution<int> byte(0x80, 0xFF);
+      str[where(gen)] = static_cast<char>(byte(gen));
+      ExpectIsValid(str, Utf8IsValidScalar(str));
+      EXPECT_EQ(Utf8Count(str), Utf8CountScalar(str));
+    }
+  }
+}
+
+TEST(AtbUtf8Test, Count) {
+  EXPECT_EQ(Utf8Count(""), 0);
+  EXPECT_EQ(Utf8Count("foo"), 3);
+  EXPECT_EQ(Utf8Count("Gr\xC3\xBC\xC3\x9F Gott \xE2\x82\xAC"), 11);
+
+  // More than 255 blocks (per byte counters overflow)
+  std::string big;
+  for (int i = 0; i < 5000; ++i) big += "\xE2\x82\xAC-";
+  EXPECT_EQ(Utf8Count(big), 10000);
+  EXPECT_EQ(Utf8CountScalar(big), 10000);
+}
+
+TEST(AtbUtf8Test, Length) {
+  EXPECT_EQ(Utf8Length("h\xC3\xA9llo"), 5);
+  EXPECT_EQ(Utf8Length(""), 0);
+  EXPECT_FALSE(Utf8Length("h\xC3"));
+  EXPECT_FALSE(Utf8Length("\xED\xA0\x80"));
+}
+
+}  // namespace
+}  // namespace atb